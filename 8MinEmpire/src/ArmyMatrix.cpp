@@ -0,0 +1,358 @@
+#include "ArmyMatrix.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Number of regions handled per pass of the owner kernel. The row stride is a multiple of this.
+const int REGION_BLOCK = 16;
+
+/**
+ * Hashes one count of the store (the splitmix64 finalizer over its position and value). The hash
+ * of the store is the XOR of the hashes of its counts, so a count that changes only changes its
+ * own part, and an empty count adds nothing.
+ */
+static uint64_t hashCount(int index, bool isCity, int16_t count) {
+    if (count == 0)
+        return 0;
+
+    uint64_t value = (uint64_t(index) << 17 | uint64_t(isCity) << 16 | uint16_t(count)) + 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+/**
+ * Default Constructor
+ */
+ArmyMatrix::ArmyMatrix():
+    numRegions(new int(0)),
+    stride(new int(0)),
+    numSlots(new int(0)),
+    armies(new vector<int16_t>()),
+    cities(new vector<int16_t>()),
+    ownerSlots(new vector<int8_t>()),
+    ownerMargins(new vector<int16_t>()),
+    piecesHash(new uint64_t(0)) {}
+
+/**
+ * Initializes an empty store for a map.
+ *
+ * @param regions The number of regions on the map.
+ */
+ArmyMatrix::ArmyMatrix(int regions):
+    numRegions(new int(regions)),
+    stride(new int((regions + REGION_BLOCK - 1) / REGION_BLOCK * REGION_BLOCK)),
+    numSlots(new int(0)),
+    armies(new vector<int16_t>()),
+    cities(new vector<int16_t>()),
+    ownerSlots(new vector<int8_t>(*stride, NO_OWNER)),
+    ownerMargins(new vector<int16_t>(*stride, 0)),
+    piecesHash(new uint64_t(0))
+{
+    armies->reserve(MAX_PLAYERS * *stride);
+    cities->reserve(MAX_PLAYERS * *stride);
+}
+
+/**
+ * Copy Constructor
+ */
+ArmyMatrix::ArmyMatrix(ArmyMatrix* matrix) {
+    numRegions = new int(*matrix->numRegions);
+    stride = new int(*matrix->stride);
+    numSlots = new int(*matrix->numSlots);
+    armies = new vector<int16_t>(*matrix->armies);
+    cities = new vector<int16_t>(*matrix->cities);
+    ownerSlots = new vector<int8_t>(*matrix->ownerSlots);
+    ownerMargins = new vector<int16_t>(*matrix->ownerMargins);
+    piecesHash = new uint64_t(*matrix->piecesHash);
+}
+
+/**
+ * Assignment operator
+ */
+ArmyMatrix& ArmyMatrix::operator=(ArmyMatrix& matrix) {
+    if (&matrix != this) {
+        *numRegions = *matrix.numRegions;
+        *stride = *matrix.stride;
+        *numSlots = *matrix.numSlots;
+        *armies = *matrix.armies;
+        *cities = *matrix.cities;
+        *ownerSlots = *matrix.ownerSlots;
+        *ownerMargins = *matrix.ownerMargins;
+        *piecesHash = *matrix.piecesHash;
+    }
+    return *this;
+}
+
+/**
+ * Destructor
+ */
+ArmyMatrix::~ArmyMatrix() {
+    delete numRegions;
+    delete stride;
+    delete numSlots;
+    delete armies;
+    delete cities;
+    delete ownerSlots;
+    delete ownerMargins;
+    delete piecesHash;
+
+    numRegions = nullptr;
+    stride = nullptr;
+    numSlots = nullptr;
+    armies = nullptr;
+    cities = nullptr;
+    ownerSlots = nullptr;
+    ownerMargins = nullptr;
+    piecesHash = nullptr;
+}
+
+/**
+ * Sets the number of armies a player has on a region. Counts above the int16 range are clamped.
+ *
+ * @param player The ID of the player.
+ * @param region The ID of the region.
+ * @param numArmies The new number of armies.
+ */
+void ArmyMatrix::setArmies(PlayerId player, RegionId region, int numArmies) {
+    if (player >= *numSlots && !addSlots(player))
+        return;
+
+    int index = player * *stride + region;
+    int16_t count = int16_t(max(0, min(numArmies, int(INT16_MAX))));
+
+    *piecesHash ^= hashCount(index, false, (*armies)[index]) ^ hashCount(index, false, count);
+    (*armies)[index] = count;
+}
+
+/**
+ * Sets the number of cities a player has on a region. Counts above the int16 range are clamped.
+ *
+ * @param player The ID of the player.
+ * @param region The ID of the region.
+ * @param numCities The new number of cities.
+ */
+void ArmyMatrix::setCities(PlayerId player, RegionId region, int numCities) {
+    if (player >= *numSlots && !addSlots(player))
+        return;
+
+    int index = player * *stride + region;
+    int16_t count = int16_t(max(0, min(numCities, int(INT16_MAX))));
+
+    *piecesHash ^= hashCount(index, true, (*cities)[index]) ^ hashCount(index, true, count);
+    (*cities)[index] = count;
+}
+
+/**
+ * Removes every piece and every player slot, keeping the memory for the next game.
+ */
+void ArmyMatrix::clear() {
+    *numSlots = 0;
+    armies->clear();
+    cities->clear();
+    fill(ownerSlots->begin(), ownerSlots->end(), NO_OWNER);
+    fill(ownerMargins->begin(), ownerMargins->end(), 0);
+    *piecesHash = 0;
+}
+
+/**
+ * Copies the armies and cities of every slot out of the store, one row of numRegions counts per
+ * player. The rows of players without a slot are cleared.
+ *
+ * @param numPlayers The number of rows to fill, at least the number of slots.
+ * @param armyRows Set to the armies of every player, one row after the other.
+ * @param cityRows Set to the cities of every player, one row after the other.
+ */
+void ArmyMatrix::saveRows(int numPlayers, int16_t* armyRows, int16_t* cityRows) {
+    size_t rowBytes = size_t(*numRegions) * sizeof(int16_t);
+
+    for (int slot = 0; slot < *numSlots; slot++) {
+        memcpy(armyRows + size_t(slot) * *numRegions, armies->data() + size_t(slot) * *stride, rowBytes);
+        memcpy(cityRows + size_t(slot) * *numRegions, cities->data() + size_t(slot) * *stride, rowBytes);
+    }
+
+    memset(armyRows + size_t(*numSlots) * *numRegions, 0, (numPlayers - *numSlots) * rowBytes);
+    memset(cityRows + size_t(*numSlots) * *numRegions, 0, (numPlayers - *numSlots) * rowBytes);
+}
+
+/**
+ * Replaces every count of the store with rows saved by saveRows(), and computes the owner of
+ * every region again.
+ *
+ * @param slots The number of slots the rows were saved with.
+ * @param armyRows The armies of every slot, one row after the other.
+ * @param cityRows The cities of every slot, one row after the other.
+ * @param hash The hash of the store when the rows were saved (see getHash()).
+ */
+void ArmyMatrix::loadRows(int slots, const int16_t* armyRows, const int16_t* cityRows, uint64_t hash) {
+    size_t rowBytes = size_t(*numRegions) * sizeof(int16_t);
+
+    // The padding at the end of each row is never written, so it stays clear.
+    *numSlots = slots;
+    armies->resize(size_t(slots) * *stride, 0);
+    cities->resize(size_t(slots) * *stride, 0);
+
+    for (int slot = 0; slot < slots; slot++) {
+        memcpy(armies->data() + size_t(slot) * *stride, armyRows + size_t(slot) * *numRegions, rowBytes);
+        memcpy(cities->data() + size_t(slot) * *stride, cityRows + size_t(slot) * *numRegions, rowBytes);
+    }
+
+    *piecesHash = hash;
+    computeOwners();
+}
+
+/**
+ * Computes the owner of every region on the map in one pass.
+ *
+ * The owner is the player with the most armies and cities combined, and no one owns a region
+ * when the highest count is shared. Their margin is how far ahead they are of the runner up.
+ * The regions of the map read their owner from here (see Vertex::getOwner()). Works on 16 regions at
+ * a time with AVX2, 8 at a time with SSE2, and falls back to plain loops otherwise. Build with
+ * -mavx2 to get the AVX2 kernel.
+ */
+void ArmyMatrix::computeOwners() {
+    int region = 0;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    const int numSlots = getNumSlots();
+    const int rowSize = *stride;
+    const int16_t* armyRows = armies->data();
+    const int16_t* cityRows = cities->data();
+    int8_t* slotOut = ownerSlots->data();
+    int16_t* marginOut = ownerMargins->data();
+#endif
+
+#if defined(__AVX2__)
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i none = _mm256_set1_epi16(NO_OWNER);
+
+    for (; region < rowSize; region += 16) {
+        __m256i highest = zero, second = zero, leader = none;
+
+        for (int slot = 0; slot < numSlots; slot++) {
+            const int16_t* a = armyRows + slot * rowSize + region;
+            const int16_t* c = cityRows + slot * rowSize + region;
+            __m256i total = _mm256_adds_epi16(_mm256_loadu_si256((const __m256i*) a), _mm256_loadu_si256((const __m256i*) c));
+
+            __m256i isNewLeader = _mm256_cmpgt_epi16(total, highest);
+            second = _mm256_max_epi16(second, _mm256_min_epi16(total, highest));
+            highest = _mm256_max_epi16(highest, total);
+            leader = _mm256_blendv_epi8(leader, _mm256_set1_epi16(int16_t(slot)), isNewLeader);
+        }
+
+        __m256i margin = _mm256_sub_epi16(highest, second);
+        leader = _mm256_blendv_epi8(none, leader, _mm256_cmpgt_epi16(margin, zero));
+
+        _mm256_storeu_si256((__m256i*) (marginOut + region), margin);
+        __m128i packed = _mm_packs_epi16(_mm256_castsi256_si128(leader), _mm256_extracti128_si256(leader, 1));
+        _mm_storeu_si128((__m128i*) (slotOut + region), packed);
+    }
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i none = _mm_set1_epi16(NO_OWNER);
+
+    for (; region < rowSize; region += 8) {
+        __m128i highest = zero, second = zero, leader = none;
+
+        for (int slot = 0; slot < numSlots; slot++) {
+            const int16_t* a = armyRows + slot * rowSize + region;
+            const int16_t* c = cityRows + slot * rowSize + region;
+            __m128i total = _mm_adds_epi16(_mm_loadu_si128((const __m128i*) a), _mm_loadu_si128((const __m128i*) c));
+
+            __m128i isNewLeader = _mm_cmpgt_epi16(total, highest);
+            second = _mm_max_epi16(second, _mm_min_epi16(total, highest));
+            highest = _mm_max_epi16(highest, total);
+            leader = _mm_or_si128(_mm_and_si128(isNewLeader, _mm_set1_epi16(int16_t(slot))), _mm_andnot_si128(isNewLeader, leader));
+        }
+
+        __m128i margin = _mm_sub_epi16(highest, second);
+        __m128i hasOwner = _mm_cmpgt_epi16(margin, zero);
+        leader = _mm_or_si128(_mm_and_si128(hasOwner, leader), _mm_andnot_si128(hasOwner, none));
+
+        _mm_storeu_si128((__m128i*) (marginOut + region), margin);
+        _mm_storel_epi64((__m128i*) (slotOut + region), _mm_packs_epi16(leader, leader));
+    }
+#endif
+
+    computeOwnersScalar(region);
+}
+
+/**
+ * Computes the owner of one region after its armies or cities changed, with the same rule as
+ * computeOwners().
+ *
+ * @param region The ID of the region.
+ */
+void ArmyMatrix::updateOwner(RegionId region) {
+    int highest = 0, second = 0;
+    int8_t leader = NO_OWNER;
+
+    for (int slot = 0; slot < getNumSlots(); slot++) {
+        int total = min(getArmies(slot, region) + getCities(slot, region), int(INT16_MAX));
+
+        if (total > highest) {
+            second = highest;
+            highest = total;
+            leader = int8_t(slot);
+        } else if (total > second) {
+            second = total;
+        }
+    }
+
+    (*ownerSlots)[region] = highest > second ? leader : NO_OWNER;
+    (*ownerMargins)[region] = int16_t(highest - second);
+}
+
+/**
+ * Counts the regions owned by every player.
+ *
+ * @return The number of owned regions, indexed by PlayerId.
+ */
+vector<int> ArmyMatrix::countOwnedRegions() {
+    computeOwners();
+
+    vector<int> ownedRegions(getNumSlots(), 0);
+    for (int region = 0; region < *numRegions; region++) {
+        if ((*ownerSlots)[region] != NO_OWNER)
+            ownedRegions[(*ownerSlots)[region]]++;
+    }
+
+    return ownedRegions;
+}
+
+//PRIVATE
+/**
+ * Adds empty slots up to and including the slot of a player. Prints an error when the
+ * player is past the last slot.
+ *
+ * @param player The ID of the player.
+ * @return A boolean representing if the player has a slot.
+ */
+bool ArmyMatrix::addSlots(PlayerId player) {
+    if (player >= MAX_PLAYERS) {
+        cout << "[ ERROR! ] The map can't hold pieces for more than " << MAX_PLAYERS << " players." << endl;
+        return false;
+    }
+
+    *numSlots = player + 1;
+    armies->resize(*numSlots * *stride, 0);
+    cities->resize(*numSlots * *stride, 0);
+
+    return true;
+}
+
+//PRIVATE
+/**
+ * Plain version of computeOwners(). Handles the regions the vector kernels didn't.
+ *
+ * @param firstRegion The first region to compute the owner of.
+ */
+void ArmyMatrix::computeOwnersScalar(int firstRegion) {
+    for (int region = firstRegion; region < *stride; region++)
+        updateOwner(RegionId(region));
+}
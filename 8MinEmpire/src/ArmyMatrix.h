@@ -0,0 +1,70 @@
+#ifndef ARMY_MATRIX_H
+#define ARMY_MATRIX_H
+
+#include "MapTopology.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Players are numbered in the order they join the map (see GameMap::addPlayer()).
+typedef uint8_t PlayerId;
+
+const PlayerId NO_PLAYER = UINT8_MAX;
+const int MAX_PLAYERS = 8;
+const int8_t NO_OWNER = -1;
+
+/**
+ * Map-wide store of the armies and cities on every region, laid out as structure of arrays.
+ *
+ * Every player that puts a piece on the map has a slot, which is its PlayerId. The armies of
+ * slot s on region r live at armies[s * stride + r], and the same goes for cities. The row stride is padded to a
+ * multiple of 16 regions so computeOwners() can always work on whole vectors. A hash of every
+ * count is kept up to date as the counts change (see getHash()).
+ */
+class ArmyMatrix {
+    int* numRegions;
+    int* stride;
+    int* numSlots;
+    vector<int16_t>* armies;
+    vector<int16_t>* cities;
+    vector<int8_t>* ownerSlots;
+    vector<int16_t>* ownerMargins;
+    uint64_t* piecesHash;
+
+public:
+    ArmyMatrix();
+    ArmyMatrix(int numRegions);
+    ArmyMatrix(ArmyMatrix* matrix);
+    ArmyMatrix& operator=(ArmyMatrix& matrix);
+    ~ArmyMatrix();
+
+    int getNumRegions() { return *numRegions; }
+    int getNumSlots() { return *numSlots; }
+
+    int getArmies(int slot, RegionId region) { return (*armies)[slot * *stride + region]; }
+    int getCities(int slot, RegionId region) { return (*cities)[slot * *stride + region]; }
+    const int16_t* getArmiesRow(int slot) { return armies->data() + slot * *stride; }
+    const int16_t* getCitiesRow(int slot) { return cities->data() + slot * *stride; }
+    void setArmies(PlayerId player, RegionId region, int numArmies);
+    void setCities(PlayerId player, RegionId region, int numCities);
+    void clear();
+    uint64_t getHash() { return *piecesHash; }
+    void saveRows(int numPlayers, int16_t* armyRows, int16_t* cityRows);
+    void loadRows(int slots, const int16_t* armyRows, const int16_t* cityRows, uint64_t hash);
+
+    void computeOwners();
+    void updateOwner(RegionId region);
+    int getOwnerMargin(RegionId region) { return (*ownerMargins)[region]; }
+    const int8_t* getOwnerSlots() { return ownerSlots->data(); }
+    PlayerId getOwner(RegionId region) { return (*ownerSlots)[region] == NO_OWNER ? NO_PLAYER : PlayerId((*ownerSlots)[region]); }
+    vector<int> countOwnedRegions();
+
+private:
+    bool addSlots(PlayerId player);
+    void computeOwnersScalar(int firstRegion);
+};
+
+#endif
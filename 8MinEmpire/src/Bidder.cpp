@@ -1,6 +1,5 @@
 #include "Bidder.h"
-#include "GameInit.h"
-#include <time.h>
+#include "GameContext.h"
 
 /**
  * Default constructor
@@ -19,7 +18,7 @@ Bidder::Bidder():
 Bidder::Bidder(Player* player):
     madeBid(new bool(false)),
     player(player),
-    bidAmount(new int(0)) {srand(time(0));}
+    bidAmount(new int(0)) {}
 
 /**
  * Copy constructor
@@ -74,11 +73,11 @@ int Bidder::bid() {
              << " You have " << player->getCoins() << " coins." << endl;
         cout << "[ BIDDER ] > ";
 
-        if (InitGameEngine::instance()->isTournament())
+        if (player->isInTournament())
         {
 
             int maxBid = player->getCoins();
-            bid = rand() % (maxBid+1);
+            bid = int(player->getContext()->getRandom()->nextBelow(maxBid + 1));
             *bidAmount = bid;
 
             cout << bid << endl;
@@ -131,6 +130,10 @@ Player* Bidder::startBid(Players* players) {
             int bid = it->second->getBidder()->bid();
 
             bids->insert(pair<Player*, int>(it->second, bid));
+
+            GameContext* context = it->second->getContext();
+            if (context && context->getRecorder())
+                context->getRecorder()->recordBid(it->second, bid);
         }
     }
 
@@ -156,11 +159,13 @@ Player* Bidder::calculateWinner(unordered_map<Player*, int>* bids, Players* play
     cout << "\n[ BIDDER ] Finding winning bid ... \n\n";
 
     int max = -1;
-    Player* winner;
+    Player* winner = nullptr;
 
+    // Among equal bids, the player who joined the game first is found first, so the order of
+    // the bids in memory never decides a tie.
     unordered_map<Player*, int>::iterator it;
     for(it = bids->begin(); it != bids->end(); ++it) {
-        if (it->second > max) {
+        if (winner == nullptr || it->second > max || (it->second == max && it->first->getId() < winner->getId())) {
             winner = it->first;
             max = it->second;
         }
@@ -176,7 +181,7 @@ Player* Bidder::calculateWinner(unordered_map<Player*, int>* bids, Players* play
             cout << "[ BIDDER ] Who is the younger player?\n";
             cout << "[ BIDDER ] > ";
 
-            if (InitGameEngine::instance()->isTournament())
+            if (winner->isInTournament())
             {
                 cout << winner->getName() << endl;
             }
@@ -219,7 +224,7 @@ Player* Bidder::getFirstPlayer(Player* winner, Players* players) {
     cout << "[ BIDDER ] " << winner->getName() << ", please choose who goes first. " << endl;
     cout << "[ BIDDER ] > ";
 
-    if(InitGameEngine::instance()->isTournament())
+    if(winner->isInTournament())
     {
         name = winner->getName();
         cout << name << endl;
@@ -0,0 +1,95 @@
+#include "CardAction.h"
+
+#include <stdlib.h>
+
+/**
+ * Compiles a single action, eg. "Add 3 armies" or "Move 2 armies over water".
+ *
+ * @param text The action as printed on the card.
+ * @return The action, with type NO_ACTION if the text isn't an action.
+ */
+Action parseAction(const string& text) {
+    Action action = { NO_ACTION, 0 };
+
+    if (text.compare(0, 4, "Add ") == 0) {
+        action.type = ADD_ARMY;
+        action.amount = uint8_t(atoi(text.c_str() + 4));
+    } else if (text.compare(0, 5, "Move ") == 0) {
+        action.type = text.find("water") != string::npos ? MOVE_OVER_WATER : MOVE_OVER_LAND;
+        action.amount = uint8_t(atoi(text.c_str() + 5));
+    } else if (text.compare(0, 5, "Build") == 0) {
+        action.type = BUILD_CITY;
+        action.amount = 1;
+    } else if (text.compare(0, 7, "Destroy") == 0) {
+        action.type = DESTROY_ARMY;
+        action.amount = 1;
+    }
+
+    return action;
+}
+
+/**
+ * Compiles the action of a card. Double actions are split on " OR " or " AND ".
+ *
+ * @param text The action as printed on the card.
+ * @return The compiled action.
+ */
+CardAction compileAction(const string& text) {
+    CardAction cardAction = { SINGLE_ACTION, { NO_ACTION, 0 }, { NO_ACTION, 0 } };
+
+    size_t orPos = text.find(" OR ");
+    size_t andPos = text.find(" AND ");
+
+    if (orPos != string::npos) {
+        cardAction.combinator = OR_ACTION;
+        cardAction.first = parseAction(text.substr(0, orPos));
+        cardAction.second = parseAction(text.substr(orPos + 4));
+    } else if (andPos != string::npos) {
+        cardAction.combinator = AND_ACTION;
+        cardAction.first = parseAction(text.substr(0, andPos));
+        cardAction.second = parseAction(text.substr(andPos + 5));
+    } else {
+        cardAction.first = parseAction(text);
+    }
+
+    return cardAction;
+}
+
+/**
+ * Writes out an action the way it is printed on the cards.
+ *
+ * @param action The action.
+ * @return The text of the action.
+ */
+string describeAction(const Action& action) {
+    string armies = action.amount == 1 ? " army" : " armies";
+
+    switch (action.type) {
+        case ADD_ARMY:
+            return "Add " + to_string(action.amount) + armies;
+        case MOVE_OVER_LAND:
+            return "Move " + to_string(action.amount) + armies;
+        case MOVE_OVER_WATER:
+            return "Move " + to_string(action.amount) + armies + " over water";
+        case BUILD_CITY:
+            return "Build a city";
+        case DESTROY_ARMY:
+            return "Destroy an army";
+        default:
+            return "No action";
+    }
+}
+
+/**
+ * Writes out the action of a card the way it is printed on the card.
+ *
+ * @param action The action of the card.
+ * @return The text of the action.
+ */
+string describeCardAction(const CardAction& action) {
+    if (action.combinator == OR_ACTION)
+        return describeAction(action.first) + " OR " + describeAction(action.second);
+    if (action.combinator == AND_ACTION)
+        return describeAction(action.first) + " AND " + describeAction(action.second);
+    return describeAction(action.first);
+}
@@ -0,0 +1,46 @@
+#ifndef CARD_ACTION_H
+#define CARD_ACTION_H
+
+#include <stdint.h>
+#include <string>
+
+using namespace std;
+
+// The kinds of action printed on the cards. Doubles as the index into the action jump tables.
+enum ActionType : uint8_t { MOVE_OVER_LAND, ADD_ARMY, DESTROY_ARMY, MOVE_OVER_WATER, BUILD_CITY, NO_ACTION };
+const int NUM_ACTION_TYPES = 6;
+
+// How the two halves of a double action are combined.
+enum ActionCombinator : uint8_t { SINGLE_ACTION, AND_ACTION, OR_ACTION };
+
+/**
+ * A single action, eg. "Move 3 armies over water".
+ */
+struct Action {
+    ActionType type;
+    uint8_t amount;
+
+    bool isMove() const { return type == MOVE_OVER_LAND || type == MOVE_OVER_WATER; }
+    bool isOverWater() const { return type == MOVE_OVER_WATER; }
+};
+
+/**
+ * The action of a card, compiled from its text once when the card is created, so playing it
+ * doesn't search the text again. A double action, eg. "Add 2 armies OR Build a city", keeps
+ * both halves and how they combine. A single action only uses the first.
+ */
+struct CardAction {
+    ActionCombinator combinator;
+    Action first;
+    Action second;
+
+    bool isDouble() const { return combinator != SINGLE_ACTION; }
+    bool contains(ActionType type) const { return first.type == type || (isDouble() && second.type == type); }
+};
+
+Action parseAction(const string& text);
+CardAction compileAction(const string& text);
+string describeAction(const Action& action);
+string describeCardAction(const CardAction& action);
+
+#endif
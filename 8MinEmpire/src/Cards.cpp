@@ -1,21 +1,78 @@
 #include "Cards.h"
 #include "util/MapUtil.h"
-#include "CardsFactory.h"
-
-#include <time.h>
-#define DECK_SIZE 42
+#include "GameContext.h"
 
 using namespace std;
 
+// The 42 cards of the game, indexed by ID - 1.
+static const CardInfo CARDS[DECK_SIZE] = {
+    {  1, GOOD_WOOD,  false, { OR_ACTION,     { ADD_ARMY, 2 },         { MOVE_OVER_LAND, 3 }    } },  // WOOD: Add 2 armies OR Move 3 armies
+    {  2, GOOD_WOOD,  false, { OR_ACTION,     { DESTROY_ARMY, 1 },     { BUILD_CITY, 1 }        } },  // WOOD: Destroy an army OR Build a city
+    {  3, GOOD_WOOD,  false, { SINGLE_ACTION, { ADD_ARMY, 3 },         { NO_ACTION, 0 }         } },  // WOOD: Add 3 armies
+    {  4, GOOD_WOOD,  false, { SINGLE_ACTION, { MOVE_OVER_LAND, 6 },   { NO_ACTION, 0 }         } },  // WOOD: Move 6 armies
+    {  5, GOOD_WOOD,  false, { SINGLE_ACTION, { MOVE_OVER_WATER, 4 },  { NO_ACTION, 0 }         } },  // WOOD: Move 4 armies over water
+    {  6, GOOD_WOOD,  false, { SINGLE_ACTION, { BUILD_CITY, 1 },       { NO_ACTION, 0 }         } },  // WOOD: Build a city
+    {  7, GOOD_WOOD,  false, { SINGLE_ACTION, { MOVE_OVER_WATER, 3 },  { NO_ACTION, 0 }         } },  // WOOD: Move 3 armies over water
+    {  8, GOOD_WOOD,  false, { SINGLE_ACTION, { MOVE_OVER_LAND, 3 },   { NO_ACTION, 0 }         } },  // WOOD: Move 3 armies
+    {  9, GOOD_IRON,  false, { SINGLE_ACTION, { ADD_ARMY, 3 },         { NO_ACTION, 0 }         } },  // IRON: Add 3 armies
+    { 10, GOOD_IRON,  false, { SINGLE_ACTION, { ADD_ARMY, 3 },         { NO_ACTION, 0 }         } },  // IRON: Add 3 armies
+    { 11, GOOD_IRON,  false, { SINGLE_ACTION, { MOVE_OVER_WATER, 3 },  { NO_ACTION, 0 }         } },  // IRON: Move 3 armies over water
+    { 12, GOOD_IRON,  false, { SINGLE_ACTION, { BUILD_CITY, 1 },       { NO_ACTION, 0 }         } },  // IRON: Build a city
+    { 13, GOOD_IRON,  false, { OR_ACTION,     { ADD_ARMY, 3 },         { MOVE_OVER_LAND, 3 }    } },  // IRON: Add 3 armies OR Move 3 armies
+    { 14, GOOD_IRON,  false, { SINGLE_ACTION, { MOVE_OVER_LAND, 4 },   { NO_ACTION, 0 }         } },  // IRON: Move 4 armies
+    { 15, GOOD_IRON,  false, { OR_ACTION,     { ADD_ARMY, 3 },         { MOVE_OVER_LAND, 4 }    } },  // IRON: Add 3 armies OR Move 4 armies
+    { 16, GOOD_IRON,  false, { SINGLE_ACTION, { MOVE_OVER_LAND, 5 },   { NO_ACTION, 0 }         } },  // IRON: Move 5 armies
+    { 17, GOOD_IRON,  true,  { SINGLE_ACTION, { MOVE_OVER_LAND, 4 },   { NO_ACTION, 0 }         } },  // IRON IRON: Move 4 armies
+    { 18, GOOD_CARROT, false, { SINGLE_ACTION, { BUILD_CITY, 1 },       { NO_ACTION, 0 }         } },  // CARROT: Build a city
+    { 19, GOOD_CARROT, false, { SINGLE_ACTION, { MOVE_OVER_LAND, 4 },   { NO_ACTION, 0 }         } },  // CARROT: Move 4 armies
+    { 20, GOOD_CARROT, false, { OR_ACTION,     { ADD_ARMY, 4 },         { MOVE_OVER_LAND, 2 }    } },  // CARROT: Add 4 armies OR Move 2 armies
+    { 21, GOOD_CARROT, false, { SINGLE_ACTION, { MOVE_OVER_WATER, 3 },  { NO_ACTION, 0 }         } },  // CARROT: Move 3 armies over water
+    { 22, GOOD_CARROT, false, { SINGLE_ACTION, { ADD_ARMY, 3 },         { NO_ACTION, 0 }         } },  // CARROT: Add 3 armies
+    { 23, GOOD_CARROT, false, { SINGLE_ACTION, { MOVE_OVER_LAND, 5 },   { NO_ACTION, 0 }         } },  // CARROT: Move 5 armies
+    { 24, GOOD_CARROT, false, { SINGLE_ACTION, { MOVE_OVER_LAND, 4 },   { NO_ACTION, 0 }         } },  // CARROT: Move 4 armies
+    { 25, GOOD_CARROT, false, { SINGLE_ACTION, { ADD_ARMY, 3 },         { NO_ACTION, 0 }         } },  // CARROT: Add 3 armies
+    { 26, GOOD_CARROT, false, { SINGLE_ACTION, { BUILD_CITY, 1 },       { NO_ACTION, 0 }         } },  // CARROT: Build a city
+    { 27, GOOD_CARROT, false, { AND_ACTION,    { DESTROY_ARMY, 1 },     { ADD_ARMY, 1 }          } },  // CARROT: Destroy an army AND Add 1 army
+    { 28, GOOD_GEM,   false, { SINGLE_ACTION, { ADD_ARMY, 2 },         { NO_ACTION, 0 }         } },  // GEM: Add 2 armies
+    { 29, GOOD_GEM,   false, { SINGLE_ACTION, { ADD_ARMY, 2 },         { NO_ACTION, 0 }         } },  // GEM: Add 2 armies
+    { 30, GOOD_GEM,   false, { SINGLE_ACTION, { ADD_ARMY, 2 },         { NO_ACTION, 0 }         } },  // GEM: Add 2 armies
+    { 31, GOOD_GEM,   false, { SINGLE_ACTION, { ADD_ARMY, 1 },         { NO_ACTION, 0 }         } },  // GEM: Add 1 army
+    { 32, GOOD_GEM,   false, { SINGLE_ACTION, { MOVE_OVER_LAND, 2 },   { NO_ACTION, 0 }         } },  // GEM: Move 2 armies
+    { 33, GOOD_STONE, false, { SINGLE_ACTION, { ADD_ARMY, 3 },         { NO_ACTION, 0 }         } },  // STONE: Add 3 armies
+    { 34, GOOD_STONE, false, { SINGLE_ACTION, { MOVE_OVER_WATER, 2 },  { NO_ACTION, 0 }         } },  // STONE: Move 2 armies over water
+    { 35, GOOD_STONE, false, { SINGLE_ACTION, { MOVE_OVER_WATER, 2 },  { NO_ACTION, 0 }         } },  // STONE: Move 2 armies over water
+    { 36, GOOD_STONE, false, { SINGLE_ACTION, { MOVE_OVER_WATER, 3 },  { NO_ACTION, 0 }         } },  // STONE: Move 3 armies over water
+    { 37, GOOD_STONE, false, { SINGLE_ACTION, { MOVE_OVER_LAND, 2 },   { NO_ACTION, 0 }         } },  // STONE: Move 2 armies
+    { 38, GOOD_STONE, false, { OR_ACTION,     { ADD_ARMY, 2 },         { BUILD_CITY, 1 }        } },  // STONE: Add 2 armies OR Build a city
+    { 39, GOOD_STONE, false, { SINGLE_ACTION, { ADD_ARMY, 3 },         { NO_ACTION, 0 }         } },  // STONE: Add 3 armies
+    { 40, GOOD_WILD,  false, { SINGLE_ACTION, { MOVE_OVER_WATER, 2 },  { NO_ACTION, 0 }         } },  // WILD: Move 2 armies over water
+    { 41, GOOD_WILD,  false, { SINGLE_ACTION, { MOVE_OVER_WATER, 2 },  { NO_ACTION, 0 }         } },  // WILD: Move 2 armies over water
+    { 42, GOOD_WILD,  false, { SINGLE_ACTION, { ADD_ARMY, 2 },         { NO_ACTION, 0 }         } },  // WILD: Add 2 armies
+};
+
+/**
+ * Writes out the good of a card, twice for a card that shows it twice.
+ *
+ * @return The good, or NONE.
+ */
+string CardInfo::getGood() const {
+    return doubleGood ? getGoodName(good) + " " + getGoodName(good) : getGoodName(good);
+}
+
+/**
+ * Compiles the good and the action of a card.
+ */
+static CardInfo makeCardInfo(int id, const string& good, const string& action) {
+    int count;
+    GoodId goodId = parseGood(good, count);
+    CardInfo info = { uint8_t(id), goodId, count == 2, compileAction(action) };
+    return info;
+}
+
 /**
  * Default Constructor
  */
-Card::Card():
-    id(new int(0)),
-    good(new string(NONE)),
-    action(new string("No action")),
-    position(new int(0)),
-    cost(new int(0)) {}
+Card::Card(): info(new CardInfo(makeCardInfo(0, NONE, NONE))) {}
 
 /**
  * Initializes a Card object with an ID number, a good and an action.
@@ -25,40 +82,21 @@ Card::Card():
  * @param theAction The action of the card.
  */
 Card::Card(const int& theId, const string& theGood, const string& theAction):
-    id(new int(theId)),
-    good(new string(theGood)),
-    action(new string(theAction)),
-    position(new int(0)),
-    cost(new int(0)) {}
+    info(new CardInfo(makeCardInfo(theId, theGood, theAction))) {}
 
 /**
  * Copy Constructor
  */
 Card::Card(Card* card) {
-    id = new int(card->getID());
-    good = new string(card->getGood());
-    action = new string(card->getAction());
-    position = new int(card->getPosition());
-    cost = new int(card->getCost());
+    info = new CardInfo(card->getInfo());
 }
 
 /**
  * Assignment operator
  */
 Card& Card::operator =(Card& card){
-    if (&card != this) {
-        delete id;
-        delete good;
-        delete action;
-        delete position;
-        delete cost;
-
-        id = new int(card.getID());
-        good = new string(card.getGood());
-        action = new string(card.getAction());
-        position = new int(card.getPosition());
-        cost = new int(card.getCost());
-    }
+    if (&card != this)
+        *info = card.getInfo();
     return *this;
 }
 
@@ -66,93 +104,63 @@ Card& Card::operator =(Card& card){
  * Destructor
  */
 Card::~Card() {
-    delete good;
-    delete action;
-    delete position;
-    delete cost;
-
-    id = nullptr;
-    good = nullptr;
-    action = nullptr;
-    position = nullptr;
-    cost = nullptr;
+    delete info;
+    info = nullptr;
+}
+
+/**
+ * Takes the card at a position out of the market. The cards to its left slide one position to
+ * the right, so the cards keep their order and the free slot ends up on the right.
+ *
+ * @param position The position of the card, from 0 (leftmost) to count - 1.
+ * @return The ID of the card.
+ */
+uint8_t MarketState::take(int position) {
+    uint8_t cardId = at(position);
+
+    for (int i = position; i > 0; i--)
+        slots[(head + i) % MARKET_SIZE] = slots[(head + i - 1) % MARKET_SIZE];
+
+    head = (head + 1) % MARKET_SIZE;
+    count--;
+    lastPosition = uint8_t(position);
+    return cardId;
 }
 
 /**
- * Initliazes a Deck object that contains 42 Card objects.
- * The card order is generated randomly each time a Deck object is created,
- * meaning no two Deck object will have the same order of cards.
+ * Initliazes a Deck object that contains the 42 cards, in order, with its own random number
+ * generator. Call shuffle() before drawing.
  */
-Deck::Deck(){
-
-    typedef pair<string, string>  CardInfo;
-
-    CardInfo cardInfo[] = {
-        CardInfo(WOOD,   "Add 2 armies OR Move 3 armies"),
-        CardInfo(WOOD,   "Destroy an army OR Build a city"),
-        CardInfo(WOOD,   "Add 3 armies"),
-        CardInfo(WOOD,   "Move 6 armies"),
-        CardInfo(WOOD,   "Move 4 armies over water"),
-        CardInfo(WOOD,   "Build a city"),
-        CardInfo(WOOD,   "Move 3 armies over water"),
-        CardInfo(WOOD,   "Move 3 armies"),
-        CardInfo(IRON,   "Add 3 armies"),
-        CardInfo(IRON,   "Add 3 armies"),
-        CardInfo(IRON,   "Move 3 armies over water"),
-        CardInfo(IRON,   "Build a city"),
-        CardInfo(IRON,   "Add 3 armies OR Move 3 armies"),
-        CardInfo(IRON,   "Move 4 armies"),
-        CardInfo(IRON,   "Add 3 armies OR Move 4 armies"),
-        CardInfo(IRON,   "Move 5 armies"),
-        CardInfo(IRON + " " + IRON, "Move 4 armies"),
-        CardInfo(CARROT, "Build a city"),
-        CardInfo(CARROT, "Move 4 armies"),
-        CardInfo(CARROT, "Add 4 armies OR Move 2 armies"),
-        CardInfo(CARROT, "Move 3 armies over water"),
-        CardInfo(CARROT, "Add 3 armies"),
-        CardInfo(CARROT, "Move 5 armies"),
-        CardInfo(CARROT, "Move 4 armies"),
-        CardInfo(CARROT, "Add 3 armies"),
-        CardInfo(CARROT, "Build a city"),
-        CardInfo(CARROT, "Destroy an army AND Add 1 army"),
-        CardInfo(GEM,    "Add 2 armies"),
-        CardInfo(GEM,    "Add 2 armies"),
-        CardInfo(GEM,    "Add 2 armies"),
-        CardInfo(GEM,    "Add 1 army"),
-        CardInfo(GEM,    "Move 2 armies"),
-        CardInfo(STONE,  "Add 3 armies"),
-        CardInfo(STONE,  "Move 2 armies over water"),
-        CardInfo(STONE,  "Move 2 armies over water"),
-        CardInfo(STONE,  "Move 3 armies over water"),
-        CardInfo(STONE,  "Move 2 armies"),
-        CardInfo(STONE,  "Add 2 armies OR Build a city"),
-        CardInfo(STONE,  "Add 3 armies"),
-        CardInfo(WILD,   "Move 2 armies over water"),
-        CardInfo(WILD,   "Move 2 armies over water"),
-        CardInfo(WILD,   "Add 2 armies")
-    };
-
-    cardDeck = new queue<pair<int, Card*> >();
-    cardMap = new map<int,Card*>();
-
-    for(int i = 0; i < 42; i++) {
-
-        string good = cardInfo[i].first;
-        string action = cardInfo[i].second;
-
-        Card* newCard = CardsFactory::create(i+1, good, action);
-        pair<int, Card*> cardEntry(i+1, newCard);
-
-        cardMap->insert(cardEntry);
-        cardDeck->push(cardEntry);
-    }
+Deck::Deck():
+    state(new DeckState()),
+    random(new Random()),
+    ownsRandom(new bool(true))
+{
+    reset();
+}
+
+/**
+ * Initliazes a Deck object that contains the 42 cards, in order. Call shuffle() before drawing.
+ *
+ * @param random A pointer to the random number generator used to shuffle. The deck doesn't own it.
+ */
+Deck::Deck(Random* random):
+    state(new DeckState()),
+    random(random),
+    ownsRandom(new bool(false))
+{
+    reset();
 }
 
 /**
  * Copy Constructor
+ *
+ * The copy shares the random number generator of the original.
  */
 Deck::Deck(Deck* deck) {
-    cardDeck = new queue<pair<int, Card*> >(*deck->getDeck());
+    state = new DeckState(*deck->state);
+    random = deck->random;
+    ownsRandom = new bool(false);
 }
 
 /**
@@ -160,8 +168,12 @@ Deck::Deck(Deck* deck) {
  */
 Deck& Deck::operator =(Deck& deck) {
     if (&deck != this) {
-        delete cardDeck;
-        cardDeck = new queue<pair<int, Card*> >(*deck.getDeck());
+        if (*ownsRandom)
+            delete random;
+
+        *state = *deck.state;
+        random = deck.random;
+        *ownsRandom = false;
     }
     return *this;
 }
@@ -170,81 +182,89 @@ Deck& Deck::operator =(Deck& deck) {
  * Destructor
  */
 Deck::~Deck(){
-    //Delete all the cards left over in the deck.
-    while(!cardDeck->empty()){
-        delete cardDeck->front().second;
-        cardDeck->pop();
-    }
+    if (*ownsRandom)
+        delete random;
 
-    delete cardDeck;
-    delete cardMap;
-
-    cardDeck = nullptr;
-    cardMap = nullptr;
+    delete state;
+    delete ownsRandom;
 
+    state = nullptr;
+    random = nullptr;
+    ownsRandom = nullptr;
 }
 
 /**
- * Shuffles the deck.
+ * Shuffles the cards left in the deck in place with a Fisher-Yates shuffle, drawing from
+ * the deck's random number generator.
  */
 void Deck::shuffle() {
     cout << "\n[ DECK ] Shuffling deck.\n" << endl;
 
-    delete cardDeck;
-
-    cardDeck = new queue<pair<int, Card*> >();
-    set<int>* nums = new set<int>();
-
-    while(nums->size() < DECK_SIZE) {
-        int rand = generateRandomInt(nums);
-        if (cardMap->find(rand) != cardMap->end()) {
-            pair<int, Card*> cardEntry = *cardMap->find(rand);
-            cardDeck->push(cardEntry);
-        }
+    for(int i = DECK_SIZE - 1; i > state->top; i--) {
+        int j = state->top + int(random->nextBelow(uint32_t(i - state->top + 1)));
+        swap(state->order[i], state->order[j]);
     }
 }
 
 /**
  * Removes a Cards from the top of the Deck.
  *
- * @return A Card pointer to the removed card.
+ * @return A pointer to the removed card.
  */
-Card* Deck::draw(){
-    pair<int, Card*> cardEntry = cardDeck->front();
-    cardDeck->pop();
+const CardInfo* Deck::draw(){
+    const CardInfo* card = getCard(drawId());
 
-    cardMap->erase(cardEntry.first);
+    cout << "[ DECK ] Drew card { " << card->getGood() << " : \"" << card->getAction() << "\" } from the deck." << endl;
+    return card;
+}
 
-    cout << "[ DECK ] Drew card { " << cardEntry.second->getGood() << " : \"" << cardEntry.second->getAction() << "\" } from the deck." << endl;
-    return cardEntry.second;
+/**
+ * Removes a card from the top of the Deck, without announcing it.
+ *
+ * @return The ID of the removed card.
+ */
+uint8_t Deck::drawId() {
+    return state->order[state->top++];
 }
 
-//PRIVATE
 /**
- * Generates a random integer. Used for shuffling card order.
+ * Gets one of the 42 cards of the game. The cards never change, so every deck of every game
+ * shares the same table.
+ *
+ * @param id The ID of the card, from 1 to 42.
+ * @return A pointer to the card.
  */
-int Deck::generateRandomInt(set<int>* nums){
-    srand (time(0));
-
-    while (true){
-        int num = (rand() % DECK_SIZE) + 1;
-        if(nums->find(num) == nums->end()) {
-            nums->insert(num);
-            return num;
-        }
-    }
+const CardInfo* Deck::getCard(int id) {
+    return &CARDS[id - 1];
+}
+
+/**
+ * Puts the 42 cards back in the deck, in order, eg. to deal a new game. Call shuffle() before
+ * drawing.
+ */
+void Deck::reset() {
+    for (int i = 0; i < DECK_SIZE; i++)
+        state->order[i] = uint8_t(i + 1);
+    state->top = 0;
 }
 
 /**
  * Default Constructor
  */
-Hand::Hand(): hand(new vector<Card*>()), deck(new Deck()) {}
+Hand::Hand(): market(new MarketState()), deck(new Deck()) {}
+
+/**
+ * Initializes an empty hand over a deck shuffled with the given random number generator.
+ *
+ * @param random A pointer to the random number generator. The hand doesn't own it.
+ */
+Hand::Hand(Random* random): market(new MarketState()), deck(new Deck(random)) {}
 
 /**
  * Copy Constructor
  */
 Hand::Hand(Hand* otherGameHand) {
-    hand = new vector<Card*>(*otherGameHand->getHand());
+    market = new MarketState(*otherGameHand->market);
     deck = new Deck(otherGameHand->getDeck());
 }
 
@@ -253,10 +273,8 @@ Hand::Hand(Hand* otherGameHand) {
  */
 Hand& Hand::operator=(Hand& otherGameHand) {
     if (&otherGameHand != this) {
-        delete hand;
-        delete deck;
-        hand = new vector<Card*>(*otherGameHand.getHand());
-        deck = new Deck(otherGameHand.getDeck());
+        *market = *otherGameHand.market;
+        *deck = *otherGameHand.deck;
     }
     return *this;
 }
@@ -265,14 +283,10 @@ Hand& Hand::operator=(Hand& otherGameHand) {
  * Destructor
  */
 Hand::~Hand(){
-    //Delete all the cards in the game hand.
-    for(vector<Card*>::iterator it = hand->begin(); it != hand->end(); ++it)
-        delete *it;
-
-    delete hand;
+    delete market;
     delete deck;
 
-    hand = nullptr;
+    market = nullptr;
     deck = nullptr;
 }
 
@@ -282,12 +296,12 @@ Hand::~Hand(){
  */
 void Hand::fill() {
 
-    if(hand->size() != 6) {
+    if(market->count != MARKET_SIZE) {
         deck->shuffle();
 
         //Populate game hand
-        for(int i = 0; i < 6; i++) {
-            hand->push_back(deck->draw());
+        for(int i = 0; i < MARKET_SIZE; i++) {
+            market->push(uint8_t(deck->draw()->getID()));
         }
     } else {
         cout << "[ ERROR! ] Hand has already been populated." << endl;
@@ -302,31 +316,22 @@ void Hand::fill() {
  * top of the deck and place it in the back of the hand.
  *
  * @param player A Player pointer to the current player.
- * @return A Card pointer to the removed card.
+ * @return A pointer to the removed card.
  */
-Card* Hand::exchange(Player* player){
-    int position;
-    int values[] = {0, 1, 1, 2, 2, 3};
-
+const CardInfo* Hand::exchange(Player* player){
     while(true) {
-        position = selectCardPosition(player);
-        if (player->PayCoins(values[position])) {
-
-            Card* card = hand->at(position);
+        int position = selectCardPosition(player);
+        if (player->PayCoins(CARD_COSTS[position])) {
 
-            card->setPosition(position);
-            card->setCost(values[position]);
+            const CardInfo* card = Deck::getCard(market->take(position));
 
 			player->addCardToHand(card);
 
-            vector<Card*>::iterator it;
-            for(it = hand->begin(); it != hand->end(); ++it) {
-                if (*it == card) {
-                    cout << "[ GAME HAND ] Removed card { " << (*it)->getGood() << " : \"" << (*it)->getAction() << "\" } from game hand.\n"<< endl;
-                    hand->erase(it);
-                    break;
-                }
-            }
+            cout << "[ GAME HAND ] Removed card { " << card->getGood() << " : \"" << card->getAction() << "\" } from game hand.\n"<< endl;
+
+            GameContext* context = player->getContext();
+            if (context && context->getRecorder())
+                context->getRecorder()->recordCard(player, position);
 
             return card;
         }
@@ -337,10 +342,10 @@ Card* Hand::exchange(Player* player){
  * Draws one card from the deck and adds it to the end (ie right hand side) of the game hand.
  */
 void Hand::drawCardFromDeck() {
-    Card* card = deck->draw();
+    const CardInfo* card = deck->draw();
     cout << "\n[ GAME HAND ] Drew card { " << card->getGood() << " : \"" << card->getAction() << "\" } from deck." << endl;
     cout << "[ GAME HAND ] Adding it to the right side of the game hand.\n" << endl;
-    hand->push_back(card);
+    market->push(uint8_t(card->getID()));
 }
 
 /**
@@ -350,11 +355,11 @@ void Hand::printHand() {
     cout << "\n[ GAME HAND ] C U R R E N T   H A N D" << endl;
     cout << "---------------------------------------------------------------------------" << endl;
 
-    int values[] = {0, 1, 1, 2, 2, 3};
-    int count= 0;
-    for(Card* c : *hand) {
-        printf("%d [ %d ] Card ID: %-5d Good: %-10s Action: %s\n", count+1, values[count], c->getID(), c->getGood().c_str(), c->getAction().c_str());
-        count++;
+    for(int position = 0; position < size(); position++) {
+        const CardInfo* c = getCard(position);
+        char cardbuff[64];
+        snprintf(cardbuff, sizeof(cardbuff), "%d [ %d ] Card ID: %-5d Good: %-10s ", position+1, CARD_COSTS[position], c->getID(), c->getGood().c_str());
+        cout << cardbuff << "Action: " << c->getAction() << "\n";
     }
 
     cout << "---------------------------------------------------------------------------" << endl;
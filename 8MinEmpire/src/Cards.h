@@ -1,8 +1,12 @@
 #ifndef CARDS_H
 #define CARDS_H
 
+#include "CardAction.h"
+#include "Goods.h"
 #include "Player.h"
+#include "Random.h"
 
+#include <stdint.h>
 #include <string>
 #include <vector>
 #include <queue>
@@ -14,20 +18,36 @@ using namespace std;
 
 class Player;
 
-const string WOOD = "WOOD";
-const string IRON = "IRON";
-const string CARROT = "CARROT";
-const string GEM = "GEM";
-const string STONE = "STONE";
-const string WILD = "WILD";
-const string NONE = "NONE";
+// The number of cards in the game, and of cards face up in the market of the game hand.
+const int DECK_SIZE = 42;
+const int MARKET_SIZE = 6;
+
+// What the card at each position of the market costs.
+constexpr int CARD_COSTS[MARKET_SIZE] = {0, 1, 1, 2, 2, 3};
+
+/**
+ * One card of the game: its ID, its good, whether it shows the good twice, and its compiled
+ * action. Everything the game looks at when a card is played, in a few bytes. The cards of the
+ * game are a constant table of these (see Deck::getCard()), and their text is only written out
+ * when a card is printed.
+ */
+struct CardInfo {
+    uint8_t id;
+    GoodId good;
+    bool doubleGood;
+    CardAction action;
+
+    int getID() const { return id; }
+    GoodId getGoodId() const { return good; }
+    int getGoodCount() const { return good == NO_GOOD ? 0 : doubleGood ? 2 : 1; }
+    const CardAction& getCardAction() const { return action; }
+    const string& getType() const { return getGoodName(good); }
+    string getGood() const;
+    string getAction() const { return describeCardAction(action); }
+};
 
 class Card {
-    int* id;
-    string* good;
-    string* action;
-    int* position;
-    int* cost;
+    CardInfo* info;
 
 public:
     Card();
@@ -36,52 +56,85 @@ public:
     Card& operator=(Card& card);
     virtual ~Card();
 
-    int getID() { return *id; }
-    string getGood() { return *good; }
-    string getAction() { return *action; }
-    int getPosition() { return *position; }
-    int getCost() { return *cost; }
+    int getID() { return info->getID(); }
+    string getGood() { return info->getGood(); }
+    GoodId getGoodId() { return info->good; }
+    int getGoodCount() { return info->getGoodCount(); }
+    string getAction() { return info->getAction(); }
+    const CardAction& getCardAction() { return info->action; }
+    const CardInfo& getInfo() { return *info; }
     virtual string getType() { return NONE; }
+};
 
-    void setPosition(int& position) { *this->position = position; }
-    void setCost(int& cost) { *this->cost = cost; }
+/**
+ * The order of a deck: the IDs of its cards, and the position of the card on top.
+ */
+struct DeckState {
+    uint8_t order[DECK_SIZE];
+    uint8_t top;
+};
+
+/**
+ * The face up cards of the game hand, as a ring buffer of card IDs. Taking a card slides the
+ * cards to its left one position to the right, and new cards are added on the right.
+ */
+struct MarketState {
+    uint8_t slots[MARKET_SIZE];
+    uint8_t head;
+    uint8_t count;
+    uint8_t lastPosition;
+
+    uint8_t at(int position) const { return slots[(head + position) % MARKET_SIZE]; }
+    void push(uint8_t cardId) { slots[(head + count++) % MARKET_SIZE] = cardId; }
+    uint8_t take(int position);
 };
 
 class Deck {
-    queue<pair<int, Card*>>* cardDeck;
-    map<int, Card*>* cardMap;
+    DeckState* state;
+    Random* random;
+    bool* ownsRandom;
 
 public:
     Deck();
+    Deck(Random* random);
     Deck(Deck* deck);
     Deck& operator=(Deck& deck);
     ~Deck();
 
-    Card* draw();
+    const CardInfo* draw();
+    uint8_t drawId();
     void shuffle();
+    void reset();
 
-    queue<pair<int, Card*>>* getDeck() { return cardDeck; }
+    int size() { return DECK_SIZE - state->top; }
+    bool empty() { return size() == 0; }
+    Random* getRandom() { return random; }
+    DeckState* getState() { return state; }
 
-private:
-    int generateRandomInt(set<int>* nums);
+    static const CardInfo* getCard(int id);
 };
 
 class Hand {
-    vector<Card*>* hand;
+    MarketState* market;
     Deck* deck;
 
 public:
     Hand();
+    Hand(Random* random);
     Hand(Hand* hand);
     Hand& operator=(Hand& hand);
     ~Hand();
 
     void fill();
-    Card* exchange(Player* player);
+    const CardInfo* exchange(Player* player);
     void drawCardFromDeck();
     void printHand();
 
-    vector<Card*>* getHand() { return hand; }
+    int size() { return market->count; }
+    const CardInfo* getCard(int position) { return Deck::getCard(market->at(position)); }
+    int getLastPosition() { return market->lastPosition; }
+    int getLastCost() { return CARD_COSTS[market->lastPosition]; }
+    MarketState* getMarket() { return market; }
     Deck* getDeck() { return deck; }
 
 private:
@@ -0,0 +1,364 @@
+#include "CompiledMap.h"
+#include "Map.h"
+
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+
+/**
+ * Default Constructor
+ */
+CompiledMap::CompiledMap():
+    file(new MappedFile()) {}
+
+/**
+ * Destructor
+ */
+CompiledMap::~CompiledMap() {
+    delete file;
+    file = nullptr;
+}
+
+/**
+ * Compiles a loaded map to a binary file. The file is written next to its final path first
+ * and then renamed, so a reader never sees a half written file.
+ *
+ * @param path The path of the compiled map file.
+ * @param sourcePath The path of the text map the map was loaded from.
+ * @param map A pointer to the loaded map.
+ * @return A boolean representing if the file was written.
+ */
+bool CompiledMap::write(const string& path, const string& sourcePath, GameMap* map) {
+    struct stat sourceInfo;
+    if (stat(sourcePath.c_str(), &sourceInfo) != 0) {
+        cout << "[ ERROR! ] Can't find the map file < " << sourcePath << " >." << endl;
+        return false;
+    }
+
+    MapTopology* graph = map->getTopology();
+    const uint32_t numRegions = uint32_t(graph->getNumRegions());
+    const uint32_t numContinents = uint32_t(graph->getNumContinents());
+
+    // Intern every key, name and continent name into one string pool.
+    string strings;
+    unordered_map<string, CompiledString> pool;
+    auto intern = [&](const string& text) {
+        unordered_map<string, CompiledString>::iterator it = pool.find(text);
+        if (it != pool.end())
+            return it->second;
+
+        CompiledString ref = { uint32_t(strings.size()), uint32_t(text.size()) };
+        strings.append(text);
+        pool.insert(pair<string, CompiledString>(text, ref));
+        return ref;
+    };
+
+    vector<CompiledRegion> regions(numRegions);
+    for (RegionId id = 0; id < numRegions; id++) {
+        regions[id].key = intern(graph->getKey(id));
+        regions[id].name = intern(graph->getName(id));
+        regions[id].continent = intern(graph->getContinent(id));
+    }
+
+    vector<CompiledString> continentNames(numContinents);
+    for (ContinentId continent = 0; continent < numContinents; continent++)
+        continentNames[continent] = intern(graph->getContinentName(continent));
+
+    CompiledMapHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, COMPILED_MAP_MAGIC, sizeof(header.magic));
+    header.version = COMPILED_MAP_VERSION;
+    header.headerSize = sizeof(CompiledMapHeader);
+    header.sourceSize = uint64_t(sourceInfo.st_size);
+    header.sourceModified = int64_t(sourceInfo.st_mtime);
+    header.numRegions = numRegions;
+    header.numNeighbours = uint32_t(graph->neighbours->size());
+    header.numContinents = numContinents;
+    header.imageSize = uint32_t(map->getImage().size());
+    header.stringsSize = strings.size();
+    header.keyHashSeed = *graph->keyHash->seed;
+
+    vector<char> buffer(sizeof(CompiledMapHeader), 0);
+    auto addSection = [&](const void* bytes, size_t length) {
+        buffer.resize((buffer.size() + 7) & ~size_t(7), 0);
+        uint64_t offset = buffer.size();
+        buffer.insert(buffer.end(), (const char*) bytes, (const char*) bytes + length);
+        return offset;
+    };
+
+    header.stringsOffset = addSection(strings.data(), strings.size());
+    header.regionsOffset = addSection(regions.data(), regions.size() * sizeof(CompiledRegion));
+    header.edgeOffsetsOffset = addSection(graph->edgeOffsets->data(), graph->edgeOffsets->size() * sizeof(uint32_t));
+    header.waterOffsetsOffset = addSection(graph->waterOffsets->data(), graph->waterOffsets->size() * sizeof(uint32_t));
+    header.neighboursOffset = addSection(graph->neighbours->data(), graph->neighbours->size() * sizeof(RegionId));
+    header.continentOfOffset = addSection(graph->continentOf->data(), graph->continentOf->size() * sizeof(ContinentId));
+    header.continentOffsetsOffset = addSection(graph->continentOffsets->data(), graph->continentOffsets->size() * sizeof(uint32_t));
+    header.continentMembersOffset = addSection(graph->continentMembers->data(), graph->continentMembers->size() * sizeof(RegionId));
+    header.continentNamesOffset = addSection(continentNames.data(), continentNames.size() * sizeof(CompiledString));
+    header.keyHashDisplacementsOffset = addSection(graph->keyHash->displacements->data(), numRegions * sizeof(int32_t));
+    header.keyHashSlotsOffset = addSection(graph->keyHash->slots->data(), numRegions * sizeof(uint32_t));
+    header.imageOffset = addSection(map->getImage().data(), map->getImage().size());
+
+    header.fileSize = buffer.size();
+    header.checksum = computeChecksum(buffer.data() + sizeof(CompiledMapHeader), buffer.size() - sizeof(CompiledMapHeader));
+    memcpy(buffer.data(), &header, sizeof(header));
+
+    string tempPath = path + ".tmp";
+    ofstream out(tempPath, ios::binary | ios::trunc);
+    out.write(buffer.data(), buffer.size());
+    out.close();
+
+    if (!out || rename(tempPath.c_str(), path.c_str()) != 0) {
+        cout << "[ ERROR! ] Couldn't write the compiled map < " << path << " >." << endl;
+        remove(tempPath.c_str());
+        return false;
+    }
+
+    cout << "[ MAP COMPILER ] Wrote < " << path << " > (" << buffer.size() << " bytes)." << endl;
+    return true;
+}
+
+/**
+ * Maps a compiled map file into memory and checks that it can be used.
+ *
+ * @param path The path of the compiled map file.
+ * @param sourcePath The path of the text map. If it changed since the map was compiled, the
+ *                   compiled map is out of date and isn't used.
+ * @return A boolean representing if the compiled map is open and can be used.
+ */
+bool CompiledMap::open(const string& path, const string& sourcePath) {
+    if (!file->open(path) || file->getSize() < sizeof(CompiledMapHeader)) {
+        close();
+        return false;
+    }
+
+    if (!isValid(path, sourcePath)) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Creates the topology of the compiled map. The adjacency lists, the continent partition and
+ * the perfect hash of the region keys are copied straight out of the file. Only the neighbour
+ * bitsets are built again, as they would take numRegions^2 / 4 bytes of the file.
+ *
+ * @return A pointer to a new MapTopology object. The caller owns it.
+ */
+MapTopology* CompiledMap::createTopology() {
+    const CompiledMapHeader* header = getHeader();
+    const uint32_t numRegions = header->numRegions;
+    const uint32_t numContinents = header->numContinents;
+
+    MapTopology* graph = new MapTopology();
+
+    const CompiledRegion* regions = (const CompiledRegion*) (getData() + header->regionsOffset);
+    graph->keys->reserve(numRegions);
+    graph->names->reserve(numRegions);
+    graph->continents->reserve(numRegions);
+
+    for (RegionId id = 0; id < numRegions; id++) {
+        graph->keys->push_back(getString(regions[id].key));
+        graph->names->push_back(getString(regions[id].name));
+        graph->continents->push_back(getString(regions[id].continent));
+    }
+
+    const uint32_t* edgeOffsets = (const uint32_t*) (getData() + header->edgeOffsetsOffset);
+    const uint32_t* waterOffsets = (const uint32_t*) (getData() + header->waterOffsetsOffset);
+    const RegionId* neighbours = (const RegionId*) (getData() + header->neighboursOffset);
+    graph->edgeOffsets->assign(edgeOffsets, edgeOffsets + numRegions + 1);
+    graph->waterOffsets->assign(waterOffsets, waterOffsets + numRegions);
+    graph->neighbours->assign(neighbours, neighbours + header->numNeighbours);
+
+    const ContinentId* continentOf = (const ContinentId*) (getData() + header->continentOfOffset);
+    const uint32_t* continentOffsets = (const uint32_t*) (getData() + header->continentOffsetsOffset);
+    const RegionId* continentMembers = (const RegionId*) (getData() + header->continentMembersOffset);
+    const CompiledString* continentNames = (const CompiledString*) (getData() + header->continentNamesOffset);
+    graph->continentOf->assign(continentOf, continentOf + numRegions);
+    graph->continentOffsets->assign(continentOffsets, continentOffsets + numContinents + 1);
+    graph->continentMembers->assign(continentMembers, continentMembers + numRegions);
+
+    for (ContinentId continent = 0; continent < numContinents; continent++)
+        graph->continentNames->push_back(getString(continentNames[continent]));
+
+    const int32_t* displacements = (const int32_t*) (getData() + header->keyHashDisplacementsOffset);
+    const uint32_t* slots = (const uint32_t*) (getData() + header->keyHashSlotsOffset);
+    *graph->keyHash->seed = header->keyHashSeed;
+    graph->keyHash->displacements->assign(displacements, displacements + numRegions);
+    graph->keyHash->slots->assign(slots, slots + numRegions);
+
+    graph->buildNeighbourMasks();
+
+    return graph;
+}
+
+/**
+ * Gets the ASCII image of the compiled map.
+ */
+string CompiledMap::getImage() {
+    return string(getData() + getHeader()->imageOffset, getHeader()->imageSize);
+}
+
+//PRIVATE
+/**
+ * Checks the header, the section bounds, the checksum and the contents of the open file, and
+ * makes sure the text map didn't change since it was compiled.
+ *
+ * @param path The path of the compiled map file.
+ * @param sourcePath The path of the text map.
+ * @return A boolean representing if the compiled map can be used.
+ */
+bool CompiledMap::isValid(const string& path, const string& sourcePath) {
+    const CompiledMapHeader* header = getHeader();
+
+    if (memcmp(header->magic, COMPILED_MAP_MAGIC, sizeof(header->magic)) != 0
+        || header->version != COMPILED_MAP_VERSION
+        || header->headerSize != sizeof(CompiledMapHeader)
+        || header->fileSize != file->getSize()) {
+        cout << "[ MAP LOADER ] < " << path << " > isn't a compiled map of this version. Loading the text map." << endl;
+        return false;
+    }
+
+    struct stat sourceInfo;
+    if (stat(sourcePath.c_str(), &sourceInfo) == 0
+        && (uint64_t(sourceInfo.st_size) != header->sourceSize || int64_t(sourceInfo.st_mtime) != header->sourceModified)) {
+        cout << "[ MAP LOADER ] < " << path << " > is out of date. Loading the text map." << endl;
+        return false;
+    }
+
+    const uint64_t numRegions = header->numRegions;
+    const uint64_t numContinents = header->numContinents;
+    const uint64_t sections[][2] = {
+        { header->stringsOffset, header->stringsSize },
+        { header->regionsOffset, numRegions * sizeof(CompiledRegion) },
+        { header->edgeOffsetsOffset, (numRegions + 1) * sizeof(uint32_t) },
+        { header->waterOffsetsOffset, numRegions * sizeof(uint32_t) },
+        { header->neighboursOffset, uint64_t(header->numNeighbours) * sizeof(RegionId) },
+        { header->continentOfOffset, numRegions * sizeof(ContinentId) },
+        { header->continentOffsetsOffset, (numContinents + 1) * sizeof(uint32_t) },
+        { header->continentMembersOffset, numRegions * sizeof(RegionId) },
+        { header->continentNamesOffset, numContinents * sizeof(CompiledString) },
+        { header->keyHashDisplacementsOffset, numRegions * sizeof(int32_t) },
+        { header->keyHashSlotsOffset, numRegions * sizeof(uint32_t) },
+        { header->imageOffset, header->imageSize },
+    };
+
+    for (const uint64_t* section : sections) {
+        if (section[0] < sizeof(CompiledMapHeader) || section[0] % 8 != 0 || section[0] + section[1] > file->getSize()) {
+            cout << "[ MAP LOADER ] < " << path << " > is corrupt. Loading the text map." << endl;
+            return false;
+        }
+    }
+
+    uint64_t checksum = computeChecksum(getData() + sizeof(CompiledMapHeader), file->getSize() - sizeof(CompiledMapHeader));
+    if (checksum != header->checksum) {
+        cout << "[ MAP LOADER ] < " << path << " > failed its checksum. Loading the text map." << endl;
+        return false;
+    }
+
+    if (!hasValidContents()) {
+        cout << "[ MAP LOADER ] < " << path << " > is corrupt. Loading the text map." << endl;
+        return false;
+    }
+
+    return true;
+}
+
+//PRIVATE
+/**
+ * Checks that every index in the sections of the open file stays inside what it indexes: the
+ * strings inside the string pool, the offsets of the adjacency lists and of the continents in
+ * order and inside their arrays, and every region, continent and hash slot below their counts.
+ * A file that passes can be used without reading past any section. The perfect hash isn't
+ * checked any further, as a key found through it is always compared against the key it finds.
+ *
+ * @return A boolean representing if the contents can be used.
+ */
+bool CompiledMap::hasValidContents() {
+    const CompiledMapHeader* header = getHeader();
+    const uint32_t numRegions = header->numRegions;
+    const uint32_t numContinents = header->numContinents;
+
+    auto isInPool = [header](const CompiledString& ref) {
+        return uint64_t(ref.offset) + ref.length <= header->stringsSize;
+    };
+
+    // The offsets start at 0, never go down and end at the size of the array they index.
+    auto isAscending = [](const uint32_t* offsets, uint32_t count, uint32_t size) {
+        if (offsets[0] != 0 || offsets[count] != size)
+            return false;
+
+        for (uint32_t i = 0; i < count; i++) {
+            if (offsets[i] > offsets[i + 1])
+                return false;
+        }
+        return true;
+    };
+
+    const CompiledRegion* regions = (const CompiledRegion*) (getData() + header->regionsOffset);
+    for (RegionId id = 0; id < numRegions; id++) {
+        if (!isInPool(regions[id].key) || !isInPool(regions[id].name) || !isInPool(regions[id].continent))
+            return false;
+    }
+
+    const CompiledString* continentNames = (const CompiledString*) (getData() + header->continentNamesOffset);
+    for (ContinentId continent = 0; continent < numContinents; continent++) {
+        if (!isInPool(continentNames[continent]))
+            return false;
+    }
+
+    const uint32_t* edgeOffsets = (const uint32_t*) (getData() + header->edgeOffsetsOffset);
+    const uint32_t* waterOffsets = (const uint32_t*) (getData() + header->waterOffsetsOffset);
+    if (!isAscending(edgeOffsets, numRegions, header->numNeighbours))
+        return false;
+
+    for (RegionId id = 0; id < numRegions; id++) {
+        if (waterOffsets[id] < edgeOffsets[id] || waterOffsets[id] > edgeOffsets[id + 1])
+            return false;
+    }
+
+    const RegionId* neighbours = (const RegionId*) (getData() + header->neighboursOffset);
+    for (uint32_t edge = 0; edge < header->numNeighbours; edge++) {
+        if (neighbours[edge] >= numRegions)
+            return false;
+    }
+
+    const ContinentId* continentOf = (const ContinentId*) (getData() + header->continentOfOffset);
+    const uint32_t* continentOffsets = (const uint32_t*) (getData() + header->continentOffsetsOffset);
+    const RegionId* continentMembers = (const RegionId*) (getData() + header->continentMembersOffset);
+    if (!isAscending(continentOffsets, numContinents, numRegions))
+        return false;
+
+    for (RegionId id = 0; id < numRegions; id++) {
+        if (continentOf[id] >= numContinents || continentMembers[id] >= numRegions)
+            return false;
+    }
+
+    const int32_t* displacements = (const int32_t*) (getData() + header->keyHashDisplacementsOffset);
+    const uint32_t* slots = (const uint32_t*) (getData() + header->keyHashSlotsOffset);
+    for (uint32_t i = 0; i < numRegions; i++) {
+        if (slots[i] >= numRegions || (displacements[i] < 0 && uint32_t(-(int64_t(displacements[i]) + 1)) >= numRegions))
+            return false;
+    }
+
+    return true;
+}
+
+//PRIVATE
+/**
+ * 64 bit FNV-1a hash of a run of bytes.
+ */
+uint64_t CompiledMap::computeChecksum(const char* bytes, size_t length) {
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= uint8_t(bytes[i]);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
@@ -0,0 +1,106 @@
+#ifndef COMPILED_MAP_H
+#define COMPILED_MAP_H
+
+#include "MapTopology.h"
+#include "util/TextUtil.h"
+
+#include <stdint.h>
+#include <string>
+
+using namespace std;
+
+class GameMap;
+
+const char COMPILED_MAP_MAGIC[8] = { '8', 'M', 'E', 'M', 'A', 'P', 'C', '\0' };
+const uint32_t COMPILED_MAP_VERSION = 2;
+const string COMPILED_MAP_SUFFIX = "c";
+
+/**
+ * A reference to a string in the string pool of a compiled map.
+ */
+struct CompiledString {
+    uint32_t offset;
+    uint32_t length;
+};
+
+/**
+ * One row of the region table of a compiled map. Rows are indexed by region ID.
+ */
+struct CompiledRegion {
+    CompiledString key;
+    CompiledString name;
+    CompiledString continent;
+};
+
+/**
+ * The header at the start of a compiled map file. Every section offset is from the start of
+ * the file and is aligned to 8 bytes. The checksum covers everything after the header.
+ */
+struct CompiledMapHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t fileSize;
+    uint64_t checksum;
+
+    // Size and modification time of the text map the file was compiled from.
+    uint64_t sourceSize;
+    int64_t sourceModified;
+
+    uint32_t numRegions;
+    uint32_t numNeighbours;
+    uint32_t numContinents;
+    uint32_t imageSize;
+    uint64_t stringsSize;
+
+    // Seed of the perfect hash of the region keys. Its displacements and slots are sections.
+    uint64_t keyHashSeed;
+
+    uint64_t stringsOffset;
+    uint64_t regionsOffset;
+    uint64_t edgeOffsetsOffset;
+    uint64_t waterOffsetsOffset;
+    uint64_t neighboursOffset;
+    uint64_t continentOfOffset;
+    uint64_t continentOffsetsOffset;
+    uint64_t continentMembersOffset;
+    uint64_t continentNamesOffset;
+    uint64_t keyHashDisplacementsOffset;
+    uint64_t keyHashSlotsOffset;
+    uint64_t imageOffset;
+};
+
+/**
+ * A map compiled to a binary file. The file holds the region table, the interned strings, the
+ * adjacency lists, the continent partition, the perfect hash of the region keys and the map
+ * image, laid out so they can be used straight from a memory mapping.
+ */
+class CompiledMap {
+    MappedFile* file;
+
+public:
+    CompiledMap();
+    CompiledMap(CompiledMap* compiledMap) = delete;
+    CompiledMap& operator=(CompiledMap& compiledMap) = delete;
+    ~CompiledMap();
+
+    static bool write(const string& path, const string& sourcePath, GameMap* map);
+
+    bool open(const string& path, const string& sourcePath);
+    void close() { file->close(); }
+    bool isOpen() { return file->isOpen(); }
+
+    MapTopology* createTopology();
+    string getImage();
+
+private:
+    const char* getData() { return file->getData(); }
+    const CompiledMapHeader* getHeader() { return (const CompiledMapHeader*) getData(); }
+    string getString(const CompiledString& ref) { return string(getData() + getHeader()->stringsOffset + ref.offset, ref.length); }
+    bool isValid(const string& path, const string& sourcePath);
+    bool hasValidContents();
+
+    static uint64_t computeChecksum(const char* bytes, size_t length);
+};
+
+#endif
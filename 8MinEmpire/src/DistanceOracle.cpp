@@ -0,0 +1,249 @@
+#include "DistanceOracle.h"
+
+#include <algorithm>
+
+/**
+ * Initializes a DistanceOracle object. On small maps the distance tables are built right away.
+ *
+ * @param topology A pointer to the topology of the map. The oracle doesn't own it.
+ */
+DistanceOracle::DistanceOracle(const MapTopology* topology):
+    graph(topology),
+    landTable(new vector<uint8_t>()),
+    waterTable(new vector<uint8_t>()),
+    cachedBlocks(new vector<vector<uint8_t>>()),
+    cachedKeys(new vector<int64_t>()),
+    cacheIndex(new unordered_map<int64_t, size_t>()),
+    nextSlot(new size_t(0)),
+    cacheLock(new mutex())
+{
+    if (graph->getNumRegions() <= MAX_TABLE_REGIONS)
+        buildTables();
+}
+
+/**
+ * Copy Constructor
+ */
+DistanceOracle::DistanceOracle(DistanceOracle* oracle) {
+    graph = oracle->graph;
+    landTable = new vector<uint8_t>(*oracle->landTable);
+    waterTable = new vector<uint8_t>(*oracle->waterTable);
+    cachedBlocks = new vector<vector<uint8_t>>(*oracle->cachedBlocks);
+    cachedKeys = new vector<int64_t>(*oracle->cachedKeys);
+    cacheIndex = new unordered_map<int64_t, size_t>(*oracle->cacheIndex);
+    nextSlot = new size_t(*oracle->nextSlot);
+    cacheLock = new mutex();
+}
+
+/**
+ * Assignment operator
+ */
+DistanceOracle& DistanceOracle::operator=(DistanceOracle& oracle) {
+    if (&oracle != this) {
+        graph = oracle.graph;
+        *landTable = *oracle.landTable;
+        *waterTable = *oracle.waterTable;
+        *cachedBlocks = *oracle.cachedBlocks;
+        *cachedKeys = *oracle.cachedKeys;
+        *cacheIndex = *oracle.cacheIndex;
+        *nextSlot = *oracle.nextSlot;
+    }
+    return *this;
+}
+
+/**
+ * Destructor
+ */
+DistanceOracle::~DistanceOracle() {
+    delete landTable;
+    delete waterTable;
+    delete cachedBlocks;
+    delete cachedKeys;
+    delete cacheIndex;
+    delete nextSlot;
+    delete cacheLock;
+
+    graph = nullptr;
+    landTable = nullptr;
+    waterTable = nullptr;
+    cachedBlocks = nullptr;
+    cachedKeys = nullptr;
+    cacheIndex = nullptr;
+    nextSlot = nullptr;
+    cacheLock = nullptr;
+}
+
+/**
+ * Gets the number of hops between two regions.
+ *
+ * @param start The ID of the first region.
+ * @param end The ID of the second region.
+ * @param overWaterAllowed A boolean representing if water edges can be crossed.
+ * @return The number of hops, or FAR_AWAY.
+ */
+uint8_t DistanceOracle::getDistance(RegionId start, RegionId end, bool overWaterAllowed) {
+    if (hasTable())
+        return getDistances(start, overWaterAllowed)[end];
+
+    lock_guard<mutex> lock(*cacheLock);
+    return getDistances(start, overWaterAllowed)[end];
+}
+
+/**
+ * Detects if a region can be reached from another in a number of hops or less.
+ */
+bool DistanceOracle::isWithin(RegionId start, RegionId end, int hops, bool overWaterAllowed) {
+    return getDistance(start, end, overWaterAllowed) <= hops;
+}
+
+/**
+ * Gets every region that can be reached from a region in a number of hops or less, including
+ * the region itself.
+ *
+ * @param start The ID of the region to measure from.
+ * @param hops The most hops allowed, usually up to MAX_MOVE_HOPS.
+ * @param overWaterAllowed A boolean representing if water edges can be crossed.
+ * @param regions A pointer to the set to fill. It is cleared first.
+ */
+void DistanceOracle::getRegionsWithin(RegionId start, int hops, bool overWaterAllowed, RegionSet* regions) {
+    const size_t numRegions = graph->getNumRegions();
+    unique_lock<mutex> lock(*cacheLock, defer_lock);
+    if (!hasTable())
+        lock.lock();
+
+    const uint8_t* distances = getDistances(start, overWaterAllowed);
+    regions->reset(numRegions);
+    for (RegionId id = 0; id < numRegions; id++)
+        if (distances[id] <= hops)
+            regions->insert(id);
+}
+
+//PRIVATE
+/**
+ * Gets the distance from a region to every region on the map.
+ *
+ * On large maps the row lives in the cache, so it is only valid until the next call, and the
+ * caller holds the cache lock.
+ *
+ * @param start The ID of the region to measure from.
+ * @param overWaterAllowed A boolean representing if water edges can be crossed.
+ * @return The number of hops to each region, indexed by region ID, or FAR_AWAY.
+ */
+const uint8_t* DistanceOracle::getDistances(RegionId start, bool overWaterAllowed) {
+    const size_t numRegions = graph->getNumRegions();
+
+    if (hasTable())
+        return (overWaterAllowed ? waterTable : landTable)->data() + size_t(start) * numRegions;
+
+    return getCachedBlock(start, overWaterAllowed) + size_t(start % SOURCES_PER_BLOCK) * numRegions;
+}
+
+//PRIVATE
+/**
+ * Fills both all-pairs tables, one block of sources at a time.
+ */
+void DistanceOracle::buildTables() {
+    const size_t numRegions = graph->getNumRegions();
+
+    landTable->assign(numRegions * numRegions, FAR_AWAY);
+    waterTable->assign(numRegions * numRegions, FAR_AWAY);
+
+    for (RegionId first = 0; first < numRegions; first += SOURCES_PER_BLOCK) {
+        searchBlock(first, false, landTable->data() + size_t(first) * numRegions);
+        searchBlock(first, true, waterTable->data() + size_t(first) * numRegions);
+    }
+}
+
+//PRIVATE
+/**
+ * Runs a breadth-first search from up to 64 regions at once. Bit i of a region's word marks
+ * that source i has reached it, so each edge is walked once per level for every source together.
+ *
+ * @param firstSource The ID of the first source. The sources are the next 64 regions.
+ * @param overWaterAllowed A boolean representing if water edges can be crossed.
+ * @param rows The distance rows of the sources, numRegions bytes each, filled with FAR_AWAY.
+ */
+void DistanceOracle::searchBlock(RegionId firstSource, bool overWaterAllowed, uint8_t* rows) {
+    const size_t numRegions = graph->getNumRegions();
+    const size_t numSources = min(SOURCES_PER_BLOCK, numRegions - firstSource);
+
+    vector<uint64_t> seen(numRegions, 0), frontier(numRegions, 0), reached(numRegions, 0);
+    vector<RegionId> current, next;
+
+    for (size_t i = 0; i < numSources; i++) {
+        RegionId source = RegionId(firstSource + i);
+        seen[source] = frontier[source] = uint64_t(1) << i;
+        rows[i * numRegions + source] = 0;
+        current.push_back(source);
+    }
+
+    for (int depth = 1; !current.empty() && depth < FAR_AWAY; depth++) {
+        for (RegionId region : current) {
+            RegionRange neighbours = overWaterAllowed ? graph->getNeighbours(region) : graph->getLandNeighbours(region);
+            for (RegionId neighbour : neighbours) {
+                uint64_t bits = frontier[region] & ~seen[neighbour];
+                if (bits) {
+                    if (!reached[neighbour])
+                        next.push_back(neighbour);
+                    reached[neighbour] |= bits;
+                }
+            }
+        }
+
+        for (RegionId region : current)
+            frontier[region] = 0;
+
+        for (RegionId region : next) {
+            uint64_t bits = reached[region];
+            seen[region] |= bits;
+            frontier[region] = bits;
+            reached[region] = 0;
+
+            for (; bits; bits &= bits - 1)
+                rows[size_t(__builtin_ctzll(bits)) * numRegions + region] = uint8_t(depth);
+        }
+
+        current.swap(next);
+        next.clear();
+    }
+}
+
+//PRIVATE
+/**
+ * Gets the distance rows of the block holding a region, searching it first if it isn't cached.
+ * When the cache is full the oldest block is replaced.
+ *
+ * @param start The ID of a region in the block.
+ * @param overWaterAllowed A boolean representing if water edges can be crossed.
+ * @return The 64 distance rows of the block.
+ */
+const uint8_t* DistanceOracle::getCachedBlock(RegionId start, bool overWaterAllowed) {
+    const size_t numRegions = graph->getNumRegions();
+    const RegionId firstSource = RegionId(start - start % SOURCES_PER_BLOCK);
+    const int64_t key = int64_t(firstSource) * 2 + (overWaterAllowed ? 1 : 0);
+
+    unordered_map<int64_t, size_t>::iterator it = cacheIndex->find(key);
+    if (it != cacheIndex->end())
+        return (*cachedBlocks)[it->second].data();
+
+    const size_t blockBytes = SOURCES_PER_BLOCK * numRegions;
+    const size_t numSlots = max(size_t(1), DISTANCE_CACHE_BYTES / blockBytes);
+
+    size_t slot = *nextSlot;
+    *nextSlot = (slot + 1) % numSlots;
+
+    if (slot < cachedBlocks->size()) {
+        cacheIndex->erase((*cachedKeys)[slot]);
+    } else {
+        cachedBlocks->push_back(vector<uint8_t>());
+        cachedKeys->push_back(-1);
+    }
+
+    vector<uint8_t>& rows = (*cachedBlocks)[slot];
+    rows.assign(blockBytes, FAR_AWAY);
+    searchBlock(firstSource, overWaterAllowed, rows.data());
+
+    (*cachedKeys)[slot] = key;
+    cacheIndex->insert(pair<int64_t, size_t>(key, slot));
+    return rows.data();
+}
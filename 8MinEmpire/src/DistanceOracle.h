@@ -0,0 +1,69 @@
+#ifndef DISTANCE_ORACLE_H
+#define DISTANCE_ORACLE_H
+
+#include "MapTopology.h"
+#include "RegionSet.h"
+
+#include <mutex>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// Distance reported for regions that can't be reached, or are more than 254 hops away.
+const uint8_t FAR_AWAY = 255;
+
+// The most armies a single Move card can move, and so the most hops one card can cover.
+const int MAX_MOVE_HOPS = 6;
+
+// Maps up to this size get a full table of distances, 2 * numRegions^2 bytes.
+const size_t MAX_TABLE_REGIONS = 2048;
+
+// Memory for the distance rows cached on larger maps.
+const size_t DISTANCE_CACHE_BYTES = 64 << 20;
+
+// Number of sources searched together by the bit-parallel BFS, one per bit of a word.
+const size_t SOURCES_PER_BLOCK = 64;
+
+/**
+ * Answers hop distance queries between regions, over land only or with water edges allowed.
+ *
+ * On small maps every distance is computed up front. On larger maps the distances from a block
+ * of 64 regions are computed on demand with one bit-parallel BFS, and the most recent blocks are
+ * cached. Either way a distance row is one byte per region.
+ *
+ * The oracle of a map belongs to its topology (see MapTopology::getDistanceOracle()), so every
+ * game on the map shares it. The tables never change once built, and the cache is locked.
+ */
+class DistanceOracle {
+    const MapTopology* graph;
+    vector<uint8_t>* landTable;
+    vector<uint8_t>* waterTable;
+
+    vector<vector<uint8_t>>* cachedBlocks;
+    vector<int64_t>* cachedKeys;
+    unordered_map<int64_t, size_t>* cacheIndex;
+    size_t* nextSlot;
+    mutex* cacheLock;
+
+public:
+    DistanceOracle(const MapTopology* topology);
+    DistanceOracle(DistanceOracle* oracle);
+    DistanceOracle& operator=(DistanceOracle& oracle);
+    ~DistanceOracle();
+
+    uint8_t getDistance(RegionId start, RegionId end, bool overWaterAllowed);
+    bool isWithin(RegionId start, RegionId end, int hops, bool overWaterAllowed);
+    void getRegionsWithin(RegionId start, int hops, bool overWaterAllowed, RegionSet* regions);
+
+    bool hasTable() { return !landTable->empty(); }
+
+private:
+    const uint8_t* getDistances(RegionId start, bool overWaterAllowed);
+    void buildTables();
+    void searchBlock(RegionId firstSource, bool overWaterAllowed, uint8_t* rows);
+    const uint8_t* getCachedBlock(RegionId start, bool overWaterAllowed);
+};
+
+#endif
@@ -0,0 +1,248 @@
+#include "GameContext.h"
+
+#include <cstring>
+
+/**
+ * Default Constructor
+ *
+ * Starts a game with an empty map, no players, a full deck and 44 coins in the supply. The game
+ * gets a seed of its own (see Random::makeSeed()).
+ */
+GameContext::GameContext():
+    map(new GameMap()),
+    mapFile(new string()),
+    players(new Players()),
+    seed(new uint64_t(Random::makeSeed())),
+    random(new Random(*seed)),
+    hand(new Hand(random)),
+    numPlayers(new int(0)),
+    playerOrder(new vector<string>()),
+    isGameTournament(new bool(false)),
+    nextTurn(new queue<Player*>()),
+    coinSupply(new int(START_COIN_SUPPLY)),
+    recorder(nullptr)
+{
+    colours = new list<string>();
+    colours->push_front("BLUE");
+    colours->push_front("GREEN");
+    colours->push_front("YELLOW");
+    colours->push_front("RED");
+    colours->push_front("WHITE");
+}
+
+/**
+ * Starts a game on an already loaded map. The game shares the map's topology and only gets
+ * its own regions and pieces, so many games can be started on a map that was loaded once.
+ *
+ * @param loadedMap A pointer to the loaded map. The context doesn't own it.
+ */
+GameContext::GameContext(GameMap* loadedMap): GameContext() {
+    map->shareMap(loadedMap);
+}
+
+/**
+ * Destructor
+ */
+GameContext::~GameContext() {
+    for (pair<string, Player*> player: *players) {
+        delete player.second;
+    }
+
+    delete map;
+    delete mapFile;
+    delete players;
+    delete hand;
+    delete seed;
+    delete random;
+    delete numPlayers;
+    delete colours;
+    delete playerOrder;
+    delete isGameTournament;
+    delete nextTurn;
+    delete coinSupply;
+
+    map = nullptr;
+    mapFile = nullptr;
+    players = nullptr;
+    hand = nullptr;
+    seed = nullptr;
+    random = nullptr;
+    numPlayers = nullptr;
+    colours = nullptr;
+    playerOrder = nullptr;
+    isGameTournament = nullptr;
+    nextTurn = nullptr;
+    coinSupply = nullptr;
+    recorder = nullptr;
+}
+
+/**
+ * Adds a player to the game. Players take their turns in the order they were added, and join
+ * the map in that order too, which gives them their PlayerId.
+ *
+ * @param player A pointer to the player. The context takes ownership of it.
+ */
+void GameContext::addPlayer(Player* player) {
+    player->setContext(this);
+    player->getId();
+    players->insert(pair<string, Player*>(player->getName(), player));
+
+    if (player->getName() != ANON)
+        playerOrder->push_back(player->getName());
+}
+
+/**
+ * Replaces the map with an empty one, eg. after a map file failed to load.
+ */
+void GameContext::resetMap() {
+    delete map;
+    map = new GameMap();
+}
+
+/**
+ * Sets the seed of the game and restarts its random number generator. Everything random in the
+ * game, from the order of the deck to the bids of computer players, follows from the seed, so it
+ * should be set before the deck is shuffled.
+ *
+ * @param newSeed The seed.
+ */
+void GameContext::setSeed(uint64_t newSeed) {
+    *seed = newSeed;
+    random->seed(newSeed);
+}
+
+/**
+ * Adds coins to the coin supply.
+ */
+void GameContext::addCoinsToSupply(int amount) {
+    *coinSupply += amount;
+    cout << "[ GAME COINS ] Coin supply now contains " << getCoinSupply() << " coins. " << endl;
+}
+
+/**
+ * Removes coins from the coin supply.
+ */
+void GameContext::removeCoinsFromSupply(int amount) {
+    *coinSupply -= amount;
+    cout << "[ GAME COINS ] Coin supply now contains " << getCoinSupply() << " coins. " << endl;
+}
+
+/**
+ * Hashes the state of the game: the coin supply, the game hand, the deck, the pieces and purse of
+ * every player and every piece on the board. Two games in the same state have the same hash, so
+ * a replayed game can check it is still in step with the game it replays.
+ *
+ * @return The hash (64 bit FNV-1a over the state, and the hash the board keeps of its pieces).
+ */
+uint64_t GameContext::getStateHash() {
+    uint64_t hash = 14695981039346656037ULL;
+    auto add = [&hash](int64_t value) {
+        hash ^= uint64_t(value);
+        hash *= 1099511628211ULL;
+    };
+
+    add(*coinSupply);
+
+    for (int position = 0; position < hand->size(); position++)
+        add(hand->getMarket()->at(position));
+    add(hand->getDeck()->getState()->top);
+
+    for (int i = 0; i < map->getNumPlayers(); i++) {
+        Player* player = map->getPlayer(PlayerId(i));
+
+        add(player->getCoins());
+        add(player->getArmies());
+        add(player->getCities());
+        for (uint8_t count : player->getGoodsCount())
+            add(count);
+    }
+
+    add(map->getArmyMatrix()->getHash());
+    return hash;
+}
+
+/**
+ * Saves the state of the game (see GameState). The game can be put back in this state later
+ * with restore(), eg. to try out a move and take it back. Taking states of the same game over
+ * and over reuses the buffer of the state.
+ *
+ * @param state Set to the state of the game.
+ */
+void GameContext::snapshot(GameState* state) {
+    const int numPlayers = map->getNumPlayers();
+    ArmyMatrix* matrix = map->getArmyMatrix();
+    state->resize(numPlayers, map->getTopology()->getNumRegions());
+    GameStateHeader* header = state->getHeader();
+
+    memcpy(header->random, random->getState(), sizeof(header->random));
+    header->piecesHash = matrix->getHash();
+    header->deck = *hand->getDeck()->getState();
+    header->market = *hand->getMarket();
+    header->coinSupply = int16_t(*coinSupply);
+    header->numSlots = uint8_t(matrix->getNumSlots());
+
+    // Going once around the queue reads it and leaves it as it was.
+    header->numQueued = uint8_t(nextTurn->size());
+    for (int i = 0; i < header->numQueued; i++) {
+        header->turnQueue[i] = nextTurn->front()->getId();
+        nextTurn->push(nextTurn->front());
+        nextTurn->pop();
+    }
+
+    int numCards = 0;
+    for (int i = 0; i < numPlayers; i++) {
+        Player* player = map->getPlayer(PlayerId(i));
+        player->saveState(&header->players[i], header->cards + numCards);
+        player->saveOccupied(state->getOccupied(PlayerId(i)));
+        numCards += header->players[i].numCards;
+    }
+
+    matrix->saveRows(numPlayers, state->getArmies(0), state->getCities(0));
+
+    // The cards past the last hand are cleared, so the same game always gives the same bytes.
+    memset(header->cards + numCards, 0, DECK_SIZE - numCards);
+}
+
+/**
+ * Puts the game back in a state saved by snapshot(). The pieces are copied back row by row into
+ * the army matrix and the regions each player occupies word by word, so going back costs about
+ * the same however far away the state is.
+ *
+ * @param state A state of this game.
+ * @return A boolean representing if the state could be put back. It can't when it was taken
+ * from a game with other players or another map.
+ */
+bool GameContext::restore(GameState* state) {
+    const int numPlayers = map->getNumPlayers();
+    GameStateHeader* header = state->getHeader();
+
+    if (header->numPlayers != numPlayers || header->numRegions != uint32_t(map->getTopology()->getNumRegions())
+            || header->numSlots > numPlayers) {
+        cout << "[ ERROR! ] The state was taken from another game." << endl;
+        return false;
+    }
+
+    memcpy(random->getState(), header->random, sizeof(header->random));
+    *hand->getDeck()->getState() = header->deck;
+    *hand->getMarket() = header->market;
+    *coinSupply = header->coinSupply;
+
+    while (!nextTurn->empty())
+        nextTurn->pop();
+    for (int i = 0; i < header->numQueued; i++)
+        nextTurn->push(map->getPlayer(header->turnQueue[i]));
+
+    // The rows go straight back into the army matrix, and the owners of the regions and
+    // continents are counted again from them in one pass.
+    map->loadPieces(header->numSlots, state->getArmies(0), state->getCities(0), header->piecesHash);
+
+    int numCards = 0;
+    for (int i = 0; i < numPlayers; i++) {
+        Player* player = map->getPlayer(PlayerId(i));
+        player->loadState(header->players[i], header->cards + numCards);
+        player->loadOccupied(state->getOccupied(PlayerId(i)));
+        numCards += header->players[i].numCards;
+    }
+
+    return true;
+}
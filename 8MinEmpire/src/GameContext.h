@@ -0,0 +1,72 @@
+#ifndef GAME_CONTEXT_H
+#define GAME_CONTEXT_H
+
+#include "GameRecorder.h"
+#include "GameState.h"
+#include "Player.h"
+#include "Random.h"
+#include <list>
+#include <queue>
+
+// The coins in the supply at the start of a game, before the players get theirs.
+const int START_COIN_SUPPLY = 44;
+
+/**
+ * Everything that belongs to one game: the map, the players, the game hand and deck, the coin
+ * supply, the turn queue and the random number generator.
+ *
+ * The engine, the players, their strategies and the observers all reach the game through its
+ * context, so games in separate contexts share no state and can run on separate threads.
+ */
+class GameContext {
+    GameMap* map;
+    string* mapFile;
+    Players* players;
+    uint64_t* seed;
+    Random* random;
+    Hand* hand;
+    int* numPlayers;
+    list<string>* colours;
+    vector<string>* playerOrder;
+    bool* isGameTournament;
+    queue<Player*>* nextTurn;
+    int* coinSupply;
+    GameRecorder* recorder;
+
+public:
+    GameContext();
+    GameContext(GameMap* loadedMap);
+    GameContext(GameContext* context) = delete;
+    GameContext& operator=(GameContext& context) = delete;
+    ~GameContext();
+
+    void addPlayer(Player* player);
+    void resetMap();
+    void setIsTournament(bool isTournamentBool) { *isGameTournament = isTournamentBool; }
+    void setNumPlayers(int num) { *numPlayers = num; }
+    void setSeed(uint64_t newSeed);
+    void addCoinsToSupply(int amount);
+    void removeCoinsFromSupply(int amount);
+    void setCoinSupply(int amount) { *coinSupply = amount; }
+    void setMapFile(const string& fileName) { *mapFile = fileName; }
+    void setRecorder(GameRecorder* gameRecorder) { recorder = gameRecorder; }
+    uint64_t getStateHash();
+    void snapshot(GameState* state);
+    bool restore(GameState* state);
+
+    GameMap* getMap() { return map; }
+    const string& getMapFile() { return *mapFile; }
+    Players* getPlayers() { return players; }
+    Hand* getHand() { return hand; }
+    uint64_t getSeed() { return *seed; }
+    Random* getRandom() { return random; }
+    int getNumPlayers() { return *numPlayers; }
+    list<string>* getColours() { return colours; }
+    vector<string>* getPlayerOrder() { return playerOrder; }
+    bool isTournament() { return *isGameTournament; }
+    queue<Player*>* getNextTurnQueue() { return nextTurn; }
+    int getCoinSupply() { return *coinSupply; }
+    GameRecorder* getRecorder() { return recorder; }
+};
+
+#endif
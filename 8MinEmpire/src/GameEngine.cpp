@@ -4,28 +4,62 @@
 #include "GameStartUp.h"
 #include <algorithm>
 
-#define NUM_ROUNDS 30
-
 /**
  * Default Constructor
+ *
+ * The engine plays a new game of its own, and deletes it when it is destroyed.
+ */
+GameEngine::GameEngine():
+    context(new GameContext()),
+    ownsContext(new bool(true)) {}
+
+/**
+ * The engine plays a new game of its own on an already loaded map, and deletes the game when
+ * it is destroyed.
+ *
+ * @param loadedMap A pointer to the loaded map, or nullptr to start on an empty map. The engine
+ * doesn't own it.
+ */
+GameEngine::GameEngine(GameMap* loadedMap):
+    context(loadedMap ? new GameContext(loadedMap) : new GameContext()),
+    ownsContext(new bool(true)) {}
+
+/**
+ * Initializes a GameEngine object playing an existing game.
+ *
+ * @param gameContext A pointer to the context of the game. The engine doesn't own it.
  */
-GameEngine::GameEngine() {}
+GameEngine::GameEngine(GameContext* gameContext):
+    context(gameContext),
+    ownsContext(new bool(false)) {}
 
 /**
  * Destructor
  */
-GameEngine::~GameEngine() {}
+GameEngine::~GameEngine() {
+    if (*ownsContext)
+        delete context;
+
+    delete ownsContext;
+
+    context = nullptr;
+    ownsContext = nullptr;
+}
 
 /**
  * Default Constructor
  */
 MainGameEngine::MainGameEngine(): GameEngine() {}
 
+/**
+ * Initializes a MainGameEngine object playing an existing game.
+ */
+MainGameEngine::MainGameEngine(GameContext* gameContext): GameEngine(gameContext) {}
+
 /**
  * Destructor
  */
 MainGameEngine::~MainGameEngine() {
-    delete StartUpGameEngine::instance();
     currentPlayer = nullptr;
     currentCard = nullptr;
 }
@@ -41,13 +75,16 @@ void MainGameEngine::runGame() {
         addNewCardToBackOfHand();
         askToChangePlayerStrategy();
     }
+
+    if (getContext()->getRecorder())
+        getContext()->getRecorder()->recordEndOfGame();
 }
 
 /**
  * Gets the next player in the nextTurn queue.
  */
 void MainGameEngine::getNextPlayer() {
-    queue<Player*>* nextTurn = StartUpGameEngine::instance()->getNextTurnQueue();
+    queue<Player*>* nextTurn = getContext()->getNextTurnQueue();
 
     currentPlayer = nextTurn->front();
     nextTurn->pop();
@@ -67,10 +104,10 @@ void MainGameEngine::chooseCardFromHand() {
     // Add the difference to the game coin supply.
 
     int startCoins = currentPlayer->getCoins();
-    currentCard = StartUpGameEngine::instance()->getHand()->exchange(currentPlayer);
+    currentCard = getContext()->getHand()->exchange(currentPlayer);
     int endCoins = currentPlayer->getCoins();
 
-    StartUpGameEngine::instance()->addCoinsToSupply(startCoins - endCoins);
+    getContext()->addCoinsToSupply(startCoins - endCoins);
 }
 
 /**
@@ -78,34 +115,17 @@ void MainGameEngine::chooseCardFromHand() {
  *
  */
 void MainGameEngine::performCardAction() {
-    Players* players = StartUpGameEngine::instance()->getPlayers();
-
-    const string action = currentCard->getAction();
+    Players* players = getContext()->getPlayers();
 
     string answer;
-    cout << "[ GAME ] Ignore card action < " << action << " > (y/n)?" << endl;
+    cout << "[ GAME ] Ignore card action < " << currentCard->getAction() << " > (y/n)?" << endl;
     cout << "[ GAME ] > ";
     getline(cin, answer);
 
     if (answer == "y" || answer == "Y") {
         currentPlayer->Ignore();
     } else {
-        if(action.find("OR") != size_t(-1) || action.find("AND") != size_t(-1))
-            currentPlayer->AndOrAction(action, players);
-        else if (action.find("Add") != size_t(-1))
-            currentPlayer->PlaceNewArmies(action, players);
-        else if (action.find("Destroy") != size_t(-1))
-            currentPlayer->DestroyArmy(players);
-        else if (action.find("Build") != size_t(-1))
-            currentPlayer->BuildCity();
-        else if (action.find("Move") != size_t(-1)) {
-            if (action.find("water") != size_t(-1))
-                currentPlayer->MoveOverWater(action, players);
-            else
-                currentPlayer->MoveOverLand(action, players);
-        }
-        else
-            cout << "[ ERROR! ] Invalid action." << endl;
+        currentPlayer->performCardAction(currentCard->getCardAction(), players);
     }
 
     // Notify observers of changes
@@ -117,7 +137,10 @@ void MainGameEngine::performCardAction() {
  * effectively shifting each card left one slot up until the empty slot is filled.
  */
 void MainGameEngine::addNewCardToBackOfHand() {
-    StartUpGameEngine::instance()->getHand()->drawCardFromDeck();
+    getContext()->getHand()->drawCardFromDeck();
+
+    if (getContext()->getRecorder())
+        getContext()->getRecorder()->recordEndOfTurn(getContext());
 }
 
 /**
@@ -131,7 +154,7 @@ bool MainGameEngine::continueGame() {
     int maxNumCards = getMaxNumberOfCards();
 
     Players::iterator it;
-    Players* players = StartUpGameEngine::instance()->getPlayers();
+    Players* players = getContext()->getPlayers();
 
     for(it = players->begin(); it != players->end(); ++it) {
         if (it->first != ANON && it->second->getHand()->size() < size_t(maxNumCards))
@@ -165,7 +188,7 @@ void MainGameEngine::declareWinner() {
     Player* winner = new Player();
     int highestScore = 0;
 
-    Players* players = StartUpGameEngine::instance()->getPlayers();
+    Players* players = getContext()->getPlayers();
 
     map<Player*, int> scores;
 
@@ -182,8 +205,8 @@ void MainGameEngine::declareWinner() {
 
     if (highestScore > 0) {
         for(map<Player*, int>::iterator it = scores.begin(); it != scores.end(); it++) {
-            int winnerArmies = 14 - winner->getArmies();
-            int otherArmies = 14 - it->first->getArmies();
+            int winnerArmies = START_ARMIES - winner->getArmies();
+            int otherArmies = START_ARMIES - it->first->getArmies();
 
             if (it->second == highestScore && it->first != winner) {
                 cout << "[ GAME ] " << it->first->getName() << " has the same score as " << winner->getName() << "." << endl;
@@ -255,7 +278,7 @@ void MainGameEngine::declareWinner() {
  * @return The number of cards in each player's hand required to end the game.
  */
 int MainGameEngine::getMaxNumberOfCards() {
-    int numPlayers = StartUpGameEngine::instance()->getNumPlayers();
+    int numPlayers = getContext()->getNumPlayers();
 
     if (numPlayers == 2)
         return 13;
@@ -325,11 +348,15 @@ void MainGameEngine::askToChangePlayerStrategy() {
  */
 TournamentGameEngine::TournamentGameEngine(): GameEngine() {}
 
+/**
+ * Initializes a TournamentGameEngine object playing an existing game.
+ */
+TournamentGameEngine::TournamentGameEngine(GameContext* gameContext): GameEngine(gameContext) {}
+
 /**
  * Destructor
  */
 TournamentGameEngine::~TournamentGameEngine() {
-    delete StartUpGameEngine::instance();
     currentPlayer = nullptr;
     currentCard = nullptr;
 }
@@ -347,6 +374,9 @@ void TournamentGameEngine::runGame() {
         Notify();
     }
 
+    if (getContext()->getRecorder())
+        getContext()->getRecorder()->recordEndOfGame();
+
     declareWinner();
 }
 
@@ -354,7 +384,7 @@ void TournamentGameEngine::runGame() {
  * Gets the next player in the nextTurn queue.
  */
 void TournamentGameEngine::getNextPlayer() {
-    queue<Player*>* nextTurn = StartUpGameEngine::instance()->getNextTurnQueue();
+    queue<Player*>* nextTurn = getContext()->getNextTurnQueue();
 
     currentPlayer = nextTurn->front();
     nextTurn->pop();
@@ -375,10 +405,10 @@ void TournamentGameEngine::chooseCardFromHand() {
     // Add the difference to the game coin supply.
 
     int startCoins = currentPlayer->getCoins();
-    currentCard = StartUpGameEngine::instance()->getHand()->exchange(currentPlayer);
+    currentCard = getContext()->getHand()->exchange(currentPlayer);
     int endCoins = currentPlayer->getCoins();
 
-    StartUpGameEngine::instance()->addCoinsToSupply(startCoins - endCoins);
+    getContext()->addCoinsToSupply(startCoins - endCoins);
 }
 
 /**
@@ -386,26 +416,9 @@ void TournamentGameEngine::chooseCardFromHand() {
  *
  */
 void TournamentGameEngine::performCardAction() {
-    Players* players = StartUpGameEngine::instance()->getPlayers();
-
-    const string action = currentCard->getAction();
-
-    if(action.find("OR") != size_t(-1) || action.find("AND") != size_t(-1))
-        currentPlayer->AndOrAction(action, players);
-    else if (action.find("Add") != size_t(-1))
-        currentPlayer->PlaceNewArmies(action, players);
-    else if (action.find("Destroy") != size_t(-1))
-        currentPlayer->DestroyArmy(players);
-    else if (action.find("Build") != size_t(-1))
-        currentPlayer->BuildCity();
-    else if (action.find("Move") != size_t(-1)) {
-        if (action.find("water") != size_t(-1))
-            currentPlayer->MoveOverWater(action, players);
-        else
-            currentPlayer->MoveOverLand(action, players);
-    }
-    else
-        cout << "[ ERROR! ] Invalid action." << endl;
+    Players* players = getContext()->getPlayers();
+
+    currentPlayer->performCardAction(currentCard->getCardAction(), players);
 }
 
 /**
@@ -413,7 +426,10 @@ void TournamentGameEngine::performCardAction() {
  * effectively shifting each card left one slot up until the empty slot is filled.
  */
 void TournamentGameEngine::addNewCardToBackOfHand() {
-    StartUpGameEngine::instance()->getHand()->drawCardFromDeck();
+    getContext()->getHand()->drawCardFromDeck();
+
+    if (getContext()->getRecorder())
+        getContext()->getRecorder()->recordEndOfTurn(getContext());
 }
 
 /**
@@ -436,7 +452,7 @@ void TournamentGameEngine::declareWinner() {
     Player* winner = new Player();
     int highestScore = 0;
 
-    Players* players = StartUpGameEngine::instance()->getPlayers();
+    Players* players = getContext()->getPlayers();
 
     map<Player*, int> scores;
 
@@ -518,13 +534,14 @@ void TournamentGameEngine::declareWinner() {
 /**
  * Creates a GameEngine object.
  *
- * @return A TournamentGameEngine (tournament mode) if InitGameEngine isTournament boolean is true,
+ * @param context A pointer to the context of a game that has been started. The engine doesn't own it.
+ * @return A TournamentGameEngine (tournament mode) if the game is a tournament,
  * else return a MainGameEngine (normal mode)
  */
-GameEngine* GameEngineFactory::create() {
-    if (InitGameEngine::instance()->isTournament()) {
-        return new TournamentGameEngine();
+GameEngine* GameEngineFactory::create(GameContext* context) {
+    if (context->isTournament()) {
+        return new TournamentGameEngine(context);
     } else {
-        return new MainGameEngine();
+        return new MainGameEngine(context);
     }
 }
\ No newline at end of file
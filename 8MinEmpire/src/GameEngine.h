@@ -5,24 +5,35 @@
 #include "Player.h"
 #include "GameStartUp.h"
 
+// Rounds played by a tournament game.
+const int NUM_ROUNDS = 30;
+
 class GameEngine: public Subject {
+    GameContext* context;
+    bool* ownsContext;
 
 public:
     GameEngine();
+    GameEngine(GameMap* loadedMap);
+    GameEngine(GameContext* gameContext);
+    GameEngine(GameEngine* engine) = delete;
+    GameEngine& operator=(GameEngine& engine) = delete;
     ~GameEngine();
 
-    void startGame() { StartUpGameEngine::instance()->startGame(); }
+    GameContext* getContext() { return context; }
+    void startGame() { StartUpGameEngine(context).startGame(); }
     virtual void runGame() = 0;
     virtual Player* getCurrentPlayer() = 0;
-    virtual Card* getCurrentCard() = 0;
+    virtual const CardInfo* getCurrentCard() = 0;
 };
 
 class MainGameEngine : public GameEngine {
     Player* currentPlayer;
-    Card* currentCard;
+    const CardInfo* currentCard;
 
 public:
     MainGameEngine();
+    MainGameEngine(GameContext* gameContext);
     ~MainGameEngine();
 
     void runGame();
@@ -37,27 +48,28 @@ public:
     void askToChangePlayerStrategy();
 
     Player* getCurrentPlayer() { return currentPlayer; }
-    Card* getCurrentCard() { return currentCard; }
+    const CardInfo* getCurrentCard() { return currentCard; }
 
     //Setters
-    void setCurrentCard(Card* card) { currentCard = card; }
+    void setCurrentCard(const CardInfo* card) { currentCard = card; }
 };
 
 class TournamentGameEngine: public GameEngine {
     Player* currentPlayer;
-    Card* currentCard;
+    const CardInfo* currentCard;
 
 public:
     TournamentGameEngine();
+    TournamentGameEngine(GameContext* gameContext);
     ~TournamentGameEngine();
 
     void runGame();
 
     Player* getCurrentPlayer() { return currentPlayer; }
-    Card* getCurrentCard() { return currentCard; }
+    const CardInfo* getCurrentCard() { return currentCard; }
 
     //Setters
-    void setCurrentCard(Card* card) { currentCard = card; }
+    void setCurrentCard(const CardInfo* card) { currentCard = card; }
 private:
     void getNextPlayer();
     void chooseCardFromHand();
@@ -70,7 +82,7 @@ private:
 
 class GameEngineFactory {
 public:
-    static GameEngine* create();
+    static GameEngine* create(GameContext* context);
 };
 
 #endif
\ No newline at end of file
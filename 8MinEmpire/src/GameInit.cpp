@@ -5,45 +5,34 @@
 #include "MapLoader.h"
 #include "util/MapUtil.h"
 
-InitGameEngine* InitGameEngine::initInstance = 0;
+/**
+ * Initializes an InitGameEngine object.
+ *
+ * @param gameContext A pointer to the context of the game to set up. The engine doesn't own it.
+ */
+InitGameEngine::InitGameEngine(GameContext* gameContext): context(gameContext) {}
 
 /**
- * Default Constructor
+ * Copy Constructor
  */
-InitGameEngine::InitGameEngine():
-    players(new Players()), hand(new Hand()),
-    numPlayers(new int()), playerOrder(new vector<string>()),
-    isGameTournament(new bool(false)) {
-        colours = new list<string>();
-        colours->push_front("BLUE");
-        colours->push_front("GREEN");
-        colours->push_front("YELLOW");
-        colours->push_front("RED");
-        colours->push_front("WHITE");
-    }
+InitGameEngine::InitGameEngine(InitGameEngine* initEngine) {
+    context = initEngine->context;
+}
+
+/**
+ * Assignment operator
+ */
+InitGameEngine& InitGameEngine::operator=(InitGameEngine& initEngine) {
+    if (&initEngine != this)
+        context = initEngine.context;
+    return *this;
+}
 
 /**
  * Destructor
  */
 InitGameEngine::~InitGameEngine() {
-    for (pair<string, Player*> player: *players) {
-        delete player.second;
-    }
-
-    delete players;
-    delete hand;
-    delete numPlayers;
-    delete colours;
-    delete playerOrder;
-    delete isGameTournament;
-
-    initInstance = nullptr;
-    players = nullptr;
-    hand = nullptr;
-    numPlayers = nullptr;
-    colours = nullptr;
-    playerOrder = nullptr;
-    isGameTournament = nullptr;
+    context = nullptr;
 }
 
 /**
@@ -51,7 +40,7 @@ InitGameEngine::~InitGameEngine() {
  */
 void InitGameEngine::initGame() {
     // Only initialize the game once.
-    if (players->size() == 0 && GameMap::instance()->getVertices()->size() == 0) {
+    if (context->getPlayers()->size() == 0) {
 
         cout << "\n---------------------------------------------------------------------------" << endl;
         cout << "---------------------------------------------------------------------------" << endl;
@@ -61,26 +50,15 @@ void InitGameEngine::initGame() {
         cout << "---------------------------------------------------------------------------\n" << endl;
 
         askGameMode();
-        initializeMap();
+
+        // A context can start out on a map that was already loaded.
+        if (context->getMap()->getVertices()->empty())
+            initializeMap();
+
         selectNumPlayers();
         createPlayers();
-        hand->fill();
-    }
-}
-
-/**
- * Returns a singleton instance of a StartUpGameEngine object.
- */
-InitGameEngine* InitGameEngine::instance() {
-    if (!initInstance) {
-        initInstance = new InitGameEngine();
+        context->getHand()->fill();
     }
-    return initInstance;
-}
-
-void InitGameEngine::setIsTournament(bool isGameTournamentBool) {
-    delete isGameTournament;
-    isGameTournament = new bool(isGameTournamentBool);
 }
 
 //PRIVATE
@@ -104,13 +82,12 @@ void InitGameEngine::askGameMode() {
 
             if (a == 1) {
                 cout << "[ INIT ] You've chosen Normal Mode." << endl;
-                isGameTournament = new bool(false);
+                context->setIsTournament(false);
                 break;
             }
             if (a == 2) {
                 cout << "[ INIT ] You've chosen Tournament Mode." << endl;
-                delete isGameTournament;
-                isGameTournament = new bool(true);
+                context->setIsTournament(true);
                 break;
             }
 
@@ -138,18 +115,20 @@ void InitGameEngine::initializeMap() {
         string mapName = selectMap(mapFiles);
         MapLoader loader(mapName);
 
-        bool isMapFileValid = loader.generateMap();
+        bool isMapFileValid = loader.generateMap(context->getMap());
 
         // Map file is invalid and returned no map object.
         if (isMapFileValid == false)
             continue;
 
         // Map file is valid and created a valid map object.
-        if(isConnectedMap() && validateContinents() && validateEdges())
+        if(validateMap(context->getMap())) {
+            context->setMapFile(mapName);
             break;
+        }
 
         // Map file is valid but created a faulty map object.
-        delete GameMap::instance();
+        context->resetMap();
     }
 
     delete mapFiles;
@@ -164,7 +143,7 @@ void InitGameEngine::initializeMap() {
 void InitGameEngine::selectNumPlayers() {
     int maxPlayers = 5;
 
-    if (*isGameTournament)
+    if (context->isTournament())
         maxPlayers = 4;
 
     const int MAX_NUM_PLAYERS = maxPlayers;
@@ -183,7 +162,7 @@ void InitGameEngine::selectNumPlayers() {
 
             if (num >= MIN_NUM_PLAYERS && num <= MAX_NUM_PLAYERS) {
                 cout << "[ INIT ] You entered " << num << endl;
-                *numPlayers = num;
+                context->setNumPlayers(num);
                 break;
             }
 
@@ -200,14 +179,10 @@ void InitGameEngine::selectNumPlayers() {
  * Populates the Players object (typedef unordered_map<string, Player*>) with new Player objects.
  */
 void InitGameEngine::createPlayers(){
-    vector<Player*> playerList;
-    cout << "[ INIT ] Creating " << *numPlayers << " players." << endl;
+    cout << "[ INIT ] Creating " << context->getNumPlayers() << " players." << endl;
 
-    for (int i = 0; i < *numPlayers; i++) {
-        Player* player = createPlayer();
-        players->insert(pair<string, Player*>(player->getName(), player));
-        playerOrder->push_back(player->getName());
-    }
+    for (int i = 0; i < context->getNumPlayers(); i++)
+        context->addPlayer(createPlayer());
 }
 
 //PRIVATE
@@ -248,9 +223,11 @@ vector<string>* InitGameEngine::getMapFiles() {
 
         while ((ent = readdir (dir)) != NULL) {
 
-            //Exclude . and .. from map files
-            if(string(ent->d_name).compare(".") == string(ent->d_name).compare(".."))
-                files->push_back(string(ent->d_name));
+            string file = string(ent->d_name);
+
+            //Only list text map files. Compiled maps are picked up by MapLoader on their own.
+            if(file.size() > 4 && file.compare(file.size() - 4, 4, ".map") == 0)
+                files->push_back(file);
         }
 
         closedir (dir);
@@ -298,6 +275,7 @@ string InitGameEngine::selectMap(vector<string>* maps) {
  * Prints the available colours that a player can choose from.
  */
 void InitGameEngine::printColours() {
+    list<string>* colours = context->getColours();
     cout << "[ INIT ]  AVAILABLE COLOURS\n" << endl;
     int i = 1;
     for(list<string>::iterator it = colours->begin(); it != colours->end(); ++it) {
@@ -312,6 +290,7 @@ void InitGameEngine::printColours() {
  * Prompts the user to choose among available colours.
  */
 string InitGameEngine::chooseColour() {
+    list<string>* colours = context->getColours();
     string colourPos;
     string colour;
     int pos;
@@ -364,7 +343,7 @@ string InitGameEngine::chooseName() {
         getline(cin, name);
 
         if(name != "") {
-            if(players->find(name) != players->end())
+            if(context->getPlayers()->find(name) != context->getPlayers()->end())
                 cout << "\n[ ERROR! ] That name is already taken. Please choose another.\n" << endl;
             else
                 break;
@@ -398,7 +377,7 @@ Strategy* InitGameEngine::chooseStrategy() {
         try{
             int choice = stoi(strategyChoice);
 
-            if (choice == 1 && !*isGameTournament)
+            if (choice == 1 && !context->isTournament())
                 return new HumanStrategy();
             if (choice == 2)
                 return new GreedyStrategy();
@@ -406,7 +385,7 @@ Strategy* InitGameEngine::chooseStrategy() {
                 return new ModerateStrategy();
 
             cout << "\n[ ERROR! ] Invalid choice.";
-            if (*isGameTournament)
+            if (context->isTournament())
                 cout << " Please choose either Greedy or Moderate Strategies.";
             cout << endl << endl;
         } catch (invalid_argument &e) {
@@ -1,35 +1,32 @@
 #ifndef GAME_INIT_ENGINE_H
 #define GAME_INIT_ENGINE_H
 
-#include "Player.h"
-#include <list>
+#include "GameContext.h"
 
+/**
+ * Asks the game mode, the map and the players of a game, and fills its GameContext with them.
+ */
 class InitGameEngine {
-    static InitGameEngine* initInstance;
-    Players* players;
-    Hand* hand;
-    int* numPlayers;
-    list<string>* colours;
-    vector<string>* playerOrder;
-    bool* isGameTournament;
+    GameContext* context;
 
 public:
+    InitGameEngine(GameContext* gameContext);
+    InitGameEngine(InitGameEngine* initEngine);
+    InitGameEngine& operator=(InitGameEngine& initEngine);
     ~InitGameEngine();
 
-    static InitGameEngine* instance();
-
     void initGame();
-    void setIsTournament(bool isTournamentBool);
-    bool isTournament() { return *isGameTournament; }
+    void setIsTournament(bool isTournamentBool) { context->setIsTournament(isTournamentBool); }
+    bool isTournament() { return context->isTournament(); }
 
-    Players* getPlayers() { return players;}
-    Hand* getHand() { return hand;}
-    int getNumPlayers() { return *numPlayers; }
-    list<string>* getColours() { return colours; }
-    vector<string>* getPlayerOrder() { return playerOrder; }
+    GameContext* getContext() { return context; }
+    Players* getPlayers() { return context->getPlayers(); }
+    Hand* getHand() { return context->getHand(); }
+    int getNumPlayers() { return context->getNumPlayers(); }
+    list<string>* getColours() { return context->getColours(); }
+    vector<string>* getPlayerOrder() { return context->getPlayerOrder(); }
 
 private:
-    InitGameEngine();
     void askGameMode();
     void initializeMap();
     void selectNumPlayers();
@@ -69,12 +69,13 @@ PhaseObserver::~PhaseObserver() {
  */
 void PhaseObserver::Update() {
     Player* currentPlayer = gameEngine->getCurrentPlayer();
-    Card* currentCard = gameEngine->getCurrentCard();
+    const CardInfo* currentCard = gameEngine->getCurrentCard();
+    Hand* hand = gameEngine->getContext()->getHand();
 
     cout << "\n---------------------------------------------------------------------------" << endl;
     cout << "{ " << currentPlayer->getName() << " } Has chosen card [ " << currentCard->getGood() << " : \""
-         << currentCard->getAction() << "\" ]" << endl << "\tat position " << currentCard->getPosition()
-         << " which costs " << currentCard->getCost() << " coins." << endl;
+         << currentCard->getAction() << "\" ]" << endl << "\tat position " << hand->getLastPosition()
+         << " which costs " << hand->getLastCost() << " coins." << endl;
     cout << "---------------------------------------------------------------------------\n" << endl;
 }
 
@@ -100,13 +101,13 @@ StatsObserver::~StatsObserver() {
  * and the game exits.
  */
 void StatsObserver::Update() {
-    GameMap::instance()->printMap();
+    gameEngine->getContext()->getMap()->printMap();
     printMapRegions();
     printVictoryPoints();
     printGoodsFromCards();
 
     MainGameEngine* mainEngine = dynamic_cast<MainGameEngine*>(gameEngine);
-    if (!InitGameEngine::instance()->isTournament() && !mainEngine->continueGame()) {
+    if (!gameEngine->getContext()->isTournament() && !mainEngine->continueGame()) {
         mainEngine->declareWinner();
         exit(EXIT_SUCCESS);
     }
@@ -116,27 +117,23 @@ void StatsObserver::Update() {
 * Prints out the occupied regions of the game inidicating which player currently owns each region and each continent.
  */
 void StatsObserver::printMapRegions() {
-    vector<set<string>* > continents = GameMap::instance()->getContinents();
-
-    vector<set<string>* >::iterator it;
+    GameMap* map = gameEngine->getContext()->getMap();
+    MapTopology* graph = map->getTopology();
 
     cout << "---------------------------------------------------------------------------" << endl;
 
-    for (it = continents.begin(); it != continents.end(); ++it) {
-        set<string>* continent = (*it);
-
-        string continentName = GameMap::instance()->getVertices()->find(*continent->begin())->second->getContinent();
-        string owner = GameMap::instance()->getContinentOwner(continent);
+    for (ContinentId continent = 0; continent < graph->getNumContinents(); continent++) {
+        string continentName = graph->getContinentName(continent);
+        Player* ownerPlayer = map->getPlayer(map->getContinentOwner(continent));
+        string owner = ownerPlayer ? ownerPlayer->getName() : "";
 
         printf("%13s %s\n\n", continentName.c_str(), ("{{ " + owner + " }}").c_str());
 
-        for(string vertex: *continent) {
-            if (GameMap::instance()->getVertices()->find(vertex) != GameMap::instance()->getVertices()->end()) {
-                Vertex* region = GameMap::instance()->getVertices()->find(vertex)->second;
+        for(RegionId id : graph->getContinentRegions(continent)) {
+            Vertex* region = map->getVertex(id);
 
-                if (region->getArmies()->size() > 0 || region->getCities()->size() > 0)
-                    region->print();
-            }
+            if (region->hasPieces())
+                region->print();
         }
         cout << "---------------------------------------------------------------------------" << endl;
     }
@@ -147,7 +144,12 @@ void StatsObserver::printMapRegions() {
  * Prints out the current victory points for each player from owned regions, owned continents and card goods.
  */
 void StatsObserver::printVictoryPoints() {
-    Players* players = StartUpGameEngine::instance()->getPlayers();
+    Players* players = gameEngine->getContext()->getPlayers();
+    GameMap* map = gameEngine->getContext()->getMap();
+
+    // One pass over the whole board gives the region count of every player.
+    ArmyMatrix* pieces = map->getArmyMatrix();
+    vector<int> ownedRegions = pieces->countOwnedRegions();
 
     string divider = "========================================================================";
 
@@ -173,9 +175,10 @@ void StatsObserver::printVictoryPoints() {
 
         Player* pl = it->second;
 
-        int vpRegions = pl->getRegions()->size();
-        int vpContinents = pl->getOwnedContinents()->size();
-        int vpGoods = pl->getVPFromGoods(pl->getGoodsCount());
+        PlayerId playerId = pl->getId();
+        int vpRegions = playerId < ownedRegions.size() ? ownedRegions[playerId] : 0;
+        int vpContinents = map->getNumContinentsOwnedBy(playerId);
+        int vpGoods = getBestGoodsPoints(pl->getGoodsCount());
 
         int totalVP = vpRegions + vpContinents + vpGoods;
 
@@ -238,7 +241,7 @@ void StatsObserver::printVictoryPoints() {
  */
 void StatsObserver::printGoodsFromCards() {
 
-    Players* players = StartUpGameEngine::instance()->getPlayers();
+    Players* players = gameEngine->getContext()->getPlayers();
 
     string divider = "========================================================================";
 
@@ -266,34 +269,18 @@ void StatsObserver::printGoodsFromCards() {
         char stonebuff[50];
         char wildbuff[50];
 
-        snprintf(woodbuff, sizeof(woodbuff), "%-17s%-10d", WOOD.c_str(), 0);
-        snprintf(ironbuff, sizeof(ironbuff), "%-17s%-10d", IRON.c_str(), 0);
-        snprintf(carrotbuff, sizeof(carrotbuff), "%-17s%-10d", CARROT.c_str(), 0);
-        snprintf(gembuff, sizeof(gembuff), "%-17s%-10d", GEM.c_str(), 0);
-        snprintf(stonebuff, sizeof(stonebuff), "%-17s%-10d", STONE.c_str(), 0);
-        snprintf(wildbuff, sizeof(wildbuff), "%-17s%-10d", WILD.c_str(), 0);
-
         Player* pl = it->second;
 
         snprintf(namebuff, sizeof(namebuff), "\t%-15s    ",("{ " + pl->getName() + " }").c_str());
 
-        unordered_map<string, int> * goodsCount = pl->getGoodsCount();
-        unordered_map<string, int>::iterator good;
-
-        for (good = goodsCount->begin(); good != goodsCount->end(); ++good) {
-            if (good->first == WOOD)
-                snprintf(woodbuff, sizeof(woodbuff), "%-17s%-10d", WOOD.c_str(), good->second);
-            else if (good->first == IRON)
-                snprintf(ironbuff, sizeof(ironbuff), "%-17s%-10d", IRON.c_str(), good->second);
-            else if (good->first == CARROT)
-                snprintf(carrotbuff, sizeof(carrotbuff), "%-17s%-10d", CARROT.c_str(), good->second);
-            else if (good->first == GEM)
-                snprintf(gembuff, sizeof(gembuff), "%-17s%-10d", GEM.c_str(), good->second);
-            else if (good->first == STONE)
-                snprintf(stonebuff, sizeof(stonebuff), "%-17s%-10d", STONE.c_str(), good->second);
-            else if (good->first == WILD)
-                snprintf(wildbuff, sizeof(wildbuff), "%-17s%-10d", WILD.c_str(), good->second);
-        }
+        const GoodsCount& goodsCount = pl->getGoodsCount();
+
+        snprintf(woodbuff, sizeof(woodbuff), "%-17s%-10d", WOOD.c_str(), goodsCount[GOOD_WOOD]);
+        snprintf(ironbuff, sizeof(ironbuff), "%-17s%-10d", IRON.c_str(), goodsCount[GOOD_IRON]);
+        snprintf(carrotbuff, sizeof(carrotbuff), "%-17s%-10d", CARROT.c_str(), goodsCount[GOOD_CARROT]);
+        snprintf(gembuff, sizeof(gembuff), "%-17s%-10d", GEM.c_str(), goodsCount[GOOD_GEM]);
+        snprintf(stonebuff, sizeof(stonebuff), "%-17s%-10d", STONE.c_str(), goodsCount[GOOD_STONE]);
+        snprintf(wildbuff, sizeof(wildbuff), "%-17s%-10d", WILD.c_str(), goodsCount[GOOD_WILD]);
 
         nameline += namebuff;
         carrotline += carrotbuff;
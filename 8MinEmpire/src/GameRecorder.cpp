@@ -0,0 +1,986 @@
+#include "GameRecorder.h"
+#include "GameContext.h"
+#include "GameStartUp.h"
+#include "MapLoader.h"
+#include "PlayerStrategies.h"
+#include "util/MapUtil.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+/**
+ * Appends an unsigned number 7 bits at a time, lowest bits first. Every byte but the last has its
+ * top bit set, so the counts and regions of a game mostly take one byte.
+ */
+static void appendNumber(vector<uint8_t>* bytes, uint64_t value) {
+    while (value >= 0x80) {
+        bytes->push_back(uint8_t(value) | 0x80);
+        value >>= 7;
+    }
+    bytes->push_back(uint8_t(value));
+}
+
+/**
+ * Reads a number written by appendNumber() and moves the position past it.
+ *
+ * @return A boolean representing if a whole number was read before the end of the bytes.
+ */
+static bool parseNumber(const uint8_t* bytes, size_t size, size_t* position, uint64_t* value) {
+    *value = 0;
+
+    for (int shift = 0; shift < 64 && *position < size; shift += 7) {
+        uint8_t byte = bytes[(*position)++];
+        *value |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * Default Constructor
+ *
+ * The recorder starts with an empty record.
+ */
+GameRecorder::GameRecorder(): log(new vector<uint8_t>()), isRecording(new bool(false)) {}
+
+/**
+ * Copy Constructor
+ */
+GameRecorder::GameRecorder(GameRecorder* recorder) {
+    log = new vector<uint8_t>(*recorder->log);
+    isRecording = new bool(*recorder->isRecording);
+}
+
+/**
+ * Assignment operator
+ */
+GameRecorder& GameRecorder::operator=(GameRecorder& recorder) {
+    if (&recorder != this) {
+        *log = *recorder.log;
+        *isRecording = *recorder.isRecording;
+    }
+    return *this;
+}
+
+/**
+ * Destructor
+ */
+GameRecorder::~GameRecorder() {
+    delete log;
+    delete isRecording;
+
+    log = nullptr;
+    isRecording = nullptr;
+}
+
+/**
+ * Starts a new record with what the game was set up with: the seed, the map file, the players in
+ * the order they were created and the start region. Must be called once the start region is set
+ * and before the starting armies are placed.
+ *
+ * @param context A pointer to the context of the game.
+ */
+void GameRecorder::recordSetup(GameContext* context) {
+    log->clear();
+    *isRecording = false;
+
+    for (char magic : RECORD_MAGIC)
+        writeByte(uint8_t(magic));
+    writeByte(RECORD_VERSION);
+
+    for (int i = 0; i < 8; i++)
+        writeByte(uint8_t(context->getSeed() >> (8 * i)));
+
+    writeString(context->getMapFile());
+    writeNumber(context->getMap()->getNumRegions());
+
+    writeByte(uint8_t(context->getPlayerOrder()->size()));
+    for (const string& name : *context->getPlayerOrder()) {
+        Player* player = context->getPlayers()->at(name);
+
+        writeString(player->getName());
+        writeString(player->getColour());
+        writeString(player->getStrategy() ? player->getStrategy()->getType() : HUMAN);
+    }
+
+    writeString(context->getMap()->getStartVertex()->getKey());
+}
+
+/**
+ * Records the bid of a player.
+ */
+void GameRecorder::recordBid(Player* player, int amount) {
+    writeByte(RECORD_BID);
+    writeByte(player->getId());
+    writeNumber(uint64_t(amount));
+}
+
+/**
+ * Records the player who won the bid and paid their bid.
+ */
+void GameRecorder::recordBidWinner(Player* winner) {
+    writeByte(RECORD_BID_WINNER);
+    writeByte(winner->getId());
+}
+
+/**
+ * Records the player the winner of the bid chose to go first.
+ */
+void GameRecorder::recordFirstPlayer(Player* firstPlayer) {
+    writeByte(RECORD_FIRST_PLAYER);
+    writeByte(firstPlayer->getId());
+}
+
+/**
+ * Records an army of the Anon player placed on a region, in a game of two players.
+ */
+void GameRecorder::recordAnonArmy(Vertex* region) {
+    writeByte(RECORD_ANON_ARMY);
+    writeNumber(region->getId());
+}
+
+/**
+ * Closes the setup with a hash of the state of the game. The decisions of the players are only
+ * recorded from here on, so the starting armies aren't recorded twice.
+ */
+void GameRecorder::recordEndOfSetup(GameContext* context) {
+    writeByte(RECORD_END_SETUP);
+    writeHash(context);
+    *isRecording = true;
+}
+
+/**
+ * Records the position in the game hand of the card a player bought.
+ */
+void GameRecorder::recordCard(Player* player, int position) {
+    if (!*isRecording)
+        return;
+
+    writeByte(RECORD_CARD);
+    writeByte(player->getId());
+    writeNumber(uint64_t(position));
+}
+
+/**
+ * Records armies a player added to a region.
+ */
+void GameRecorder::recordAddArmies(Player* player, int numArmies, Vertex* region) {
+    if (!*isRecording)
+        return;
+
+    writeByte(RECORD_ADD_ARMIES);
+    writeByte(player->getId());
+    writeNumber(uint64_t(numArmies));
+    writeNumber(region->getId());
+}
+
+/**
+ * Records armies a player moved from one region to another.
+ */
+void GameRecorder::recordMoveArmies(Player* player, int numArmies, Vertex* start, Vertex* end, bool moveOverWater) {
+    if (!*isRecording)
+        return;
+
+    writeByte(RECORD_MOVE_ARMIES);
+    writeByte(player->getId());
+    writeNumber(uint64_t(numArmies));
+    writeNumber(start->getId());
+    writeNumber(end->getId());
+    writeByte(moveOverWater ? 1 : 0);
+}
+
+/**
+ * Records a city a player built on a region.
+ */
+void GameRecorder::recordBuildCity(Player* player, Vertex* region) {
+    if (!*isRecording)
+        return;
+
+    writeByte(RECORD_BUILD_CITY);
+    writeByte(player->getId());
+    writeNumber(region->getId());
+}
+
+/**
+ * Records an army of an opponent that a player destroyed on a region.
+ */
+void GameRecorder::recordDestroyArmy(Player* player, Vertex* region, Player* opponent) {
+    if (!*isRecording)
+        return;
+
+    writeByte(RECORD_DESTROY_ARMY);
+    writeByte(player->getId());
+    writeNumber(region->getId());
+    writeByte(opponent->getId());
+}
+
+/**
+ * Records a player ignoring the action of their card.
+ */
+void GameRecorder::recordIgnore(Player* player) {
+    if (!*isRecording)
+        return;
+
+    writeByte(RECORD_IGNORE);
+    writeByte(player->getId());
+}
+
+/**
+ * Closes a turn, after the card drawn from the deck took the place of the card bought, with a
+ * hash of the state of the game.
+ */
+void GameRecorder::recordEndOfTurn(GameContext* context) {
+    if (!*isRecording)
+        return;
+
+    writeByte(RECORD_END_TURN);
+    writeHash(context);
+}
+
+/**
+ * Closes the record. Nothing more is recorded until the next setup.
+ */
+void GameRecorder::recordEndOfGame() {
+    if (!*isRecording)
+        return;
+
+    writeByte(RECORD_END_GAME);
+    *isRecording = false;
+}
+
+/**
+ * Writes the record to a file.
+ *
+ * @return A boolean representing if the file could be written.
+ */
+bool GameRecorder::save(const string& fileName) {
+    ofstream file(fileName, ios::binary);
+    file.write(reinterpret_cast<const char*>(log->data()), streamsize(log->size()));
+    return bool(file);
+}
+
+//PRIVATE
+void GameRecorder::writeByte(uint8_t value) {
+    log->push_back(value);
+}
+
+//PRIVATE
+void GameRecorder::writeNumber(uint64_t value) {
+    appendNumber(log, value);
+}
+
+//PRIVATE
+void GameRecorder::writeString(const string& value) {
+    writeNumber(value.size());
+    log->insert(log->end(), value.begin(), value.end());
+}
+
+//PRIVATE
+/**
+ * Writes the low 32 bits of the hash of the state of the game.
+ */
+void GameRecorder::writeHash(GameContext* context) {
+    uint32_t hash = uint32_t(context->getStateHash());
+    for (int i = 0; i < 4; i++)
+        writeByte(uint8_t(hash >> (8 * i)));
+}
+
+/**
+ * Initializes a GameReplayer object.
+ *
+ * @param gameLog The record to play back. It must outlive the replayer.
+ * @param map A pointer to the map of the record, already loaded and shared with other games, or
+ * nullptr to load the map file of the record. The replayer doesn't own it.
+ */
+GameReplayer::GameReplayer(const vector<uint8_t>& gameLog, GameMap* map): GameReplayer(gameLog.data(), gameLog.size(), map) {}
+
+/**
+ * Initializes a GameReplayer object on a record in a larger buffer, eg. a mapped ReplayArchive.
+ *
+ * @param gameLog The first byte of the record. It must outlive the replayer.
+ * @param size The size of the record in bytes.
+ * @param map A pointer to the map of the record, or nullptr to load the map file of the record.
+ */
+GameReplayer::GameReplayer(const uint8_t* gameLog, size_t size, GameMap* map):
+    log(gameLog),
+    logSize(new size_t(size)),
+    position(new size_t(0)),
+    loadedMap(map),
+    context(nullptr),
+    anonPlayer(nullptr),
+    bids(new vector<int>(MAX_PLAYERS, 0)),
+    numTurns(new int(0)),
+    error(new string()) {}
+
+/**
+ * Destructor
+ */
+GameReplayer::~GameReplayer() {
+    delete logSize;
+    delete position;
+    delete context;
+    delete bids;
+    delete numTurns;
+    delete error;
+
+    log = nullptr;
+    logSize = nullptr;
+    position = nullptr;
+    loadedMap = nullptr;
+    context = nullptr;
+    anonPlayer = nullptr;
+    bids = nullptr;
+    numTurns = nullptr;
+    error = nullptr;
+}
+
+/**
+ * Reads a record from a file.
+ *
+ * @param fileName The name of the file.
+ * @param gameLog Set to the record.
+ * @return A boolean representing if the file could be read.
+ */
+bool GameReplayer::load(const string& fileName, vector<uint8_t>* gameLog) {
+    ifstream file(fileName, ios::binary);
+    if (!file)
+        return false;
+
+    gameLog->assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    return true;
+}
+
+/**
+ * Plays back the record to its end and checks every hash in it. The game is set up first, unless
+ * setUp() was already called.
+ *
+ * @return A boolean representing if the game played back to its end in step with the record. If
+ * it didn't, getError() tells where it stopped.
+ */
+bool GameReplayer::replay() {
+    while (replayTurn());
+    return error->empty();
+}
+
+/**
+ * Plays back the next turn of the record and checks its hash. The game is set up first, unless
+ * setUp() was already called.
+ *
+ * @return A boolean representing if a turn was played back in step with the record. It is false
+ * at the end of the game, and getError() is empty unless the replay went out of step.
+ */
+bool GameReplayer::replayTurn() {
+    if ((*position == 0 && !setUp()) || !error->empty())
+        return false;
+
+    int turn = *numTurns;
+    while (*numTurns == turn) {
+        uint8_t type;
+        if (!readByte(&type))
+            return fail("the record ends before the game");
+
+        // The end of the game isn't consumed, so every later call stops on it too.
+        if (type == RECORD_END_GAME) {
+            (*position)--;
+            return false;
+        }
+
+        if (!replayEntry(RecordType(type)))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Writes the full state of the game as it is now: the coin supply, the deck, the game hand, the
+ * coins, armies, cities and cards of every player, and every army and city on the map. The
+ * goods of the players aren't written, they are counted again from their cards.
+ *
+ * @param keyframe Set to the keyframe.
+ */
+void GameReplayer::writeKeyframe(vector<uint8_t>* keyframe) {
+    keyframe->clear();
+    appendNumber(keyframe, uint64_t(*numTurns));
+    appendNumber(keyframe, *position);
+    appendNumber(keyframe, context->getStateHash());
+    appendNumber(keyframe, uint64_t(context->getCoinSupply()));
+
+    const uint8_t* deck = (const uint8_t*) context->getHand()->getDeck()->getState();
+    const uint8_t* market = (const uint8_t*) context->getHand()->getMarket();
+    keyframe->insert(keyframe->end(), deck, deck + sizeof(DeckState));
+    keyframe->insert(keyframe->end(), market, market + sizeof(MarketState));
+
+    GameMap* map = context->getMap();
+    appendNumber(keyframe, uint64_t(map->getNumPlayers()));
+    for (int i = 0; i < map->getNumPlayers(); i++) {
+        Player* player = map->getPlayer(PlayerId(i));
+
+        appendNumber(keyframe, uint64_t(*player->coins));
+        appendNumber(keyframe, uint64_t(*player->armies));
+        appendNumber(keyframe, uint64_t(*player->cities));
+        appendNumber(keyframe, player->hand->size());
+        for (const CardInfo* card : *player->hand)
+            keyframe->push_back(uint8_t(card->getID()));
+    }
+
+    // The pieces are written by region, as slot, region, armies and cities.
+    ArmyMatrix* matrix = map->getArmyMatrix();
+    vector<uint8_t> pieces;
+    uint64_t numPieces = 0;
+    for (int slot = 0; slot < matrix->getNumSlots(); slot++) {
+        for (RegionId region = 0; region < RegionId(matrix->getNumRegions()); region++) {
+            int armies = matrix->getArmies(slot, region);
+            int cities = matrix->getCities(slot, region);
+            if (armies == 0 && cities == 0)
+                continue;
+
+            appendNumber(&pieces, uint64_t(slot));
+            appendNumber(&pieces, region);
+            appendNumber(&pieces, uint64_t(armies));
+            appendNumber(&pieces, uint64_t(cities));
+            numPieces++;
+        }
+    }
+
+    appendNumber(keyframe, numPieces);
+    keyframe->insert(keyframe->end(), pieces.begin(), pieces.end());
+}
+
+/**
+ * Replaces the state of the game with a keyframe written by writeKeyframe() from the same
+ * record, and moves the replay to the turn after it. The game must be set up first. The hash of
+ * the loaded state is checked against the one in the keyframe.
+ *
+ * @param keyframe The first byte of the keyframe.
+ * @param size The size of the keyframe in bytes.
+ * @return A boolean representing if the keyframe was loaded in step with the record. If it
+ * wasn't, the state of the game is broken and the replay can't go on.
+ */
+bool GameReplayer::loadKeyframe(const uint8_t* keyframe, size_t size) {
+    if (!context || !error->empty())
+        return fail("the game isn't set up for a keyframe");
+
+    size_t at = 0;
+    auto read = [&](uint64_t* value) { return parseNumber(keyframe, size, &at, value); };
+
+    uint64_t turn, logPosition, hash, coinSupply, numPlayers;
+    if (!read(&turn) || !read(&logPosition) || !read(&hash) || !read(&coinSupply) || logPosition > *logSize
+            || size - at < sizeof(DeckState) + sizeof(MarketState))
+        return fail("broken keyframe");
+
+    memcpy(context->getHand()->getDeck()->getState(), keyframe + at, sizeof(DeckState));
+    at += sizeof(DeckState);
+    memcpy(context->getHand()->getMarket(), keyframe + at, sizeof(MarketState));
+    at += sizeof(MarketState);
+
+    context->setCoinSupply(int(coinSupply));
+
+    // Anon joins a game of two in its setup, so a game set up straight from a keyframe is one
+    // player short of it until then.
+    GameMap* map = context->getMap();
+    if (!read(&numPlayers))
+        return fail("broken keyframe");
+    if (!anonPlayer && numPlayers == uint64_t(map->getNumPlayers()) + 1 && context->getNumPlayers() == 2) {
+        anonPlayer = new Player(ANON, context->getColours()->front());
+        context->addPlayer(anonPlayer);
+    }
+    if (numPlayers != uint64_t(map->getNumPlayers()))
+        return fail("the keyframe of turn " + to_string(turn) + " has other players");
+
+    // Every piece is taken off the map before the ones of the keyframe are put back.
+    clearBoard();
+
+    for (int i = 0; i < map->getNumPlayers(); i++) {
+        Player* player = map->getPlayer(PlayerId(i));
+        uint64_t coins, armies, cities, numCards;
+        if (!read(&coins) || !read(&armies) || !read(&cities) || !read(&numCards) || numCards > size - at)
+            return fail("broken keyframe");
+
+        *player->coins = int(coins);
+        *player->armies = int(armies);
+        *player->cities = int(cities);
+        player->hand->clear();
+        *player->goods = GoodsCount();
+
+        for (uint64_t card = 0; card < numCards; card++) {
+            if (keyframe[at] == 0 || keyframe[at] > DECK_SIZE)
+                return fail("broken keyframe");
+
+            player->hand->push_back(Deck::getCard(keyframe[at++]));
+            if (player->hand->back()->getGoodId() != NO_GOOD)
+                (*player->goods)[player->hand->back()->getGoodId()] += player->hand->back()->getGoodCount();
+        }
+    }
+
+    uint64_t numPieces;
+    if (!read(&numPieces))
+        return fail("broken keyframe");
+
+    for (uint64_t piece = 0; piece < numPieces; piece++) {
+        uint64_t slot, region, armies, cities;
+        if (!read(&slot) || !read(&region) || !read(&armies) || !read(&cities)
+                || slot >= numPlayers || region >= map->getNumRegions())
+            return fail("broken keyframe");
+
+        Player* player = map->getPlayer(PlayerId(slot));
+        Vertex* vertex = map->getVertex(RegionId(region));
+        vertex->setCities(player->getId(), int(cities));
+        addArmies(player, vertex, int(armies));
+    }
+
+    *position = size_t(logPosition);
+    *numTurns = int(turn);
+
+    if (hash != context->getStateHash())
+        return fail("the game is out of step with the keyframe of turn " + to_string(turn));
+
+    return true;
+}
+
+/**
+ * Sets up the game from the start of the record: seeds it, loads the map, creates the players,
+ * fills the game hand, places the coins and the starting armies and plays back the bids. The
+ * context of the last record, if the replayer was rewound to this one, is cleared and kept when
+ * the game is on the same map between the same players (see rewind()).
+ *
+ * @return A boolean representing if the setup played back in step with the record.
+ */
+bool GameReplayer::setUp() {
+    string startVertex;
+    if (!readPlayers(&startVertex))
+        return false;
+
+    // The game hand is filled like Hand::fill() does, without announcing every card drawn.
+    Hand* hand = context->getHand();
+    hand->getDeck()->shuffle();
+    for (int i = 0; i < MARKET_SIZE; i++)
+        hand->getMarket()->push(hand->getDeck()->drawId());
+
+    if (!StartUpGameEngine(context).placeStartingPieces(startVertex))
+        return fail("no region " + startVertex + " on the map");
+
+    while (true) {
+        uint8_t type;
+        if (!readByte(&type))
+            return fail("the record ends in its setup");
+
+        if (type == RECORD_END_SETUP)
+            return checkHash();
+
+        if (type > RECORD_END_SETUP || !replayEntry(RecordType(type)))
+            return fail("the setup is broken");
+    }
+}
+
+/**
+ * Sets up the game straight from a keyframe written by writeKeyframe() from the same record: the
+ * context and the players are readied like setUp() does, then the keyframe is loaded, without
+ * playing back the setup and the turns before it.
+ *
+ * @param keyframe The first byte of the keyframe.
+ * @param size The size of the keyframe in bytes.
+ * @return A boolean representing if the keyframe was loaded in step with the record.
+ */
+bool GameReplayer::setUpFromKeyframe(const uint8_t* keyframe, size_t size) {
+    string startVertex;
+    if (!readPlayers(&startVertex))
+        return false;
+
+    if (!context->getMap()->setStartVertex(startVertex))
+        return fail("no region " + startVertex + " on the map");
+
+    return loadKeyframe(keyframe, size);
+}
+
+/**
+ * Moves the replayer to the start of another record.
+ *
+ * @param gameLog The record to play back. It must outlive the replayer.
+ * @param map A pointer to the map of the record, or nullptr to load the map file of the record.
+ */
+void GameReplayer::rewind(const vector<uint8_t>& gameLog, GameMap* map) {
+    rewind(gameLog.data(), gameLog.size(), map);
+}
+
+/**
+ * Moves the replayer to the start of another record, eg. the next game of a batch or of a
+ * ReplayArchive. The context of the game played back so far is kept, and setUp() clears it for
+ * the next game rather than building a new one when the game is on the same map between the
+ * same players, which saves creating the players and their strategies again.
+ *
+ * @param gameLog The first byte of the record. It must outlive the replayer.
+ * @param size The size of the record in bytes.
+ * @param map A pointer to the map of the record, or nullptr to load the map file of the record.
+ * The context is only kept for a record on the same map as the last one.
+ */
+void GameReplayer::rewind(const uint8_t* gameLog, size_t size, GameMap* map) {
+    if (map != loadedMap) {
+        delete context;
+        context = nullptr;
+        anonPlayer = nullptr;
+        loadedMap = map;
+    }
+
+    log = gameLog;
+    *logSize = size;
+    *position = 0;
+    *numTurns = 0;
+    fill(bids->begin(), bids->end(), 0);
+    error->clear();
+}
+
+//PRIVATE
+/**
+ * Reads the start of the record, up to the start region, and readies the context for it: the
+ * context of the last record is cleared and kept when the game is on the same map between the
+ * same players, else a new one is built, with the map and the players of the record. The game
+ * is then seeded.
+ *
+ * @param startVertex Set to the key of the start region.
+ * @return A boolean representing if the context is ready.
+ */
+bool GameReplayer::readPlayers(string* startVertex) {
+    if (*logSize < sizeof(RECORD_MAGIC) || !equal(RECORD_MAGIC, RECORD_MAGIC + sizeof(RECORD_MAGIC), log))
+        return fail("not a game record");
+    *position = sizeof(RECORD_MAGIC);
+
+    uint8_t version;
+    if (!readByte(&version) || version != RECORD_VERSION)
+        return fail("unknown record version");
+
+    uint64_t seed = 0;
+    for (int i = 0; i < 8; i++) {
+        uint8_t byte;
+        if (!readByte(&byte))
+            return fail("the record ends in its setup");
+        seed |= uint64_t(byte) << (8 * i);
+    }
+
+    string mapFile;
+    uint64_t numRegions;
+    if (!readString(&mapFile) || !readNumber(&numRegions))
+        return fail("the record ends in its setup");
+
+    uint8_t numPlayers;
+    if (!readByte(&numPlayers) || numPlayers < 2 || numPlayers > MAX_PLAYERS - 1)
+        return fail("the record has no players");
+
+    // The name, colour and strategy of every player, in the order they joined the game.
+    vector<string> seats(numPlayers * 3);
+    for (int i = 0; i < numPlayers; i++) {
+        if (!readString(&seats[i * 3]) || !readString(&seats[i * 3 + 1]) || !readString(&seats[i * 3 + 2]))
+            return fail("the record ends in its players");
+    }
+
+    // Anon is kept too, as every game of two players has it.
+    bool isSameTable = context && context->getMapFile() == mapFile && context->getNumPlayers() == numPlayers;
+    for (int i = 0; isSameTable && i < numPlayers; i++) {
+        Player* player = context->getMap()->getPlayer(PlayerId(i));
+        isSameTable = player && player->getName() == seats[i * 3] && player->getColour() == seats[i * 3 + 1]
+            && player->getStrategy()->getType() == seats[i * 3 + 2];
+    }
+
+    if (isSameTable)
+        clearGame();
+    else {
+        delete context;
+        anonPlayer = nullptr;
+
+        context = loadedMap ? new GameContext(loadedMap) : new GameContext();
+        context->setIsTournament(true);
+        context->setMapFile(mapFile);
+
+        if (!loadedMap && (!MapLoader(mapFile).generateMap(context->getMap()) || !validateMap(context->getMap())))
+            return fail("invalid map " + mapFile);
+
+        context->setNumPlayers(numPlayers);
+
+        for (int i = 0; i < numPlayers; i++) {
+            const string& type = seats[i * 3 + 2];
+            Strategy* strategy;
+            if (type == GREEDY)
+                strategy = new GreedyStrategy();
+            else if (type == MODERATE)
+                strategy = new ModerateStrategy();
+            else
+                strategy = new HumanStrategy();
+
+            context->getColours()->remove(seats[i * 3 + 1]);
+            context->addPlayer(new Player(seats[i * 3], seats[i * 3 + 1], strategy));
+        }
+    }
+
+    if (context->getMap()->getNumRegions() != numRegions)
+        return fail("the map " + mapFile + " changed since the game was recorded");
+
+    context->setSeed(seed);
+
+    if (!readString(startVertex))
+        return fail("the record ends in its setup");
+
+    return true;
+}
+
+//PRIVATE
+/**
+ * Takes the game of the last record off the context: every piece leaves the map, and the
+ * players, the deck, the game hand and the coin supply go back to how a new game has them. The
+ * players keep their place on the map.
+ */
+void GameReplayer::clearGame() {
+    clearBoard();
+
+    GameMap* map = context->getMap();
+    for (int i = 0; i < map->getNumPlayers(); i++) {
+        Player* player = map->getPlayer(PlayerId(i));
+
+        *player->coins = 0;
+        *player->armies = START_ARMIES;
+        *player->cities = START_CITIES;
+        player->hand->clear();
+        *player->goods = GoodsCount();
+    }
+
+    context->getHand()->getDeck()->reset();
+    *context->getHand()->getMarket() = MarketState();
+    context->setCoinSupply(START_COIN_SUPPLY);
+}
+
+//PRIVATE
+/**
+ * Takes every piece off the map at once. The players stay on the map, without any regions.
+ */
+void GameReplayer::clearBoard() {
+    GameMap* map = context->getMap();
+    map->clearPieces();
+
+    for (int i = 0; i < map->getNumPlayers(); i++)
+        map->getPlayer(PlayerId(i))->clearRegions();
+}
+
+//PRIVATE
+/**
+ * Plays back one entry of the record.
+ *
+ * @param type The kind of the entry, already read.
+ * @return A boolean representing if the entry could be played back.
+ */
+bool GameReplayer::replayEntry(RecordType type) {
+    Player* player = nullptr;
+    Vertex* region = nullptr;
+    uint64_t number;
+
+    switch (type) {
+        case RECORD_BID:
+            if (!readPlayer(&player) || !readNumber(&number))
+                return fail("broken bid");
+            (*bids)[player->getId()] = int(number);
+            return true;
+
+        case RECORD_BID_WINNER:
+            if (!readPlayer(&player))
+                return fail("broken bid winner");
+            *player->coins -= (*bids)[player->getId()];
+            context->setCoinSupply(context->getCoinSupply() - (*bids)[player->getId()]);
+            return true;
+
+        case RECORD_FIRST_PLAYER:
+            return readPlayer(&player) || fail("broken first player");
+
+        case RECORD_ANON_ARMY:
+            if (!readRegion(&region))
+                return fail("broken Anon army");
+
+            if (!anonPlayer) {
+                anonPlayer = new Player(ANON, context->getColours()->front());
+                context->addPlayer(anonPlayer);
+            }
+            addArmies(anonPlayer, region, 1);
+            return true;
+
+        case RECORD_CARD: {
+            if (!readPlayer(&player) || !readNumber(&number) || number >= uint64_t(context->getHand()->size()))
+                return fail("broken card");
+
+            int cost = CARD_COSTS[number];
+            if (cost > *player->coins)
+                return fail(player->getName() + " can't pay for card " + to_string(number));
+
+            const CardInfo* card = Deck::getCard(context->getHand()->getMarket()->take(int(number)));
+            player->hand->push_back(card);
+            if (card->getGoodId() != NO_GOOD)
+                (*player->goods)[card->getGoodId()] += card->getGoodCount();
+
+            *player->coins -= cost;
+            context->setCoinSupply(context->getCoinSupply() + cost);
+            return true;
+        }
+
+        case RECORD_ADD_ARMIES:
+            if (!readPlayer(&player) || !readNumber(&number) || !readRegion(&region))
+                return fail("broken added armies");
+
+            // A player short of armies places the ones they have left.
+            number = min(number, uint64_t(*player->armies));
+            addArmies(player, region, int(number));
+            player->decreaseAvailableArmies(int(number));
+            return true;
+
+        case RECORD_MOVE_ARMIES: {
+            Vertex* end;
+            uint8_t moveOverWater;
+            if (!readPlayer(&player) || !readNumber(&number) || !readRegion(&region) || !readRegion(&end) || !readByte(&moveOverWater))
+                return fail("broken moved armies");
+
+            if (number > uint64_t(region->getArmiesOf(player->getId())))
+                return fail(player->getName() + " can't move armies from " + region->getKey());
+
+            addArmies(player, end, int(number));
+            removeArmies(player, region, int(number));
+            return true;
+        }
+
+        case RECORD_BUILD_CITY:
+            if (!readPlayer(&player) || !readRegion(&region))
+                return fail("broken city");
+
+            region->setCities(player->getId(), region->getCitiesOf(player->getId()) + 1);
+            return true;
+
+        case RECORD_DESTROY_ARMY: {
+            Player* opponent;
+            if (!readPlayer(&player) || !readRegion(&region) || !readPlayer(&opponent))
+                return fail("broken destroyed army");
+
+            int opponentArmies = region->getArmiesOf(opponent->getId());
+            if (opponentArmies == 0)
+                return fail(opponent->getName() + " has no armies to destroy on " + region->getKey());
+
+            opponent->increaseAvailableArmies(1);
+            removeArmies(opponent, region, 1);
+            return true;
+        }
+
+        case RECORD_IGNORE:
+            return readPlayer(&player) || fail("broken ignored action");
+
+        case RECORD_END_TURN:
+            context->getHand()->getMarket()->push(context->getHand()->getDeck()->drawId());
+            (*numTurns)++;
+            return checkHash();
+
+        default:
+            return fail("unknown entry " + to_string(type));
+    }
+}
+
+//PRIVATE
+/**
+ * Adds armies of a player to a region, which becomes one of their regions. Unlike
+ * Player::addArmiesToRegion(), nothing is printed: the move was already made once.
+ */
+void GameReplayer::addArmies(Player* player, Vertex* region, int numArmies) {
+    PlayerId id = player->getId();
+    region->setArmies(id, region->getArmiesOf(id) + numArmies);
+    player->setOccupied(region, true);
+}
+
+//PRIVATE
+/**
+ * Takes armies of a player off a region, which stops being one of their regions once none of
+ * their armies and cities are left on it. Nothing is printed, like addArmies().
+ */
+void GameReplayer::removeArmies(Player* player, Vertex* region, int numArmies) {
+    PlayerId id = player->getId();
+    int armiesLeft = region->getArmiesOf(id) - numArmies;
+    region->setArmies(id, armiesLeft);
+    if (armiesLeft == 0 && region->getCitiesOf(id) == 0)
+        player->setOccupied(region, false);
+}
+
+//PRIVATE
+/**
+ * Reads a hash from the record and compares it with the hash of the replayed game.
+ */
+bool GameReplayer::checkHash() {
+    uint32_t hash = 0;
+    for (int i = 0; i < 4; i++) {
+        uint8_t byte;
+        if (!readByte(&byte))
+            return fail("the record ends in a hash");
+        hash |= uint32_t(byte) << (8 * i);
+    }
+
+    if (hash != uint32_t(context->getStateHash()))
+        return fail("the game is out of step with the record after " + (*numTurns ? "turn " + to_string(*numTurns) : "the setup"));
+
+    return true;
+}
+
+//PRIVATE
+/**
+ * Stops the replay with an error, unless it already has one.
+ *
+ * @return false, always.
+ */
+bool GameReplayer::fail(const string& reason) {
+    if (error->empty())
+        *error = reason + " (at byte " + to_string(*position) + ")";
+    return false;
+}
+
+//PRIVATE
+bool GameReplayer::readByte(uint8_t* value) {
+    if (*position >= *logSize)
+        return false;
+
+    *value = log[(*position)++];
+    return true;
+}
+
+//PRIVATE
+bool GameReplayer::readNumber(uint64_t* value) {
+    return parseNumber(log, *logSize, position, value);
+}
+
+//PRIVATE
+bool GameReplayer::readString(string* value) {
+    uint64_t length;
+    if (!readNumber(&length) || length > *logSize - *position)
+        return false;
+
+    value->assign(log + *position, log + *position + length);
+    *position += length;
+    return true;
+}
+
+//PRIVATE
+/**
+ * Reads a player by their PlayerId.
+ */
+bool GameReplayer::readPlayer(Player** player) {
+    uint8_t id;
+    if (!readByte(&id))
+        return false;
+
+    *player = context->getMap()->getPlayer(PlayerId(id));
+    return *player != nullptr;
+}
+
+//PRIVATE
+/**
+ * Reads a region by its RegionId.
+ */
+bool GameReplayer::readRegion(Vertex** region) {
+    uint64_t id;
+    if (!readNumber(&id) || id >= context->getMap()->getNumRegions())
+        return false;
+
+    *region = context->getMap()->getVertex(RegionId(id));
+    return true;
+}
@@ -0,0 +1,154 @@
+#ifndef GAME_RECORDER_H
+#define GAME_RECORDER_H
+
+#include "ArmyMatrix.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class GameContext;
+class GameMap;
+class Player;
+class Vertex;
+
+// The first bytes of every game record, followed by the version of the format.
+const char RECORD_MAGIC[4] = { '8', 'M', 'E', 'R' };
+const uint8_t RECORD_VERSION = 1;
+
+/**
+ * The kinds of entries in a game record. Each entry is its kind, then its fields. Players are
+ * one byte (their PlayerId), regions and counts are variable length integers, and hashes are 32
+ * bits of GameContext::getStateHash().
+ */
+enum RecordType : uint8_t {
+    RECORD_BID = 1,         // player, amount
+    RECORD_BID_WINNER,      // player
+    RECORD_FIRST_PLAYER,    // player
+    RECORD_ANON_ARMY,       // region
+    RECORD_END_SETUP,       // hash
+    RECORD_CARD,            // player, position in the game hand
+    RECORD_ADD_ARMIES,      // player, armies, region
+    RECORD_MOVE_ARMIES,     // player, armies, start region, end region, over water
+    RECORD_BUILD_CITY,      // player, region
+    RECORD_DESTROY_ARMY,    // player, region, opponent
+    RECORD_IGNORE,          // player
+    RECORD_END_TURN,        // hash
+    RECORD_END_GAME
+};
+
+/**
+ * Records a game as it is played, in a compact binary log that GameReplayer can play back.
+ *
+ * The record starts with what the game was set up with: the seed, the map file, the players and
+ * the start region. Then come the bids and every decision that changed the board, as the players
+ * made them: the card each player bought and the armies and cities they placed, moved and
+ * destroyed. The strategies that made the decisions aren't needed to play them back. A hash of
+ * the state of the game closes the setup and every turn, so a replay can check it stays in step.
+ *
+ * A recorder is attached to a GameContext, and records nothing until the setup is recorded.
+ */
+class GameRecorder {
+    vector<uint8_t>* log;
+    bool* isRecording;
+
+public:
+    GameRecorder();
+    GameRecorder(GameRecorder* recorder);
+    GameRecorder& operator=(GameRecorder& recorder);
+    ~GameRecorder();
+
+    void recordSetup(GameContext* context);
+    void recordBid(Player* player, int amount);
+    void recordBidWinner(Player* winner);
+    void recordFirstPlayer(Player* firstPlayer);
+    void recordAnonArmy(Vertex* region);
+    void recordEndOfSetup(GameContext* context);
+    void recordCard(Player* player, int position);
+    void recordAddArmies(Player* player, int numArmies, Vertex* region);
+    void recordMoveArmies(Player* player, int numArmies, Vertex* start, Vertex* end, bool moveOverWater);
+    void recordBuildCity(Player* player, Vertex* region);
+    void recordDestroyArmy(Player* player, Vertex* region, Player* opponent);
+    void recordIgnore(Player* player);
+    void recordEndOfTurn(GameContext* context);
+    void recordEndOfGame();
+
+    const vector<uint8_t>& getLog() { return *log; }
+    bool save(const string& fileName);
+
+private:
+    void writeByte(uint8_t value);
+    void writeNumber(uint64_t value);
+    void writeString(const string& value);
+    void writeHash(GameContext* context);
+};
+
+/**
+ * Plays back a game record on a GameContext of its own, without the strategies. A replayer can be
+ * rewound to another record, and then keeps its context for it when the game is on the same map
+ * between the same players.
+ *
+ * The game is set up from the record with the same engine as a live game. The decisions were
+ * checked against the rules when they were made, so their effects are applied to the board and
+ * the players directly, without the checks and the messages of the live game. After the setup
+ * and after every turn the state of the game is hashed and compared with the hash in the record,
+ * and the replay stops at the first one that doesn't match.
+ *
+ * A keyframe is the full state of the game after a turn. Loading one skips the turns before it,
+ * so a ReplayArchive can reach any turn of a game by playing back only the turns after the
+ * nearest keyframe.
+ */
+class GameReplayer {
+    const uint8_t* log;
+    size_t* logSize;
+    size_t* position;
+    GameMap* loadedMap;
+    GameContext* context;
+    Player* anonPlayer;
+    vector<int>* bids;
+    int* numTurns;
+    string* error;
+
+public:
+    GameReplayer(const vector<uint8_t>& gameLog, GameMap* map = nullptr);
+    GameReplayer(const uint8_t* gameLog, size_t size, GameMap* map = nullptr);
+    GameReplayer(GameReplayer* replayer) = delete;
+    GameReplayer& operator=(GameReplayer& replayer) = delete;
+    ~GameReplayer();
+
+    static bool load(const string& fileName, vector<uint8_t>* gameLog);
+
+    bool setUp();
+    void rewind(const vector<uint8_t>& gameLog, GameMap* map = nullptr);
+    void rewind(const uint8_t* gameLog, size_t size, GameMap* map = nullptr);
+    bool replay();
+    bool replayTurn();
+
+    void writeKeyframe(vector<uint8_t>* keyframe);
+    bool loadKeyframe(const uint8_t* keyframe, size_t size);
+    bool setUpFromKeyframe(const uint8_t* keyframe, size_t size);
+
+    GameContext* getContext() { return context; }
+    int getNumTurns() { return *numTurns; }
+    const string& getError() { return *error; }
+
+private:
+    bool readPlayers(string* startVertex);
+    void clearGame();
+    void clearBoard();
+    bool replayEntry(RecordType type);
+    void addArmies(Player* player, Vertex* region, int numArmies);
+    void removeArmies(Player* player, Vertex* region, int numArmies);
+    bool checkHash();
+    bool fail(const string& reason);
+
+    bool readByte(uint8_t* value);
+    bool readNumber(uint64_t* value);
+    bool readString(string* value);
+    bool readPlayer(Player** player);
+    bool readRegion(Vertex** region);
+};
+
+#endif
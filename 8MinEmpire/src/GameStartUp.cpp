@@ -1,40 +1,40 @@
 #include<algorithm>
 #include "GameStartUp.h"
 
-StartUpGameEngine* StartUpGameEngine::startUpInstance = 0;
-
 /**
- * Default Constructor
+ * Initializes a StartUpGameEngine object.
+ *
+ * @param gameContext A pointer to the context of the game to set up. The engine doesn't own it.
  */
-StartUpGameEngine::StartUpGameEngine():
-    nextTurn(new queue<Player*>()),
-    coinSupply(new int(44)) {}
+StartUpGameEngine::StartUpGameEngine(GameContext* gameContext): context(gameContext) {}
 
 /**
- * Deconstructor
+ * Copy Constructor
  */
-StartUpGameEngine::~StartUpGameEngine(){
-    delete InitGameEngine::instance();
-    delete nextTurn;
+StartUpGameEngine::StartUpGameEngine(StartUpGameEngine* startUpEngine) {
+    context = startUpEngine->context;
+}
 
-    startUpInstance = nullptr;
-    nextTurn = nullptr;
+/**
+ * Assignment operator
+ */
+StartUpGameEngine& StartUpGameEngine::operator=(StartUpGameEngine& startUpEngine) {
+    if (&startUpEngine != this)
+        context = startUpEngine.context;
+    return *this;
 }
 
 /**
- * Returns a singleton instance of a StartUpGameEngine object.
+ * Destructor
  */
-StartUpGameEngine* StartUpGameEngine::instance() {
-    if (!startUpInstance) {
-        startUpInstance = new StartUpGameEngine();
-    }
-    return startUpInstance;
+StartUpGameEngine::~StartUpGameEngine() {
+    context = nullptr;
 }
 
 /**
  * Starts the game.
  *
- * Uses the InitGameEngine object to initialize map and players, then
+ * Uses an InitGameEngine object to initialize map and players, then
  * sets up the "game board" by distributing the starter coins to each player, asking for the start
  * region, and placing 3 armies on the start region for each player.
  *
@@ -45,21 +45,72 @@ StartUpGameEngine* StartUpGameEngine::instance() {
  */
 void StartUpGameEngine::startGame() {
     // Create Map and Players
-    InitGameEngine::instance()->initGame();
+    InitGameEngine(context).initGame();
 
     // Setup Game Board
     distributeCoins();
     selectStartVertex();
     placeStartingArmies();
+    setUpBoard();
+}
+
+/**
+ * Starts a tournament game without asking anything, eg. for a game played in a batch.
+ *
+ * The players must already be in the context and the game hand must be filled. The players
+ * get their coins and 3 armies on the start region, then bid for the first player.
+ *
+ * @param startVertex The key of the start region.
+ * @return A boolean representing if the start region exists on the map.
+ */
+bool StartUpGameEngine::startGame(string startVertex) {
+    if (!placeStartingPieces(startVertex))
+        return false;
+
+    setUpBoard();
+    return true;
+}
+
+/**
+ * Gives the players their coins and places their 3 armies on the start region, without asking
+ * anything. The players must already be in the context, eg. for a game played back by a
+ * GameReplayer, which then plays back the bids from its record.
+ *
+ * @param startVertex The key of the start region.
+ * @return A boolean representing if the start region exists on the map.
+ */
+bool StartUpGameEngine::placeStartingPieces(string startVertex) {
+    distributeCoins();
+
+    if (!context->getMap()->setStartVertex(startVertex))
+        return false;
+
+    placeStartingArmies();
+    return true;
+}
+
+//PRIVATE
+/**
+ * Asks the players their bids to determine the first player, then sets the turn order. The
+ * setup of the game ends here.
+ */
+void StartUpGameEngine::setUpBoard() {
+    GameRecorder* recorder = context->getRecorder();
 
     // Ask the players their bids to determine the first player.
-    Player* winner = Bidder::startBid(InitGameEngine::instance()->getPlayers());
+    Player* winner = Bidder::startBid(context->getPlayers());
 
     int winningBid = winner->getBidder()->getBidAmount();
     removeCoinsFromSupply(winningBid);
 
-    Player* firstPlayer = Bidder::getFirstPlayer(winner, InitGameEngine::instance()->getPlayers());
+    Player* firstPlayer = Bidder::getFirstPlayer(winner, context->getPlayers());
     setPlayerOrderInQueue(firstPlayer);
+
+    if (recorder) {
+        recorder->recordBidWinner(winner);
+        recorder->recordFirstPlayer(firstPlayer);
+        recorder->recordEndOfSetup(context);
+    }
 }
 
 /**
@@ -72,8 +123,8 @@ void StartUpGameEngine::startGame() {
  * two players   ->  14 coins.
  */
 void StartUpGameEngine::distributeCoins() {
-    int coins = 18 - InitGameEngine::instance()->getNumPlayers() * 2;
-    if (InitGameEngine::instance()->getNumPlayers() == 3 || InitGameEngine::instance()->getNumPlayers() == 4)
+    int coins = 18 - context->getNumPlayers() * 2;
+    if (context->getNumPlayers() == 3 || context->getNumPlayers() == 4)
         coins--;
 
     cout << "\n---------------------------------------------------------------------------" << endl;
@@ -81,7 +132,7 @@ void StartUpGameEngine::distributeCoins() {
     cout << "---------------------------------------------------------------------------\n" << endl;
 
     Players::iterator it;
-    for(it = InitGameEngine::instance()->getPlayers()->begin(); it != InitGameEngine::instance()->getPlayers()->end(); ++it) {
+    for(it = context->getPlayers()->begin(); it != context->getPlayers()->end(); ++it) {
         it->second->fillPurseFromSupply(coins);
         removeCoinsFromSupply(coins);
     }
@@ -91,13 +142,11 @@ void StartUpGameEngine::distributeCoins() {
  * Prompts a user to choose a start region on the map.
  */
 void StartUpGameEngine::selectStartVertex() {
-    Vertices* vertices = GameMap::instance()->getVertices();
-
     while(true) {
         string answer;
 
-        GameMap::instance()->printMap();
-        GameMap::instance()->printOccupiedRegions();
+        context->getMap()->printMap();
+        context->getMap()->printOccupiedRegions();
 
         cout << "\n[ START ] Please choose the start vertex on the map:" << endl;
         cout << "[ START ] > ";
@@ -105,8 +154,8 @@ void StartUpGameEngine::selectStartVertex() {
         getline(cin, answer);
         transform(answer.begin(), answer.end(), answer.begin(), ::toupper);
 
-        if (vertices->find(answer) != vertices->end()) {
-            GameMap::instance()->setStartVertex(answer);
+        if (context->getMap()->findVertex(answer)) {
+            context->getMap()->setStartVertex(answer);
             break;
         }
 
@@ -116,25 +165,29 @@ void StartUpGameEngine::selectStartVertex() {
 }
 
 /**
- * Places 3 armies on the start region for each player.
+ * Places 3 armies on the start region for each player. A recorded game starts its record here,
+ * once the start region is known.
  *
  * If there are only two players, a third player "Anon" is created and the other
  * two players each take turns placing armies anywhere on the map until there are
  * 4 armies belonging to Anon on the map.
  */
 void StartUpGameEngine::placeStartingArmies() {
-    Vertex* startVertex = GameMap::instance()->getStartVertex();
+    Vertex* startVertex = context->getMap()->getStartVertex();
+
+    if (context->getRecorder())
+        context->getRecorder()->recordSetup(context);
 
     cout << "\n---------------------------------------------------------------------------" << endl;
     cout << "[ START ] Placing 3 armies on the start vertex < " << startVertex->getName() << " >." << endl;
     cout << "---------------------------------------------------------------------------\n" << endl;
-    Players* players = InitGameEngine::instance()->getPlayers();
+    Players* players = context->getPlayers();
 
     for(Players::iterator it = players->begin(); it != players->end(); ++it) {
         it->second->executeAddArmies(3, startVertex);
     }
 
-    if (InitGameEngine::instance()->getPlayers()->size() == 2 && !InitGameEngine::instance()->isTournament())
+    if (context->getPlayers()->size() == 2 && !context->isTournament())
         placeAnonArmies();
 }
 
@@ -145,10 +198,11 @@ void StartUpGameEngine::placeStartingArmies() {
  * @param firstPlayer A Player pointer to the first player chosen by the winner during bidding.
  */
 void StartUpGameEngine::setPlayerOrderInQueue(Player* firstPlayer) {
+    queue<Player*>* nextTurn = context->getNextTurnQueue();
     nextTurn->push(firstPlayer);
 
-    Players* players = InitGameEngine::instance()->getPlayers();
-    vector<string>* playerOrder = InitGameEngine::instance()->getPlayerOrder();
+    Players* players = context->getPlayers();
+    vector<string>* playerOrder = context->getPlayerOrder();
 
     vector<string>::iterator it;
 
@@ -181,11 +235,9 @@ void StartUpGameEngine::setPlayerOrderInQueue(Player* firstPlayer) {
  * chooses 2 regions to add an army, up to 4 total Anon armies.
  */
 void StartUpGameEngine::placeAnonArmies() {
-    Players* players = InitGameEngine::instance()->getPlayers();
+    Players* players = context->getPlayers();
     queue<string> nextTurn;
 
-    PlayerEntry anonPlayerEntry (ANON, InitGameEngine::instance()->getColours()->front());
-
     cout << "\n---------------------------------------------------------------------------" << endl;
     cout << "[ START ] Because there are only 2 players, pleast take turns" << endl;
     cout << "\t  placing 4 armies belonging to a third Anon player on the map." << endl;
@@ -196,7 +248,8 @@ void StartUpGameEngine::placeAnonArmies() {
         nextTurn.push(it->first);
 
     int placedArmies = 0;
-    Player* anonPlayer = new Player(ANON, anonPlayerEntry.second);
+    Player* anonPlayer = new Player(ANON, context->getColours()->front());
+    anonPlayer->setContext(context);
 
     while(placedArmies < 4) {
         string player = nextTurn.front();
@@ -208,10 +261,10 @@ void StartUpGameEngine::placeAnonArmies() {
         placedArmies++;
     }
 
-    GameMap::instance()->printMap();
-    GameMap::instance()->printOccupiedRegions();
+    context->getMap()->printMap();
+    context->getMap()->printOccupiedRegions();
 
-    players->insert(pair<string, Player*>(ANON, anonPlayer));
+    context->addPlayer(anonPlayer);
 }
 
 
@@ -227,35 +280,22 @@ void StartUpGameEngine::chooseAnonVertex(string &player, Player* anonPlayer) {
         cout << "{ " << player << " } Choose a region to place one of " << anonPlayer->getName() << "'s armies." << endl;
         cout << "---------------------------------------------------------------------------\n" << endl;
 
-        GameMap::instance()->printMap();
-        GameMap::instance()->printOccupiedRegions();
+        context->getMap()->printMap();
+        context->getMap()->printOccupiedRegions();
 
         cout << "{ " << player << " } > ";
         getline(cin, startName);
         transform(startName.begin(), startName.end(),startName.begin(), ::toupper);
 
-        if (GameMap::instance()->getVertices()->find(startName) == GameMap::instance()->getVertices()->end()) {
+        Vertex* chosenVertex = context->getMap()->findVertex(startName);
+        if (!chosenVertex) {
             cout << "[ ERROR! ] You chose an invalid region name. Please try again." << endl;
         } else {
-            Vertex* chosenVertex = GameMap::instance()->getVertices()->find(startName)->second;
             anonPlayer->addArmiesToRegion(chosenVertex, 1);
+
+            if (context->getRecorder())
+                context->getRecorder()->recordAnonArmy(chosenVertex);
             break;
         }
     }
 }
-
-/**
- * Adds coins to the coin supply.
- */
-void StartUpGameEngine::addCoinsToSupply(int amount) {
-    *coinSupply += amount;
-    cout << "[ GAME COINS ] Coin supply now contains " << getCoinSupply() << " coins. " << endl;
-}
-
-/**
- * Removes coins from the coin supply.
- */
-void StartUpGameEngine::removeCoinsFromSupply(int amount) {
-    *coinSupply -= amount;
-    cout << "[ GAME COINS ] Coin supply now contains " << getCoinSupply() << " coins. " << endl;
-}
\ No newline at end of file
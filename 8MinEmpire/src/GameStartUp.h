@@ -5,36 +5,42 @@
 
 class Player;
 
+/**
+ * Sets up the board of a game: the coins, the start region, the starting armies and the turn order.
+ */
 class StartUpGameEngine {
-    static StartUpGameEngine* startUpInstance;
-    queue<Player*>* nextTurn;
-    int* coinSupply;
+    GameContext* context;
 
 public:
+    StartUpGameEngine(GameContext* gameContext);
+    StartUpGameEngine(StartUpGameEngine* startUpEngine);
+    StartUpGameEngine& operator=(StartUpGameEngine& startUpEngine);
     ~StartUpGameEngine();
 
-    static StartUpGameEngine* instance();
     void startGame();
+    bool startGame(string startVertex);
+    bool placeStartingPieces(string startVertex);
 
     //Getters
-    queue<Player*>* getNextTurnQueue() { return nextTurn; }
-    int getCoinSupply() { return *coinSupply; }
+    GameContext* getContext() { return context; }
+    queue<Player*>* getNextTurnQueue() { return context->getNextTurnQueue(); }
+    int getCoinSupply() { return context->getCoinSupply(); }
 
-    Players* getPlayers() { return InitGameEngine::instance()->getPlayers(); }
-    Hand* getHand() { return InitGameEngine::instance()->getHand();}
-    int getNumPlayers() { return InitGameEngine::instance()->getNumPlayers(); }
-    list<string>* getColours() { return InitGameEngine::instance()->getColours(); }
-    vector<string>* getPlayerOrder() { return InitGameEngine::instance()->getPlayerOrder(); }
+    Players* getPlayers() { return context->getPlayers(); }
+    Hand* getHand() { return context->getHand(); }
+    int getNumPlayers() { return context->getNumPlayers(); }
+    list<string>* getColours() { return context->getColours(); }
+    vector<string>* getPlayerOrder() { return context->getPlayerOrder(); }
 
-    void addCoinsToSupply(int amount);
-    void removeCoinsFromSupply(int amount);
+    void addCoinsToSupply(int amount) { context->addCoinsToSupply(amount); }
+    void removeCoinsFromSupply(int amount) { context->removeCoinsFromSupply(amount); }
 
 private:
-    StartUpGameEngine();
     void chooseAnonVertex(string &player, Player* anonPlayer);
     void selectStartVertex();
     void distributeCoins();
     void placeStartingArmies();
+    void setUpBoard();
     void setPlayerOrderInQueue(Player* firstPlayer);
     void placeAnonArmies();
 };
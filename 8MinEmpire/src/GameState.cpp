@@ -0,0 +1,45 @@
+#include "GameState.h"
+
+/**
+ * Default Constructor
+ *
+ * The state has no players and no regions until it is resized.
+ */
+GameState::GameState(): bytes(new vector<uint8_t>(sizeof(GameStateHeader), 0)) {}
+
+/**
+ * Copy Constructor
+ */
+GameState::GameState(GameState* state) {
+    bytes = new vector<uint8_t>(*state->bytes);
+}
+
+/**
+ * Assignment operator
+ */
+GameState& GameState::operator=(GameState& state) {
+    if (&state != this)
+        *bytes = *state.bytes;
+    return *this;
+}
+
+/**
+ * Destructor
+ */
+GameState::~GameState() {
+    delete bytes;
+    bytes = nullptr;
+}
+
+/**
+ * Makes room for the pieces of a game. A state taken again from the same game keeps its buffer.
+ *
+ * @param numPlayers The number of players on the map, the Anon player included.
+ * @param numRegions The number of regions on the map.
+ */
+void GameState::resize(int numPlayers, size_t numRegions) {
+    size_t pieceBytes = RegionSet::wordsFor(numRegions) * sizeof(uint64_t) + 2 * numRegions * sizeof(int16_t);
+    bytes->resize(sizeof(GameStateHeader) + size_t(numPlayers) * pieceBytes);
+    getHeader()->numPlayers = uint8_t(numPlayers);
+    getHeader()->numRegions = uint32_t(numRegions);
+}
@@ -0,0 +1,79 @@
+#ifndef GAME_STATE_H
+#define GAME_STATE_H
+
+#include "ArmyMatrix.h"
+#include "Cards.h"
+#include "Goods.h"
+#include "Random.h"
+#include "RegionSet.h"
+
+#include <stdint.h>
+#include <vector>
+
+using namespace std;
+
+/**
+ * The counters of one player in a GameState. Their cards are in GameStateHeader::cards.
+ */
+struct PlayerState {
+    uint8_t coins;
+    uint8_t armies;
+    uint8_t cities;
+    uint8_t numCards;
+    GoodsCount goods;
+};
+
+/**
+ * The fixed size part at the start of a GameState. Players are indexed by PlayerId.
+ */
+struct GameStateHeader {
+    uint64_t random[RANDOM_STATE_WORDS];
+    uint64_t piecesHash;
+    DeckState deck;
+    MarketState market;
+
+    uint32_t numRegions;
+
+    // Nothing checks the supply as coins leave it, so it can run below zero.
+    int16_t coinSupply;
+    uint8_t numPlayers;
+    uint8_t numSlots;       // Players with a row in the army matrix (see ArmyMatrix::getNumSlots()).
+    uint8_t numQueued;
+    uint8_t turnQueue[MAX_PLAYERS];
+    PlayerState players[MAX_PLAYERS];
+
+    // The cards of every player, one hand after the other.
+    uint8_t cards[DECK_SIZE];
+};
+
+/**
+ * Everything a game needs to go on from a point in time, in one contiguous block: the random
+ * number generator, the deck, the game hand, the coin supply, the turn queue, the coins, armies,
+ * cities and cards of every player, then a bitset per player of the regions they occupy, and
+ * then the rows of the army matrix of the map, the armies of every player and then their cities.
+ * The rows are laid out like the ones of the matrix, so putting a state back copies them
+ * straight in. A game on a standard map takes well under a kilobyte.
+ *
+ * A state is taken and put back by its GameContext (see GameContext::snapshot()), and copying
+ * one copies a single buffer, so a search can keep as many as it likes.
+ */
+class GameState {
+    vector<uint8_t>* bytes;
+
+public:
+    GameState();
+    GameState(GameState* state);
+    GameState& operator=(GameState& state);
+    ~GameState();
+
+    void resize(int numPlayers, size_t numRegions);
+
+    size_t getSize() { return bytes->size(); }
+    GameStateHeader* getHeader() { return (GameStateHeader*) bytes->data(); }
+    size_t getNumWords() { return RegionSet::wordsFor(getHeader()->numRegions); }
+    uint64_t* getOccupied(PlayerId player) { return (uint64_t*) (bytes->data() + sizeof(GameStateHeader)) + player * getNumWords(); }
+    int16_t* getArmies(PlayerId player) { return (int16_t*) getOccupied(getHeader()->numPlayers) + size_t(player) * getHeader()->numRegions; }
+    int16_t* getCities(PlayerId player) { return getArmies(getHeader()->numPlayers) + size_t(player) * getHeader()->numRegions; }
+};
+
+#endif
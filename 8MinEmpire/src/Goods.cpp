@@ -0,0 +1,168 @@
+#include "Goods.h"
+
+#include <algorithm>
+#include <vector>
+
+static const string GOOD_NAMES[NUM_GOODS + 1] = { WOOD, IRON, CARROT, GEM, STONE, WILD, NONE };
+
+/**
+ * Gets the name of a good, for display.
+ *
+ * @param good The interned good.
+ * @return The name of the good, or NONE.
+ */
+const string& getGoodName(GoodId good) {
+    return GOOD_NAMES[good];
+}
+
+/**
+ * Interns the good of a card. Cards with a double good name it twice, eg. "IRON IRON".
+ *
+ * @param good The good as printed on the card.
+ * @param count Set to the number of goods on the card.
+ * @return The interned good, or NO_GOOD if the name isn't a good.
+ */
+GoodId parseGood(const string& good, int& count) {
+    size_t spaceCharIndex = good.find(' ');
+    count = spaceCharIndex == string::npos ? 1 : 2;
+
+    for (int id = 0; id < NUM_GOODS; id++) {
+        if (good.compare(0, spaceCharIndex, GOOD_NAMES[id]) == 0)
+            return GoodId(id);
+    }
+
+    count = 0;
+    return NO_GOOD;
+}
+
+/**
+ * Gets the fewest of a good that scores as much as any number of it. Holding more than that
+ * changes nothing, with or without wilds.
+ */
+static int getSaturation(GoodId good) {
+    int count = 0;
+    while (GOOD_POINTS[good][count] < GOOD_POINTS[good][MAX_SCORED_GOODS])
+        count++;
+    return count;
+}
+
+/**
+ * Finds the best score by trying every way to split the wilds between the goods, from the
+ * given good on. Wilds can only be added to goods the player owns.
+ *
+ * @param counts How many of each good.
+ * @param good The first good left to split the wilds over.
+ * @param wilds The number of wilds left.
+ * @return The best score of the goods from the given good on.
+ */
+static int solveBestPoints(const int* counts, int good, int wilds) {
+    if (good == GOOD_WILD)
+        return 0;
+
+    int maxWilds = counts[good] > 0 ? wilds : 0;
+    int best = 0;
+
+    for (int used = 0; used <= maxWilds; used++)
+        best = max(best, getGoodPoints(GoodId(good), counts[good] + used) + solveBestPoints(counts, good + 1, wilds - used));
+
+    return best;
+}
+
+/**
+ * The best score of every hand of goods, with up to MAX_TABLE_WILDS wilds. Each count is
+ * clamped at its saturation, which keeps the table at about 60 thousand one byte entries.
+ */
+class BestPointsTable {
+    int* saturation;
+    vector<uint8_t>* points;
+
+public:
+    BestPointsTable(): saturation(new int[GOOD_WILD]), points(new vector<uint8_t>()) {
+        size_t size = MAX_TABLE_WILDS + 1;
+        for (int good = 0; good < GOOD_WILD; good++) {
+            saturation[good] = getSaturation(GoodId(good));
+            size *= saturation[good] + 1;
+        }
+
+        points->resize(size);
+
+        int counts[GOOD_WILD] = {};
+        for (size_t index = 0; index < size; index += MAX_TABLE_WILDS + 1) {
+            for (int wilds = 0; wilds <= MAX_TABLE_WILDS; wilds++)
+                (*points)[index + wilds] = uint8_t(solveBestPoints(counts, 0, wilds));
+
+            // Step to the next hand, the last good counting fastest.
+            for (int good = GOOD_WILD - 1; good >= 0 && ++counts[good] > saturation[good]; good--)
+                counts[good] = 0;
+        }
+    }
+
+    BestPointsTable(const BestPointsTable&) = delete;
+    BestPointsTable& operator=(const BestPointsTable&) = delete;
+
+    ~BestPointsTable() {
+        delete[] saturation;
+        delete points;
+
+        saturation = nullptr;
+        points = nullptr;
+    }
+
+    int find(const GoodsCount& goods) const {
+        size_t index = 0;
+        for (int good = 0; good < GOOD_WILD; good++)
+            index = index * (saturation[good] + 1) + min(int(goods[good]), saturation[good]);
+
+        return (*points)[index * (MAX_TABLE_WILDS + 1) + goods[GOOD_WILD]];
+    }
+};
+
+/**
+ * Gets the best score of a hand of goods, adding its wild goods wherever they score the most.
+ * Hands with up to MAX_TABLE_WILDS wilds are looked up in a table built the first time this is
+ * called. Hands with more are solved on the spot.
+ *
+ * @param goods How many of each good, wilds included.
+ * @return The victory points.
+ */
+int getBestGoodsPoints(const GoodsCount& goods) {
+    static const BestPointsTable table;
+
+    if (goods[GOOD_WILD] <= MAX_TABLE_WILDS)
+        return table.find(goods);
+
+    int counts[GOOD_WILD];
+    for (int good = 0; good < GOOD_WILD; good++)
+        counts[good] = goods[good];
+
+    return solveBestPoints(counts, 0, goods[GOOD_WILD]);
+}
+
+/**
+ * Adds the wild goods of a hand to the goods where they score the most. Each wild goes to the
+ * first good, in GoodId order, that still leaves the best score within reach.
+ *
+ * @param goods How many of each good, wilds included.
+ * @return The goods with the wilds added, and no wilds left. Wilds are lost if the hand has no
+ * other goods.
+ */
+GoodsCount assignWilds(const GoodsCount& goods) {
+    GoodsCount assigned = goods;
+
+    while (assigned[GOOD_WILD] > 0) {
+        int best = getBestGoodsPoints(assigned);
+        assigned[GOOD_WILD]--;
+
+        for (int good = 0; good < GOOD_WILD; good++) {
+            if (assigned[good] == 0)
+                continue;
+
+            assigned[good]++;
+            if (getBestGoodsPoints(assigned) == best)
+                break;
+            assigned[good]--;
+        }
+    }
+
+    return assigned;
+}
@@ -0,0 +1,62 @@
+#ifndef GOODS_H
+#define GOODS_H
+
+#include <array>
+#include <stdint.h>
+#include <string>
+
+using namespace std;
+
+const string WOOD = "WOOD";
+const string IRON = "IRON";
+const string CARROT = "CARROT";
+const string GEM = "GEM";
+const string STONE = "STONE";
+const string WILD = "WILD";
+const string NONE = "NONE";
+
+// The goods, interned so that counting them doesn't go through their names.
+enum GoodId : uint8_t { GOOD_WOOD, GOOD_IRON, GOOD_CARROT, GOOD_GEM, GOOD_STONE, GOOD_WILD, NO_GOOD };
+const int NUM_GOODS = 6;
+
+// How many of each good a player holds, indexed by GoodId.
+typedef array<uint8_t, NUM_GOODS> GoodsCount;
+
+// Victory points for holding 0 to 13 of a good. Holding more scores the same as holding 13.
+const int MAX_SCORED_GOODS = 13;
+constexpr uint8_t GOOD_POINTS[NUM_GOODS][MAX_SCORED_GOODS + 1] = {
+    // 0 1 2 3 4 5 6 7 8 9 0 1 2 3
+    {0,0,1,1,2,3,5,5,5,5,5,5,5,5},  // WOOD
+    {0,0,1,1,2,2,3,5,5,5,5,5,5,5},  // IRON
+    {0,0,0,1,1,2,2,3,5,5,5,5,5,5},  // CARROT
+    {0,1,2,3,5,5,5,5,5,5,5,5,5,5},  // GEM
+    {0,0,1,2,3,5,5,5,5,5,5,5,5,5},  // STONE
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0}   // WILD scores nothing on its own.
+};
+
+/**
+ * Gets the victory points for holding a number of one good.
+ */
+constexpr int getGoodPoints(GoodId good, int count) {
+    return GOOD_POINTS[good][count < MAX_SCORED_GOODS ? count : MAX_SCORED_GOODS];
+}
+
+/**
+ * Gets the victory points for a set of goods. Wild goods have to be added to the other goods
+ * first; on their own they score nothing.
+ */
+constexpr int getGoodsPoints(const GoodsCount& goods) {
+    return getGoodPoints(GOOD_WOOD, goods[GOOD_WOOD]) + getGoodPoints(GOOD_IRON, goods[GOOD_IRON])
+         + getGoodPoints(GOOD_CARROT, goods[GOOD_CARROT]) + getGoodPoints(GOOD_GEM, goods[GOOD_GEM])
+         + getGoodPoints(GOOD_STONE, goods[GOOD_STONE]);
+}
+
+// The most wild goods the table of best scores is built for. The deck has three WILD cards.
+const int MAX_TABLE_WILDS = 3;
+
+const string& getGoodName(GoodId good);
+GoodId parseGood(const string& good, int& count);
+int getBestGoodsPoints(const GoodsCount& goods);
+GoodsCount assignWilds(const GoodsCount& goods);
+
+#endif
@@ -0,0 +1,363 @@
+#include "HeadlessGame.h"
+#include "MapLoader.h"
+#include "PlayerStrategies.h"
+#include "util/MapUtil.h"
+
+#include <sstream>
+
+/**
+ * Gets the name of a tie breaker, as it is written in records.
+ */
+string getTieBreakerName(TieBreaker tieBreaker) {
+    static const string NAMES[NUM_TIE_BREAKERS] = { "score", "coins", "armies", "regions", "draw" };
+    return NAMES[tieBreaker];
+}
+
+/**
+ * Finds the first of the tie breakers of the game rules that tells two players apart: the score,
+ * then the coins, then the armies on the board, then the controlled regions.
+ *
+ * @param otherPlayer The player to compare with.
+ * @return The tie breaker, or NOT_BROKEN if the players are even on all of them.
+ */
+TieBreaker PlayerResult::getTieBreaker(const PlayerResult& otherPlayer) const {
+    if (score != otherPlayer.score)
+        return BY_SCORE;
+    if (coins != otherPlayer.coins)
+        return BY_COINS;
+    if (armies != otherPlayer.armies)
+        return BY_ARMIES;
+    if (regions != otherPlayer.regions)
+        return BY_REGIONS;
+
+    return NOT_BROKEN;
+}
+
+/**
+ * Compares two players with the tie breakers of the game rules.
+ *
+ * @param otherPlayer The player to compare with.
+ * @return A boolean representing if this player is ahead of the other player.
+ */
+bool PlayerResult::isAhead(const PlayerResult& otherPlayer) const {
+    switch (getTieBreaker(otherPlayer)) {
+        case BY_SCORE:
+            return score > otherPlayer.score;
+        case BY_COINS:
+            return coins > otherPlayer.coins;
+        case BY_ARMIES:
+            return armies > otherPlayer.armies;
+        case BY_REGIONS:
+            return regions > otherPlayer.regions;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Checks if a player shares the lead of a game that ended in a draw.
+ *
+ * @param player The index of the player.
+ * @return A boolean representing if the game is a draw and no one is ahead of the player.
+ */
+bool GameResult::isInDraw(int player) const {
+    if (winner != NO_WINNER)
+        return false;
+
+    for (const PlayerResult& otherPlayer : players) {
+        if (otherPlayer.isAhead(players[player]))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Gets the column names of the records written by toRecord().
+ */
+string GameResult::getHeader() {
+    return "seed,rounds,winner,decided,player,strategy,score,regions,continents,goods,coins,armies,cities,cards";
+}
+
+/**
+ * Writes the result as comma separated records, one line per player. Players and the winner are
+ * numbered from 1 in the order the players were created, and a winner of 0 is a draw.
+ *
+ * @return The records, or a line with the error if the game isn't valid.
+ */
+string GameResult::toRecord() const {
+    if (!isValid)
+        return "error," + error + "\n";
+
+    ostringstream record;
+
+    for (size_t i = 0; i < players.size(); i++) {
+        const PlayerResult& player = players[i];
+
+        record << seed << ',' << numRounds << ',' << winner + 1 << ',' << getTieBreakerName(decidedBy) << ',' << i + 1 << ','
+               << player.strategy << ',' << player.score << ',' << player.regions << ','
+               << player.continents << ',' << player.goods << ',' << player.coins << ','
+               << player.armies << ',' << player.cities << ',' << player.cards << '\n';
+    }
+
+    return record.str();
+}
+
+/**
+ * Mutes cout until the MutedConsole is destroyed.
+ */
+MutedConsole::MutedConsole(): previousState(new ios::iostate(cout.rdstate())) {
+    cout.setstate(ios::failbit);
+}
+
+/**
+ * Destructor
+ *
+ * Gives cout back the state it had before it was muted.
+ */
+MutedConsole::~MutedConsole() {
+    cout.clear(*previousState);
+
+    delete previousState;
+    previousState = nullptr;
+}
+
+/**
+ * Initializes a HeadlessGameEngine object playing a new game of its own. The game is played on
+ * the map of the settings if there is one, else on the map file of the settings once the game
+ * is set up.
+ *
+ * @param gameSettings The settings of the game. The engine keeps a copy.
+ */
+HeadlessGameEngine::HeadlessGameEngine(const GameSettings& gameSettings):
+    GameEngine(gameSettings.map),
+    settings(new GameSettings(gameSettings)),
+    result(new GameResult()),
+    currentPlayer(nullptr),
+    currentCard(nullptr) {}
+
+/**
+ * Destructor
+ */
+HeadlessGameEngine::~HeadlessGameEngine() {
+    delete settings;
+    delete result;
+
+    settings = nullptr;
+    result = nullptr;
+    currentPlayer = nullptr;
+    currentCard = nullptr;
+}
+
+/**
+ * Sets up, plays and scores a whole game with cout muted. Games played on several threads at once
+ * are muted once around all of them instead (see TournamentRunner).
+ *
+ * @param gameSettings The settings of the game.
+ * @return The result of the game.
+ */
+GameResult HeadlessGameEngine::play(const GameSettings& gameSettings) {
+    MutedConsole mutedConsole;
+    HeadlessGameEngine engine(gameSettings);
+
+    if (engine.setUpGame())
+        engine.runGame();
+
+    return *engine.getResult();
+}
+
+/**
+ * Sets up the game from the settings: seeds it, loads the map, creates the players, fills the
+ * game hand and starts the game on the start region.
+ *
+ * @return A boolean representing if the game could be set up. If it couldn't, the result holds
+ * the reason.
+ */
+bool HeadlessGameEngine::setUpGame() {
+    GameContext* context = getContext();
+
+    result->seed = settings->seed;
+    result->numRounds = settings->numRounds;
+
+    if (settings->numRounds < 0 || settings->numRounds > MAX_ROUNDS) {
+        result->error = "a game lasts 0 to " + to_string(MAX_ROUNDS) + " rounds";
+        return false;
+    }
+
+    context->setIsTournament(true);
+    context->setSeed(settings->seed);
+    context->setMapFile(settings->mapFile);
+    context->setRecorder(settings->recorder);
+
+    if (!loadMap() || !createPlayers())
+        return false;
+
+    context->getHand()->fill();
+
+    string startVertex = settings->startVertex;
+    if (startVertex.empty()) {
+        RegionId start = RegionId(context->getRandom()->nextBelow(uint32_t(context->getMap()->getNumRegions())));
+        startVertex = context->getMap()->getVertex(start)->getKey();
+    }
+
+    if (!StartUpGameEngine(context).startGame(startVertex)) {
+        result->error = "no region " + startVertex + " on the map";
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Plays the rounds of the game, then records its result.
+ */
+void HeadlessGameEngine::runGame() {
+    for (int i = 0; i < settings->numRounds; i++)
+        playTurn();
+
+    if (settings->recorder)
+        settings->recorder->recordEndOfGame();
+
+    recordResult();
+}
+
+/**
+ * Plays the turn of the next player: they buy a card from the game hand, perform its action,
+ * and a card from the deck takes its place. runGame() plays every turn of the game, but a search
+ * can play them one at a time and take them back (see GameContext::snapshot()).
+ */
+void HeadlessGameEngine::playTurn() {
+    GameContext* context = getContext();
+    queue<Player*>* nextTurn = context->getNextTurnQueue();
+
+    currentPlayer = nextTurn->front();
+    nextTurn->pop();
+    nextTurn->push(currentPlayer);
+
+    int startCoins = currentPlayer->getCoins();
+    currentCard = context->getHand()->exchange(currentPlayer);
+    context->addCoinsToSupply(startCoins - currentPlayer->getCoins());
+
+    currentPlayer->performCardAction(currentCard->getCardAction(), context->getPlayers());
+    context->getHand()->drawCardFromDeck();
+
+    if (settings->recorder)
+        settings->recorder->recordEndOfTurn(context);
+
+    Notify();
+}
+
+//PRIVATE
+/**
+ * Loads the map file of the settings, unless the game shares an already loaded map.
+ *
+ * @return A boolean representing if the game has a valid map.
+ */
+bool HeadlessGameEngine::loadMap() {
+    if (settings->map)
+        return true;
+
+    MapLoader loader(settings->mapFile);
+
+    if (!loader.generateMap(getContext()->getMap()) || !validateMap(getContext()->getMap())) {
+        result->error = "invalid map " + settings->mapFile;
+        return false;
+    }
+
+    return true;
+}
+
+//PRIVATE
+/**
+ * Creates the players with the strategies of the settings. Players are named after the order
+ * they are created in, and take the colours in the order they are offered to human players.
+ *
+ * @return A boolean representing if every strategy is a computer strategy and there are 2 to 4
+ * players, as in a tournament.
+ */
+bool HeadlessGameEngine::createPlayers() {
+    GameContext* context = getContext();
+    const int numPlayers = int(settings->strategies.size());
+
+    if (numPlayers < 2 || numPlayers > 4) {
+        result->error = "a game has 2 to 4 players";
+        return false;
+    }
+
+    context->setNumPlayers(numPlayers);
+
+    for (int i = 0; i < numPlayers; i++) {
+        Strategy* strategy;
+
+        if (settings->strategies[i] == GREEDY) {
+            strategy = new GreedyStrategy();
+        } else if (settings->strategies[i] == MODERATE) {
+            strategy = new ModerateStrategy();
+        } else {
+            result->error = "no computer strategy " + settings->strategies[i];
+            return false;
+        }
+
+        string colour = context->getColours()->front();
+        context->getColours()->pop_front();
+
+        context->addPlayer(new Player("Player" + to_string(i + 1), colour, strategy));
+    }
+
+    return true;
+}
+
+//PRIVATE
+/**
+ * Scores every player and finds the winner.
+ *
+ * The scores come from the same counts as the live victory points of the StatsObserver: one
+ * pass over the board for the regions, the continent owners kept by the map and the best use of
+ * the wild cards for the goods.
+ */
+void HeadlessGameEngine::recordResult() {
+    GameContext* context = getContext();
+    GameMap* map = context->getMap();
+    vector<int> ownedRegions = map->getArmyMatrix()->countOwnedRegions();
+
+    for (const string& name : *context->getPlayerOrder()) {
+        Player* player = context->getPlayers()->at(name);
+        PlayerId playerId = player->getId();
+        PlayerResult playerResult;
+
+        playerResult.strategy = player->getStrategy()->getType();
+        playerResult.regions = playerId < ownedRegions.size() ? ownedRegions[playerId] : 0;
+        playerResult.continents = map->getNumContinentsOwnedBy(playerId);
+        playerResult.goods = getBestGoodsPoints(player->getGoodsCount());
+        playerResult.score = playerResult.regions + playerResult.continents + playerResult.goods;
+        playerResult.coins = player->getCoins();
+        playerResult.armies = START_ARMIES - player->getArmies();
+        playerResult.cities = START_CITIES - player->getCities();
+        playerResult.cards = int(player->getHand()->size());
+
+        result->players.push_back(playerResult);
+    }
+
+    // The winner is ahead of every other player, and the closest of them says which tie breaker
+    // decided the game. If no one is ahead of everyone, it's a draw.
+    int leader = 0;
+    for (int i = 1; i < int(result->players.size()); i++) {
+        if (result->players[i].isAhead(result->players[leader]))
+            leader = i;
+    }
+
+    result->winner = leader;
+    result->decidedBy = BY_SCORE;
+    for (int i = 0; i < int(result->players.size()); i++) {
+        if (i == leader)
+            continue;
+
+        TieBreaker tieBreaker = result->players[leader].getTieBreaker(result->players[i]);
+        result->decidedBy = max(result->decidedBy, tieBreaker);
+
+        if (tieBreaker == NOT_BROKEN)
+            result->winner = GameResult::NO_WINNER;
+    }
+
+    result->isValid = true;
+}
@@ -0,0 +1,125 @@
+#ifndef HEADLESS_GAME_H
+#define HEADLESS_GAME_H
+
+#include "GameEngine.h"
+
+// Rounds a game can last before the deck runs out of cards to refill the game hand.
+const int MAX_ROUNDS = DECK_SIZE - MARKET_SIZE;
+
+/**
+ * Everything a game played without a console is told up front, instead of asking for it.
+ */
+struct GameSettings {
+    string mapFile;             // A map file in the maps/ directory, used when there's no map.
+    GameMap* map;               // A map loaded once and shared by many games. Not owned.
+    vector<string> strategies;  // GREEDY or MODERATE, one per player, in turn order.
+    string startVertex;         // The key of the start region. Drawn from the seed when empty.
+    uint64_t seed;
+    int numRounds;
+    GameRecorder* recorder;     // Records the game when set. Not owned, and not shared by games.
+
+    GameSettings(): map(nullptr), seed(0), numRounds(NUM_ROUNDS), recorder(nullptr) {}
+};
+
+/**
+ * The rules that break a tie between players, in the order they are tried. A tie that none of
+ * them break is a draw.
+ */
+enum TieBreaker : uint8_t { BY_SCORE, BY_COINS, BY_ARMIES, BY_REGIONS, NOT_BROKEN };
+const int NUM_TIE_BREAKERS = 5;
+
+string getTieBreakerName(TieBreaker tieBreaker);
+
+/**
+ * How one player finished a game.
+ */
+struct PlayerResult {
+    string strategy;
+    int score;
+    int regions;
+    int continents;
+    int goods;
+    int coins;
+    int armies;
+    int cities;
+    int cards;
+
+    TieBreaker getTieBreaker(const PlayerResult& otherPlayer) const;
+    bool isAhead(const PlayerResult& otherPlayer) const;
+};
+
+/**
+ * How a game finished, with the players in the order they were created. The winner is found
+ * with the tie breakers of the game rules, and is NO_WINNER when they can't break the tie.
+ * A game that couldn't be set up isn't valid, and only has an error.
+ */
+struct GameResult {
+    static const int NO_WINNER = -1;
+
+    bool isValid;
+    string error;
+    uint64_t seed;
+    int numRounds;
+    int winner;
+    TieBreaker decidedBy;
+    vector<PlayerResult> players;
+
+    GameResult(): isValid(false), seed(0), numRounds(0), winner(NO_WINNER), decidedBy(NOT_BROKEN) {}
+
+    bool isInDraw(int player) const;
+
+    static string getHeader();
+    string toRecord() const;
+};
+
+/**
+ * Mutes cout for as long as it lives. Whatever is written to it is dropped before it is even
+ * formatted, so a muted game doesn't pay for the messages it would print.
+ *
+ * cout is shared by the whole process, so games played on several threads must be muted once,
+ * around all of them.
+ */
+class MutedConsole {
+    ios::iostate* previousState;
+
+public:
+    MutedConsole();
+    MutedConsole(MutedConsole* mutedConsole) = delete;
+    MutedConsole& operator=(MutedConsole& mutedConsole) = delete;
+    ~MutedConsole();
+};
+
+/**
+ * Plays a tournament game from a GameSettings, for simulations that play games by the thousand.
+ *
+ * The engine never reads stdin: the map, the players and the start region come from the
+ * settings, and the bids and every choice after them come from the computer strategies and the
+ * seed. The game plays its rounds and ends with a GameResult instead of a winner's table.
+ */
+class HeadlessGameEngine: public GameEngine {
+    GameSettings* settings;
+    GameResult* result;
+    Player* currentPlayer;
+    const CardInfo* currentCard;
+
+public:
+    HeadlessGameEngine(const GameSettings& gameSettings);
+    ~HeadlessGameEngine();
+
+    static GameResult play(const GameSettings& gameSettings);
+
+    bool setUpGame();
+    void runGame();
+    void playTurn();
+
+    GameResult* getResult() { return result; }
+    Player* getCurrentPlayer() { return currentPlayer; }
+    const CardInfo* getCurrentCard() { return currentCard; }
+
+private:
+    bool loadMap();
+    bool createPlayers();
+    void recordResult();
+};
+
+#endif
@@ -5,15 +5,14 @@ GameMap *GameMap::mapInstance = 0;
 
 /**
  * Default Constructor
+ *
+ * The region has no pieces, no ID and no draft. Used for the regions of a map filled from a
+ * topology (see GameMap::loadTopology()), which get their ID and map from it.
  */
 Vertex::Vertex():
-    name(new string("None")),
-    vertexKey(new string("None")),
-    owners(new set<Player*>()),
-    continent(new string("None")),
-    armies(new unordered_map<PlayerEntry*, int>()),
-    cities(new unordered_map<PlayerEntry*, int>()),
-    edges(new vector<Edge>()) {}
+    id(NO_REGION),
+    map(nullptr),
+    draft(nullptr) {}
 
 /**
  * Initializes a Vertex object that represents a region on a GameMap object.
@@ -23,47 +22,62 @@ Vertex::Vertex():
  * @param continent The name of the continent where the region sits.
  */
 Vertex::Vertex(string aName, string key, string continent):
-    name(new string(aName)),
-    vertexKey(new string(key)),
-    owners(new set<Player*>()),
-    continent(new string(continent)),
-    armies(new unordered_map<PlayerEntry*, int>()),
-    cities(new unordered_map<PlayerEntry*, int>()),
-    edges(new vector<Edge>()) {}
+    id(NO_REGION),
+    map(nullptr),
+    draft(new RegionDraft())
+{
+    draft->name = aName;
+    draft->key = key;
+    draft->continent = continent;
+}
 
 /**
  * Copy Constructor
+ *
+ * The copy isn't on a map, so it keeps the pieces and the owner of the region in its draft.
  */
 Vertex::Vertex(Vertex* vertex){
-    name = new string(vertex->getName());
-    vertexKey = new string(vertex->getKey());
-    continent = new string(vertex->getContinent());
-    owners = new set<Player*>(*vertex->getOwners());
-    armies = new unordered_map<PlayerEntry*, int>(*vertex->getArmies());
-    cities = new unordered_map<PlayerEntry*, int>(*vertex->getCities());
-    edges = new vector<Edge>(*vertex->getEdges());
+    id = vertex->getId();
+    map = nullptr;
+    draft = new RegionDraft();
+    draft->name = vertex->getName();
+    draft->key = vertex->getKey();
+    draft->continent = vertex->getContinent();
+    if (vertex->draft)
+        draft->edges = vertex->draft->edges;
+
+    for(PlayerId player = 0; player < MAX_PLAYERS; player++) {
+        draft->armies[player] = vertex->getArmiesOf(player);
+        draft->cities[player] = vertex->getCitiesOf(player);
+    }
+    draft->owner = vertex->getOwner();
+    draft->ownerMargin = vertex->getOwnerMargin();
 }
 
 /**
  * Assignment operator
+ *
+ * Like the copy constructor, the pieces and the owner of the region are copied into the draft.
  */
 Vertex& Vertex::operator=(Vertex& vertex) {
     if (&vertex != this) {
-        delete name;
-        delete vertexKey;
-        delete owners;
-        delete continent;
-        delete armies;
-        delete cities;
-        delete edges;
-
-        name = new string(vertex.getName());
-        vertexKey = new string(vertex.getKey());
-        continent = new string(vertex.getContinent());
-        owners = new set<Player*>(*vertex.getOwners());
-        armies = new unordered_map<PlayerEntry*, int>(*vertex.getArmies());
-        cities = new unordered_map<PlayerEntry*, int>(*vertex.getCities());
-        edges = new vector<Edge>(*vertex.getEdges());
+        RegionDraft* newDraft = new RegionDraft();
+        newDraft->name = vertex.getName();
+        newDraft->key = vertex.getKey();
+        newDraft->continent = vertex.getContinent();
+        if (vertex.draft)
+            newDraft->edges = vertex.draft->edges;
+
+        for(PlayerId player = 0; player < MAX_PLAYERS; player++) {
+            newDraft->armies[player] = vertex.getArmiesOf(player);
+            newDraft->cities[player] = vertex.getCitiesOf(player);
+        }
+        newDraft->owner = vertex.getOwner();
+        newDraft->ownerMargin = vertex.getOwnerMargin();
+
+        delete draft;
+        draft = newDraft;
+        id = vertex.getId();
     }
     return *this;
 }
@@ -72,21 +86,43 @@ Vertex& Vertex::operator=(Vertex& vertex) {
  * Destructor
  */
 Vertex::~Vertex(){
-    delete name;
-    delete vertexKey;
-    delete owners;
-    delete continent;
-    delete armies;
-    delete cities;
-    delete edges;
+    delete draft;
+
+    draft = nullptr;
+    map = nullptr;
+}
+
+/**
+ * Gets the name of the region, from its draft if it has one and else from the map topology.
+ */
+const string& Vertex::getName() {
+    if (draft)
+        return draft->name;
+
+    MapTopology* graph = map->getTopology();
+    return graph->getName(id);
+}
+
+/**
+ * Gets the key of the region, from its draft if it has one and else from the map topology.
+ */
+const string& Vertex::getKey() {
+    if (draft)
+        return draft->key;
+
+    MapTopology* graph = map->getTopology();
+    return graph->getKey(id);
+}
 
-    name = nullptr;
-    vertexKey = nullptr;
-    owners = nullptr;
-    continent = nullptr;
-    armies = nullptr;
-    cities = nullptr;
-    edges = nullptr;
+/**
+ * Gets the continent of the region, from its draft if it has one and else from the map topology.
+ */
+const string& Vertex::getContinent() {
+    if (draft)
+        return draft->continent;
+
+    MapTopology* graph = map->getTopology();
+    return graph->getContinent(id);
 }
 
 /**
@@ -96,79 +132,211 @@ Vertex::~Vertex(){
  * @param isWaterEdge A boolean representing if the edge is a water edge.
  */
 void Vertex::addEdge(Vertex* endVertex, bool isWaterEdge) {
-    edges->push_back(Edge(endVertex, isWaterEdge));
+    if (draft)
+        draft->edges.push_back(Edge(endVertex, isWaterEdge));
 }
 
 /**
  * Prints a list to the console of the armies and cities currently on the vertex.
  */
 void Vertex::print() {
-    string owner = getRegionOwner();
-
-    printf("%10s %s : %s\n", ("{ " + owner + " }").c_str(), vertexKey->c_str(), name->c_str());
-
-    int numArmies, numCities;
-    PlayerEntry* player;
-    unordered_map<PlayerEntry*, int>::iterator it;
-
-    for(it = armies->begin(); it != armies->end(); ++it) {
-        numCities = 0;
-        numArmies = it->second;
-        player = it->first;
-        if (cities->find(player) != cities->end())
-            numCities = cities->find(player)->second;
-        if (numArmies > 0 || numCities > 0) {
-            if (*vertexKey == GameMap::instance()->getStartVertex()->getKey())
-                printf("\t\t%-10s %10s Armies: %-5d Cities: %d [ START ]\n", player->first.c_str(), ("[ " + player->second + " ]").c_str(), numArmies, numCities);
-            else
-                printf("\t\t%-10s %10s Armies: %-5d Cities: %d\n", player->first.c_str(), ("[ " + player->second + " ]").c_str(), numArmies, numCities);
-        }
-    }
+    Player* ownerPlayer = map ? map->getPlayer(getOwner()) : nullptr;
+    string ownerName = ownerPlayer ? ownerPlayer->getName() : "";
 
-    for (it = cities->begin(); it != cities->end(); ++it) {
-        player = it->first;
-
-        // Vertex has 0 armies but at least one city belonging to Player
-        if (armies->find(player) == armies->end()) {
-            numArmies = 0;
-            numCities = it->second;
-            if (*vertexKey == GameMap::instance()->getStartVertex()->getKey())
-                printf("\t\t%-10s %10s Armies: %-5d Cities: %d [ START ]\n", player->first.c_str(), ("[ " + player->second + " ]").c_str(), numArmies, numCities);
-            else
-                printf("\t\t%-10s %10s Armies: %-5d Cities: %d\n", player->first.c_str(), ("[ " + player->second + " ]").c_str(), numArmies, numCities);
-        }
+    char vertexbuff[256];
+    snprintf(vertexbuff, sizeof(vertexbuff), "%10s %s : %s", ("{ " + ownerName + " }").c_str(), getKey().c_str(), getName().c_str());
+    cout << vertexbuff << "\n";
+
+    bool isStart = map && map->getStartVertex() == this;
+
+    for(PlayerId player = 0; player < MAX_PLAYERS; player++) {
+        int numArmies = getArmiesOf(player);
+        int numCities = getCitiesOf(player);
+        if (numArmies == 0 && numCities == 0)
+            continue;
+
+        Player* piecesOwner = map ? map->getPlayer(player) : nullptr;
+        string playerName = piecesOwner ? piecesOwner->getName() : "Player " + to_string(player);
+        string playerColour = piecesOwner ? piecesOwner->getColour() : "";
+
+        snprintf(vertexbuff, sizeof(vertexbuff), "\t\t%-10s %10s Armies: %-5d Cities: %d", playerName.c_str(), ("[ " + playerColour + " ]").c_str(), numArmies, numCities);
+        cout << vertexbuff << (isStart ? " [ START ]\n" : "\n");
     }
 
     cout << endl;
 }
 
 /**
- * Gets the owner of the region, if any.
+ * Gets the number of armies a player has on the region, from the army matrix of the map, or
+ * from the draft of the region while the map has no matrix.
+ *
+ * @param player The ID of the player.
+ * @return The number of armies.
+ */
+int Vertex::getArmiesOf(PlayerId player) {
+    ArmyMatrix* matrix = getArmyMatrix();
+    if (matrix)
+        return player < matrix->getNumSlots() ? matrix->getArmies(player, id) : 0;
+    return draft && player < MAX_PLAYERS ? draft->armies[player] : 0;
+}
+
+/**
+ * Gets the number of cities a player has on the region, from the army matrix of the map, or
+ * from the draft of the region while the map has no matrix.
+ *
+ * @param player The ID of the player.
+ * @return The number of cities.
+ */
+int Vertex::getCitiesOf(PlayerId player) {
+    ArmyMatrix* matrix = getArmyMatrix();
+    if (matrix)
+        return player < matrix->getNumSlots() ? matrix->getCities(player, id) : 0;
+    return draft && player < MAX_PLAYERS ? draft->cities[player] : 0;
+}
+
+/**
+ * Gets the owner of the region. The owner is the player with the most armies and cities combined
+ * on the region. If the highest count is shared, no one owns the region.
+ *
+ * @return The ID of the owner, or NO_PLAYER.
+ */
+PlayerId Vertex::getOwner() {
+    ArmyMatrix* matrix = getArmyMatrix();
+    if (matrix)
+        return matrix->getOwner(id);
+    return draft ? draft->owner : NO_PLAYER;
+}
+
+/**
+ * Gets how many pieces the owner of the region is ahead of the runner up.
+ *
+ * @return The margin, or 0 when the region has no owner.
+ */
+int Vertex::getOwnerMargin() {
+    ArmyMatrix* matrix = getArmyMatrix();
+    if (matrix)
+        return matrix->getOwnerMargin(id);
+    return draft ? draft->ownerMargin : 0;
+}
+
+/**
+ * Sets the number of armies a player has on the region and updates the owner of the region.
+ *
+ * @param player The ID of the player.
+ * @param numArmies The new number of armies.
+ */
+void Vertex::setArmies(PlayerId player, int numArmies) {
+    if (player >= MAX_PLAYERS)
+        return;
+
+    PlayerId previousOwner = getOwner();
+    ArmyMatrix* matrix = getArmyMatrix();
+    if (matrix)
+        matrix->setArmies(player, id, numArmies);
+    else if (draft)
+        draft->armies[player] = max(numArmies, 0);
+
+    updateOwner(previousOwner);
+}
+
+/**
+ * Sets the number of cities a player has on the region and updates the owner of the region.
+ *
+ * @param player The ID of the player.
+ * @param numCities The new number of cities.
+ */
+void Vertex::setCities(PlayerId player, int numCities) {
+    if (player >= MAX_PLAYERS)
+        return;
+
+    PlayerId previousOwner = getOwner();
+    ArmyMatrix* matrix = getArmyMatrix();
+    if (matrix)
+        matrix->setCities(player, id, numCities);
+    else if (draft)
+        draft->cities[player] = max(numCities, 0);
+
+    updateOwner(previousOwner);
+}
+
+/**
+ * Detects if any player has an army or a city on the region.
  *
- * @return The owner of the region. Returns an empty string if no one owns it.
+ * @return A boolean representing if the region has pieces on it.
  */
-string Vertex::getRegionOwner() {
-    unordered_map<PlayerEntry*, int>::iterator it;
-    int highestCount = 0;
-    string owner = "";
+bool Vertex::hasPieces() {
+    for(PlayerId player = 0; player < MAX_PLAYERS; player++) {
+        if (getArmiesOf(player) > 0 || getCitiesOf(player) > 0)
+            return true;
+    }
+    return false;
+}
 
-    for(it = armies->begin(); it != armies->end(); ++it) {
-        int numArmies = it->second;
-        int numCities = 0;
+/**
+ * Removes every army and city from the draft of the region without telling the map. Used by
+ * GameMap::resetPieces(), which clears the army matrix itself.
+ */
+void Vertex::clearPieces() {
+    if (!draft)
+        return;
 
-        if (cities->find(it->first) != cities->end())
-            numCities = cities->find(it->first)->second;
+    draft->armies.fill(0);
+    draft->cities.fill(0);
+    draft->owner = NO_PLAYER;
+    draft->ownerMargin = 0;
+}
 
-        int combinedCount = numArmies + numCities;
+//PRIVATE
+/**
+ * Gets the army matrix the pieces on the region live in.
+ *
+ * @return A pointer to the matrix of the map, or nullptr while the map has no topology.
+ */
+ArmyMatrix* Vertex::getArmyMatrix() {
+    return map ? map->armyMatrix : nullptr;
+}
 
-        if (combinedCount > highestCount) {
-            highestCount = combinedCount;
-            owner = it->first->first;
-        } else if (combinedCount == highestCount) {
-            owner = "";
+//PRIVATE
+/**
+ * Recomputes the owner of the region after its armies or cities changed.
+ *
+ * The owner is the player with the most armies and cities combined on the region. If the
+ * highest count is shared, no one owns the region. The margin is how many pieces the owner
+ * is ahead of the runner up, and is 0 when the region has no owner. The army matrix computes
+ * them itself, and a draft gets the same rule here.
+ *
+ * The map the region belongs to is only told when the owner actually changes.
+ *
+ * @param previousOwner The ID of the owner before the change.
+ */
+void Vertex::updateOwner(PlayerId previousOwner) {
+    ArmyMatrix* matrix = getArmyMatrix();
+
+    if (matrix)
+        matrix->updateOwner(id);
+    else if (draft) {
+        PlayerId leader = NO_PLAYER;
+        int highestCount = 0;
+        int secondCount = 0;
+
+        for(PlayerId player = 0; player < MAX_PLAYERS; player++) {
+            int combinedCount = draft->armies[player] + draft->cities[player];
+
+            if (combinedCount > highestCount) {
+                secondCount = highestCount;
+                highestCount = combinedCount;
+                leader = player;
+            } else if (combinedCount > secondCount) {
+                secondCount = combinedCount;
+            }
         }
+
+        draft->owner = highestCount > secondCount ? leader : NO_PLAYER;
+        draft->ownerMargin = highestCount > secondCount ? highestCount - secondCount : 0;
     }
-    return owner;
+
+    if (map && getOwner() != previousOwner)
+        map->updateRegionOwner(this, previousOwner);
 }
 
 /**
@@ -177,37 +345,54 @@ string Vertex::getRegionOwner() {
 GameMap::GameMap():
     vertices(new Vertices()),
     start(new string("none")),
-    image(new string("")) {}
-
-/**
- * Copy Constructor
- */
-GameMap::GameMap(GameMap* map) {
-    vertices = new Vertices(*map->getVertices());
-    start = new string(map->getStartVertexName());
-    image = new string(map->getImage());
-}
+    image(new string("")),
+    startVertex(nullptr),
+    topology(nullptr),
+    overlay(nullptr),
+    regionTable(new vector<Vertex*>()),
+    continentTallies(new vector<RegionTally>()),
+    continentOwners(new vector<PlayerId>()),
+    roster(new vector<Player*>()),
+    armyMatrix(nullptr) {}
 
 /**
  * Deconstructor.
  */
 GameMap::~GameMap() {
-    // Delete all vertices on the map.
-    for(Vertices::iterator it = vertices->begin(); it != vertices->end(); ++it)
-        delete it->second;
+    // Delete all vertices on the map. A map filled from a topology has them in one array.
+    if (overlay)
+        delete[] overlay;
+    else
+        for(Vertices::iterator it = vertices->begin(); it != vertices->end(); ++it)
+            delete it->second;
 
     delete vertices;
     delete start;
     delete image;
+    MapTopology::release(topology);
+    delete regionTable;
+    delete continentTallies;
+    delete continentOwners;
+    delete roster;
+    delete armyMatrix;
 
     vertices = nullptr;
     start = nullptr;
     image = nullptr;
-    mapInstance = nullptr;
+    topology = nullptr;
+    overlay = nullptr;
+    regionTable = nullptr;
+    continentTallies = nullptr;
+    continentOwners = nullptr;
+    roster = nullptr;
+    armyMatrix = nullptr;
+    if (mapInstance == this)
+        mapInstance = nullptr;
 }
 
 /**
- * Returns a singleton instance of a GameMap object.
+ * Returns the shared GameMap object used by the map tools and the test drivers. A game gets its
+ * own map from its GameContext instead.
  */
 GameMap* GameMap::instance() {
     if (!mapInstance) {
@@ -234,10 +419,11 @@ bool GameMap::setStartVertex(string& startVertexKey){
     }
 
     cout << "[ MAP ] Setting start vertex. Searching for \"" << startVertexKey << "\"." << endl;
-    if (vertices->find(startVertexKey) != vertices->end()) {
+    Vertex* vertex = findVertex(startVertexKey);
+    if (vertex) {
         *start = startVertexKey;
-        startVertex = vertices->find(startVertexKey)->second;
-        cout << "[ MAP ] Start vertex is now < " << vertices->find(startVertexKey)->second->getName() << " >.\n" << endl;
+        startVertex = vertex;
+        cout << "[ MAP ] Start vertex is now < " << vertex->getName() << " >.\n" << endl;
         return true;
     }
 
@@ -245,6 +431,34 @@ bool GameMap::setStartVertex(string& startVertexKey){
     return false;
 }
 
+/**
+ * Finds a vertex from its key, using the perfect hash of the keys in the map topology.
+ *
+ * @param key The vertex key.
+ * @return A pointer to the vertex, or nullptr if the key isn't on the map.
+ */
+Vertex* GameMap::findVertex(const string& key) {
+    RegionId id = getTopology()->getId(key);
+    return id == NO_REGION ? nullptr : (*regionTable)[id];
+}
+
+/**
+ * Gives a player the next PlayerId on the map. Pieces, owners and scores on the map are all
+ * kept by PlayerId, and getPlayer() gets back to the player in constant time.
+ *
+ * @param player A pointer to the player.
+ * @return The ID of the player, or NO_PLAYER if the map already has the most players it can hold.
+ */
+PlayerId GameMap::addPlayer(Player* player) {
+    if (roster->size() == MAX_PLAYERS) {
+        cout << "[ ERROR! ] The map can't hold more than " << MAX_PLAYERS << " players." << endl;
+        return NO_PLAYER;
+    }
+
+    roster->push_back(player);
+    return PlayerId(roster->size() - 1);
+}
+
 /**
  * Sets the image string of the GameMap object. This string produces an
  * ASCII based image of the map that is printed throughout the game.
@@ -263,18 +477,27 @@ void GameMap::setImage(const string& newImage) {
  * @param key The vertex key that corresponds to the region.
  * @param name The name of the region.
  * @param continent The name of the continent the region is on.
+ * @return A pointer to the new vertex. If the key is already on the map, the existing vertex is returned.
  */
-void GameMap::addVertex(const string& key, const string& name, const string& continent) {
+Vertex* GameMap::addVertex(const string& key, const string& name, const string& continent) {
+    if (overlay) {
+        cout << "[ ERROR! ] Can't add < " << key << " >. The regions of a map filled from a topology are final.\n" << endl;
+        return findVertex(key);
+    }
+
+    pair<Vertices::iterator, bool> result = vertices->insert(pair<string, Vertex*>(key, nullptr));
 
-    if (vertices->find(key) == vertices->end()) {
+    if (result.second) {
         Vertex * vertex = new Vertex (name, key, continent);
-        typedef pair<string, Vertex*> node;
-        vertices->insert(node (key, vertex));
-        return;
+        vertex->setMap(this);
+        result.first->second = vertex;
+        invalidateTopology();
+        return vertex;
     }
 
-    Vertex* v = vertices->find(key)->second;
+    Vertex* v = result.first->second;
     cout << "[ MAP ] Vertex " << v->getName() << " on continent " << v->getContinent() << " already exists on the map.\n" << endl;
+    return v;
 }
 
 /**
@@ -285,10 +508,242 @@ void GameMap::addVertex(const string& key, const string& name, const string& con
  * @param isWaterEdge A bool representing wher the edge is over water.
  */
 void GameMap::addEdge(const string& startVertexKey, const string& endVertexKey, bool isWaterEdge) {
-    Vertex * v1 = vertices->find(startVertexKey)->second;
-    Vertex * v2 = vertices->find(endVertexKey)->second;
-    v1->addEdge(v2, isWaterEdge);
-    v2->addEdge(v1, isWaterEdge);
+    addEdge(vertices->find(startVertexKey)->second, vertices->find(endVertexKey)->second, isWaterEdge);
+}
+
+/**
+ * Creates an edge on the map between two vertices.
+ *
+ * @param startRegion A pointer to the start region.
+ * @param endRegion A pointer to the end region.
+ * @param isWaterEdge A bool representing wher the edge is over water.
+ */
+void GameMap::addEdge(Vertex* startRegion, Vertex* endRegion, bool isWaterEdge) {
+    if (overlay) {
+        cout << "[ ERROR! ] Can't add an edge to < " << startRegion->getKey() << " >. The edges of a map filled from a topology are final.\n" << endl;
+        return;
+    }
+
+    startRegion->addEdge(endRegion, isWaterEdge);
+    endRegion->addEdge(startRegion, isWaterEdge);
+    invalidateTopology();
+}
+
+/**
+ * Freezes the current regions and edges into a MapTopology object. Region IDs are
+ * assigned in key order, so the same map always produces the same IDs.
+ *
+ * MapLoader calls this once the whole map has been read. Maps built by hand get their
+ * topology built on first use instead (see getTopology()).
+ */
+void GameMap::buildTopology() {
+    vector<string> keys, names, continents;
+    vector<RawEdge> edges;
+
+    // The region IDs are about to be handed out again, so the pieces go back to the drafts first.
+    emptyArmyMatrix();
+
+    keys.reserve(vertices->size());
+    names.reserve(vertices->size());
+    continents.reserve(vertices->size());
+    regionTable->clear();
+    regionTable->reserve(vertices->size());
+
+    for(Vertices::iterator it = vertices->begin(); it != vertices->end(); ++it) {
+        it->second->setId(RegionId(regionTable->size()));
+        regionTable->push_back(it->second);
+        keys.push_back(it->first);
+        names.push_back(it->second->getName());
+        continents.push_back(it->second->getContinent());
+    }
+
+    for(Vertex* vertex : *regionTable) {
+        for(Edge& edge : vertex->getDraft()->edges) {
+            // Each edge is stored on both of its end points. Only keep one copy of it.
+            if (vertex->getId() <= edge.first->getId()) {
+                RawEdge rawEdge = { vertex->getId(), edge.first->getId(), edge.second };
+                edges.push_back(rawEdge);
+            }
+        }
+    }
+
+    MapTopology::release(topology);
+    topology = new MapTopology(keys, names, continents, edges);
+    fillArmyMatrix();
+    countContinentOwners();
+}
+
+/**
+ * Fills an empty map from a topology built elsewhere, such as a compiled map file (see
+ * CompiledMap) or another map (see shareMap()). The map only gets one array of regions holding
+ * the pieces on them. Their names, keys, continents and edges stay in the topology, which is
+ * kept as is rather than rebuilt. Regions and edges can't be added to the map after that.
+ *
+ * @param newTopology A pointer to the topology. The map takes over the caller's reference to it.
+ */
+void GameMap::loadTopology(MapTopology* newTopology) {
+    if (overlay || !vertices->empty()) {
+        cout << "[ ERROR! ] A topology can only be loaded into an empty map.\n" << endl;
+        MapTopology::release(newTopology);
+        return;
+    }
+
+    const size_t numRegions = newTopology->getNumRegions();
+    overlay = new Vertex[numRegions];
+    regionTable->resize(numRegions);
+
+    for(RegionId id = 0; id < numRegions; id++) {
+        overlay[id].setMap(this);
+        overlay[id].setId(id);
+        (*regionTable)[id] = &overlay[id];
+    }
+
+    MapTopology::release(topology);
+    topology = newTopology;
+    fillArmyMatrix();
+    countContinentOwners();
+}
+
+/**
+ * Fills an empty map with the regions of an already loaded map, for a new game on the same map.
+ * The topology isn't copied. Both maps share it, along with its distance oracle, and only the
+ * pieces on the regions belong to this map.
+ *
+ * @param loadedMap A pointer to the loaded map.
+ */
+void GameMap::shareMap(GameMap* loadedMap) {
+    loadTopology(loadedMap->getTopology()->acquire());
+    setImage(loadedMap->getImage());
+}
+
+/**
+ * Removes every army and city from the map, unsets the start vertex and forgets the players, so a
+ * new game can be played on the map without loading it again. The topology and the vertices are
+ * kept as they are.
+ */
+void GameMap::resetPieces() {
+    clearPieces();
+    roster->clear();
+}
+
+/**
+ * Removes every army and city from the map at once and unsets the start vertex. The players keep
+ * their place on the map, so the same players can start another game on it (see
+ * GameReplayer::rewind()).
+ */
+void GameMap::clearPieces() {
+    *start = "none";
+    startVertex = nullptr;
+
+    // The regions of a map filled from a topology have no drafts, so the matrix holds everything.
+    if (!overlay) {
+        for(Vertices::iterator it = vertices->begin(); it != vertices->end(); ++it)
+            it->second->clearPieces();
+    }
+
+    if (!topology)
+        return;
+
+    for(RegionTally& tally : *continentTallies)
+        tally.fill(0);
+    fill(continentOwners->begin(), continentOwners->end(), NO_PLAYER);
+    armyMatrix->clear();
+}
+
+/**
+ * Puts pieces saved from the army matrix of the map straight back into it (see
+ * ArmyMatrix::loadRows()), then counts the owners of every region and continent again in one
+ * pass, rather than region by region as pieces are set.
+ *
+ * @param numSlots The number of players with a row.
+ * @param armyRows The armies of every player, one row per player.
+ * @param cityRows The cities of every player, one row per player.
+ * @param hash The hash of the matrix when the rows were saved.
+ */
+void GameMap::loadPieces(int numSlots, const int16_t* armyRows, const int16_t* cityRows, uint64_t hash) {
+    getArmyMatrix()->loadRows(numSlots, armyRows, cityRows, hash);
+    countContinentOwners();
+}
+
+/**
+ * Gets the vertices of the map by key. A map filled from a topology only lists its regions by key
+ * once this is first called, as games find regions by ID or through the topology instead.
+ *
+ * @return A pointer to the vertices of the map, in key order.
+ */
+Vertices* GameMap::getVertices() {
+    if (overlay && vertices->empty()) {
+        for(RegionId id = 0; id < regionTable->size(); id++)
+            vertices->insert(vertices->end(), pair<string, Vertex*>(topology->getKey(id), &overlay[id]));
+    }
+
+    return vertices;
+}
+
+/**
+ * Gets the frozen topology of the map, building it first if the map changed
+ * since it was last built.
+ *
+ * @return A pointer to the MapTopology object of the map.
+ */
+MapTopology* GameMap::getTopology() {
+    if (!topology)
+        buildTopology();
+    return topology;
+}
+
+/**
+ * Gets the armies and cities of every region on the map as a structure of arrays, building
+ * the topology first if needed. The regions read their pieces and owners from it.
+ *
+ * @return A pointer to the ArmyMatrix object of the map.
+ */
+ArmyMatrix* GameMap::getArmyMatrix() {
+    getTopology();
+    return armyMatrix;
+}
+
+/**
+ * Gets the hop distances between regions, building the topology first if needed. The oracle
+ * belongs to the topology, so every map sharing it uses the same one.
+ *
+ * @return A pointer to the DistanceOracle object of the map.
+ */
+DistanceOracle* GameMap::getDistanceOracle() {
+    return getTopology()->getDistanceOracle();
+}
+
+/**
+ * Gets the least number of moves needed to get an army from one region to another.
+ *
+ * @param startRegion A pointer to the start region.
+ * @param endRegion A pointer to the end region.
+ * @param overWaterAllowed A boolean representing if the army can cross water edges.
+ * @return The number of moves, or FAR_AWAY if the region can't be reached.
+ */
+int GameMap::getDistance(Vertex* startRegion, Vertex* endRegion, bool overWaterAllowed) {
+    return getDistanceOracle()->getDistance(startRegion->getId(), endRegion->getId(), overWaterAllowed);
+}
+
+/**
+ * Gets every region an army can reach from a region in a number of moves or less, including
+ * the region itself.
+ *
+ * @param startRegion A pointer to the start region.
+ * @param hops The most moves allowed.
+ * @param overWaterAllowed A boolean representing if the army can cross water edges.
+ * @return Pointers to the regions, in region ID order.
+ */
+vector<Vertex*> GameMap::getRegionsWithin(Vertex* startRegion, int hops, bool overWaterAllowed) {
+    DistanceOracle* oracle = getDistanceOracle();
+    RegionSet reachable;
+    oracle->getRegionsWithin(startRegion->getId(), hops, overWaterAllowed, &reachable);
+
+    vector<Vertex*> regions;
+    for(RegionId id : reachable.getIds())
+        regions.push_back((*regionTable)[id]);
+
+    return regions;
 }
 
 /**
@@ -300,143 +755,184 @@ void GameMap::printMap(){
 }
 
 void GameMap::printOccupiedRegions() {
-    Vertices::iterator it;
+    // Region IDs are in key order, like the vertices.
+    getTopology();
     cout << "---------------------------------------------------------------------------" << endl;
-    for(it = vertices->begin(); it != vertices->end(); ++it) {
-        if (it->second->getArmies()->size() > 0 || it->second->getCities()->size() > 0)
-            it->second->print();
+    for(Vertex* region : *regionTable) {
+        if (region->hasPieces())
+            region->print();
     }
     cout << "---------------------------------------------------------------------------" << endl;
 }
 
 /**
- * Conducts a Breadth-First-Search through the GameMap object to find all the continents
- * in the map.
+ * Gets the owner of the continent. The owner is kept up to date as regions change hands,
+ * so this is a constant time lookup.
  *
- * @return a list of region names grouped in sets representing the different continents on the map.
+ * @param continent The ID of the continent in the map topology.
+ * @return The ID of the owner. Returns NO_PLAYER if there's no owner.
  */
-vector<set<string>* > GameMap::getContinents(){
-    vector<set<string>* > continents;
-    unordered_set<string> notVisited;
-    queue<string> nextToVisit;
+PlayerId GameMap::getContinentOwner(ContinentId continent) {
+    getTopology();
+    return (*continentOwners)[continent];
+}
 
-    //Create copy of all vertices in set
-    Vertices::iterator it;
-    for(it = vertices->begin(); it != vertices->end(); ++it)
-        notVisited.insert(it->first);
-
-    int continentIndex = -1;
-    string continentName;
-
-    while(true) {
-        if(notVisited.empty())
-            break;
-
-        //nextToVisit will be empty when a new continent starts
-        if (nextToVisit.empty()) {
-            set<string>* newContinent = new set<string>;
-
-            //Get front node from notVisited and remove it.
-            string key = *notVisited.begin();
-            Vertex* firstNode = vertices->find(key)->second;
-            notVisited.erase(key);
-
-            //Create New continent and add first node.
-            continentName = firstNode->getContinent();
-            newContinent->insert(key);
-            continents.push_back(newContinent);
-            continentIndex++;
-
-            //add edgevertices to nextToVist
-            vector<Edge>* edges = firstNode->getEdges();
-            for(Edge& edge: *edges)
-                //Only add edge vertex if not a water edge and currently in notVisited
-                if (!edge.second && (notVisited.find(edge.first->getKey())!=notVisited.end()))
-                    nextToVisit.push(edge.first->getKey());
-        } else { //Still in a continent
-            string currentNodeKey = nextToVisit.front();
-            nextToVisit.pop();
-            Vertex* currentNode = vertices->find(currentNodeKey)->second;
-
-            //If exist in notVisited, remove it from notVisited, add it to continent, add non-water edges to nextToVisit
-            if(notVisited.find(currentNodeKey) != notVisited.end()) {
-
-                // allows for nodes to erroneously be put in multiple continents indicating a faulty map file.
-                if (currentNode->getContinent() == continentName) {
-                    notVisited.erase(currentNodeKey);
-                    continents.at(continentIndex)->insert(currentNodeKey);
-
-                    //add edgevertices to nextToVist
-                    vector<Edge> *edges = currentNode->getEdges();
-
-                    for(Edge& edge: *edges)
-                        //Only add edge vertex if not a water edge and currently in notVisited
-                        if (!edge.second && (notVisited.find(edge.first->getKey())!=notVisited.end()))
-                            nextToVisit.push(edge.first->getKey());
-                } else {
-                    continents.at(continentIndex)->insert(currentNodeKey);
-                    cout << "\n[WARNING] " << currentNodeKey << " had a different continent name: " << currentNode->getContinent();
-                }
-            }
+/**
+ * Counts the continents owned by a player.
+ *
+ * @param player The ID of the player.
+ * @return The number of continents the player owns.
+ */
+int GameMap::getNumContinentsOwnedBy(PlayerId player) {
+    getTopology();
+    return int(count(continentOwners->begin(), continentOwners->end(), player));
+}
+
+/**
+ * Updates the region counts and the owner of the continent a region sits on after the
+ * owner of the region changed. Called by the region itself (see Vertex::updateOwner()).
+ *
+ * @param region A pointer to the region that changed hands.
+ * @param previousOwner The ID of the previous owner, or NO_PLAYER if no one owned it.
+ */
+void GameMap::updateRegionOwner(Vertex* region, PlayerId previousOwner) {
+    // The counts are rebuilt from scratch the next time the topology is built.
+    if (!topology)
+        return;
+
+    ContinentId continent = topology->getContinentId(region->getId());
+    RegionTally* tally = &(*continentTallies)[continent];
+
+    adjustTally(tally, previousOwner, -1);
+    adjustTally(tally, region->getOwner(), 1);
+
+    (*continentOwners)[continent] = findOwnerOfContinent(tally);
+}
+
+//PRIVATE
+/**
+ * Discards the frozen topology after the regions or edges of the map changed.
+ */
+void GameMap::invalidateTopology() {
+    emptyArmyMatrix();
+    MapTopology::release(topology);
+    topology = nullptr;
+    continentTallies->clear();
+    continentOwners->clear();
+}
+
+//PRIVATE
+/**
+ * Counts the regions owned per player on every continent and finds the owner of each continent.
+ * Used when the topology is built or the pieces are loaded in bulk. Otherwise the counts are
+ * updated one region at a time.
+ */
+void GameMap::countContinentOwners() {
+    continentTallies->assign(topology->getNumContinents(), RegionTally());
+    continentOwners->assign(topology->getNumContinents(), NO_PLAYER);
+
+    // Reads the owners straight after computeOwners() wrote them, while they are still cached.
+    const int8_t* ownerSlots = armyMatrix->getOwnerSlots();
+    const ContinentId* continentOf = topology->getContinentIds();
+    RegionTally* tallies = continentTallies->data();
+    for(RegionId id = 0; id < regionTable->size(); id++) {
+        if (ownerSlots[id] != NO_OWNER)
+            tallies[continentOf[id]][ownerSlots[id]]++;
+    }
+
+    for(ContinentId continent = 0; continent < topology->getNumContinents(); continent++)
+        (*continentOwners)[continent] = findOwnerOfContinent(&(*continentTallies)[continent]);
+}
+
+//PRIVATE
+/**
+ * Creates the army matrix for the current topology and moves in the pieces the drafts of the
+ * regions hold. From then on the regions read their pieces and owners from the matrix.
+ */
+void GameMap::fillArmyMatrix() {
+    delete armyMatrix;
+    armyMatrix = new ArmyMatrix(int(regionTable->size()));
+
+    for(Vertex* region : *regionTable) {
+        RegionDraft* draft = region->getDraft();
+        if (!draft)
+            continue;
+
+        for(PlayerId player = 0; player < MAX_PLAYERS; player++) {
+            if (draft->armies[player] > 0)
+                armyMatrix->setArmies(player, region->getId(), draft->armies[player]);
+            if (draft->cities[player] > 0)
+                armyMatrix->setCities(player, region->getId(), draft->cities[player]);
         }
     }
 
-    return continents;
+    armyMatrix->computeOwners();
 }
 
+//PRIVATE
 /**
- * Gets the owner of the continent.
- *
- * @param continent A pointer to a set of strings representing a continent and its regions.
- * @return The name of the owner. Returns "" if there's no owner.
+ * Moves the pieces and owners in the army matrix back into the drafts of the regions and deletes
+ * the matrix, before the regions of the map change.
  */
-string GameMap::getContinentOwner(set<string>* continent) {
-    // Create an empty map that tracks the number of owned regions per player.
-    unordered_map<string, int> ownedRegionsPerPlayer;
+void GameMap::emptyArmyMatrix() {
+    if (!armyMatrix)
+        return;
 
-    // Iterate through the vertices on the continent and count the number of regions owned per player.
-    for(set<string>::iterator it = continent->begin(); it != continent->end(); ++it) {
-        Vertex* region = vertices->find(*it)->second;
-        string owner = region->getRegionOwner(); // Returns "" if owned by no one.
+    for(Vertex* region : *regionTable) {
+        RegionDraft* draft = region->getDraft();
+        if (!draft)
+            continue;
 
-        // Increment the number of owned regions per player.
-        if(ownedRegionsPerPlayer.find(owner) != ownedRegionsPerPlayer.end()) {
-            int numRegions = ownedRegionsPerPlayer.find(owner)->second;
-            ownedRegionsPerPlayer.erase(owner);
-            ownedRegionsPerPlayer.insert(pair<string,int>(owner, numRegions+1));
-        } else {
-            ownedRegionsPerPlayer.insert(pair<string,int>(owner, 1));
+        for(PlayerId player = 0; player < MAX_PLAYERS; player++) {
+            draft->armies[player] = region->getArmiesOf(player);
+            draft->cities[player] = region->getCitiesOf(player);
         }
+        draft->owner = region->getOwner();
+        draft->ownerMargin = region->getOwnerMargin();
     }
 
-    return findOwnerOfContinent(&ownedRegionsPerPlayer);
+    delete armyMatrix;
+    armyMatrix = nullptr;
 }
 
 //PRIVATE
 /**
- * Looks through a map of the number of owned regions per player in a continent to find the owner of the continent.
+ * Adds to the number of regions a player owns on a continent.
  *
- * @param ownedRegionsPerPlayer A pointer to the an unordered_map of the number of regions owned per player.
- * @return The owner of the continent. Returns "" if no owner.
+ * @param tally A pointer to the region counts of the continent.
+ * @param player The ID of the player. Nothing happens if this is NO_PLAYER.
+ * @param change The number of regions to add. Can be negative.
  */
-string GameMap::findOwnerOfContinent(unordered_map<string, int> *ownedRegionsPerPlayer) {
+void GameMap::adjustTally(RegionTally* tally, PlayerId player, int change) {
+    if (player < MAX_PLAYERS)
+        (*tally)[player] += change;
+}
+
+//PRIVATE
+/**
+ * Looks through the number of owned regions per player in a continent to find the owner of the continent.
+ *
+ * @param ownedRegionsPerPlayer A pointer to the number of regions owned per player.
+ * @return The ID of the owner of the continent. Returns NO_PLAYER if no owner.
+ */
+PlayerId GameMap::findOwnerOfContinent(RegionTally* ownedRegionsPerPlayer) {
     int highestRegionCount = 0;
-    string owner = "";
+    int secondRegionCount = 0;
+    PlayerId owner = NO_PLAYER;
 
-    // Iterate through the ownedRegionsPerPlayer map and find the number of regions owned by the player to determine
-    // the owner of the current continent.
-    for(unordered_map<string, int>::iterator it = ownedRegionsPerPlayer->begin(); it != ownedRegionsPerPlayer->end(); ++it) {
+    // Go through the number of regions owned by each player to determine the owner of the current continent.
+    for(PlayerId player = 0; player < MAX_PLAYERS; player++) {
+        int regionCount = (*ownedRegionsPerPlayer)[player];
 
-        if (it->first != "") {
-            if(it->second > highestRegionCount) {
-                highestRegionCount = it->second;
-                owner = it->first;
-            }
-            else if (it->second == highestRegionCount) {
-                owner = "";
-            }
+        if(regionCount > highestRegionCount) {
+            secondRegionCount = highestRegionCount;
+            highestRegionCount = regionCount;
+            owner = player;
+        }
+        else if (regionCount > secondRegionCount) {
+            secondRegionCount = regionCount;
         }
     }
 
-    return owner;
-}
\ No newline at end of file
+    return highestRegionCount > secondRegionCount ? owner : NO_PLAYER;
+}
@@ -2,7 +2,11 @@
 #define MAP_H
 
 #include "Player.h"
+#include "MapTopology.h"
+#include "ArmyMatrix.h"
+#include "DistanceOracle.h"
 
+#include <array>
 #include <queue>
 #include <set>
 #include <unordered_set>
@@ -16,17 +20,41 @@ using namespace std;
 
 class Player;
 class Vertex;
+class GameMap;
 typedef pair<Vertex*, bool> Edge;
-typedef pair<string, string> PlayerEntry;
+typedef array<int, MAX_PLAYERS> PieceCounts;
+typedef array<int, MAX_PLAYERS> RegionTally;
+
+/**
+ * The name, key, continent and edges of a region added to a map by hand. The topology of the map
+ * is built from them (see GameMap::buildTopology()). The regions of a map filled from a topology
+ * don't have one, since the topology already holds all of it.
+ *
+ * Until the map has a topology, and so an ArmyMatrix, the pieces on the region and its owner are
+ * kept here too. They are moved into the matrix when it is built, and back out when the regions
+ * of the map change.
+ */
+struct RegionDraft {
+    string name;
+    string key;
+    string continent;
+    vector<Edge> edges;
+    PieceCounts armies = {};
+    PieceCounts cities = {};
+    PlayerId owner = NO_PLAYER;
+    int ownerMargin = 0;
+};
 
+/**
+ * A region of a GameMap as a game sees it: a view of the pieces on it and of its owner, which
+ * live in the ArmyMatrix of the map. The name, key, continent and neighbours of the region are
+ * read from the map topology, so a game on a loaded map only gets an array of these (see
+ * GameMap::loadTopology()).
+ */
 class Vertex {
-    string *name;
-    string *vertexKey;
-    set<Player*> *owners;
-    string *continent;
-    unordered_map<PlayerEntry*, int> *armies;
-    unordered_map<PlayerEntry*, int> *cities;
-    vector<Edge> *edges;
+    RegionId id;
+    GameMap *map;
+    RegionDraft *draft;
 
 public:
     Vertex();
@@ -37,19 +65,37 @@ public:
 
     void addEdge(Vertex* vertex, bool isWaterEdge);
     void print();
-    string getRegionOwner();
-
-    string getName(){return *name;}
-    string getKey(){return *vertexKey;}
-    string getContinent(){return *continent;}
-    set<Player*>* getOwners(){return owners;}
-    unordered_map<PlayerEntry*, int>* getArmies(){return armies;}
-    unordered_map<PlayerEntry*, int>* getCities(){return cities;}
-    vector<Edge>* getEdges(){return edges;}
+
+    int getArmiesOf(PlayerId player);
+    int getCitiesOf(PlayerId player);
+    void setArmies(PlayerId player, int numArmies);
+    void setCities(PlayerId player, int numCities);
+    bool hasPieces();
+    void clearPieces();
+
+    const string& getName();
+    const string& getKey();
+    const string& getContinent();
+    RegionDraft* getDraft(){return draft;}
+    RegionId getId(){return id;}
+    PlayerId getOwner();
+    int getOwnerMargin();
+
+    void setId(RegionId newId){id = newId;}
+    void setMap(GameMap* newMap){map = newMap;}
+
+private:
+    ArmyMatrix* getArmyMatrix();
+    void updateOwner(PlayerId previousOwner);
 };
 
 typedef map<string, Vertex*> Vertices;
 
+/**
+ * The regions of a game and the pieces on them. A map can't be copied, since its regions point
+ * back at it and a loaded map keeps them in one array. To keep or clone the state of a game,
+ * take a GameState of it instead (see GameContext::snapshot()).
+ */
 class GameMap {
 
 private:
@@ -58,31 +104,67 @@ private:
     string* start;
     string* image;
     Vertex* startVertex;
+    MapTopology* topology;
+    Vertex* overlay;
+    vector<Vertex*>* regionTable;
+    vector<RegionTally>* continentTallies;
+    vector<PlayerId>* continentOwners;
+    vector<Player*>* roster;
+    ArmyMatrix* armyMatrix;
+
+    friend class Vertex;
 
 public:
-    GameMap(GameMap* map);
+    GameMap();
+    GameMap(GameMap* map) = delete;
+    GameMap& operator=(GameMap& map) = delete;
     ~GameMap();
 
     static GameMap* instance();
 
-    void addVertex(const string& key, const string& name, const string& continent);
+    Vertex* addVertex(const string& key, const string& name, const string& continent);
     void addEdge(const string& startVertex, const string& endVertex, const bool isWaterEdge);
+    void addEdge(Vertex* startRegion, Vertex* endRegion, const bool isWaterEdge);
     void printMap();
     void printOccupiedRegions();
 
-    Vertices* getVertices() { return vertices; }
-    string getStartVertexName() { return *start; }
-    string getImage() { return *image; }
+    Vertices* getVertices();
+    const string& getStartVertexName() { return *start; }
+    const string& getImage() { return *image; }
     Vertex* getStartVertex() { return startVertex; }
+    Vertex* getVertex(RegionId id) { return (*regionTable)[id]; }
+    size_t getNumRegions() { return getTopology()->getNumRegions(); }
+    Vertex* findVertex(const string& key);
+
+    PlayerId addPlayer(Player* player);
+    Player* getPlayer(PlayerId id) { return id < roster->size() ? (*roster)[id] : nullptr; }
+    int getNumPlayers() { return int(roster->size()); }
+
+    void buildTopology();
+    void loadTopology(MapTopology* newTopology);
+    void shareMap(GameMap* loadedMap);
+    void resetPieces();
+    void clearPieces();
+    void loadPieces(int numSlots, const int16_t* armyRows, const int16_t* cityRows, uint64_t hash);
+    MapTopology* getTopology();
+    ArmyMatrix* getArmyMatrix();
+    DistanceOracle* getDistanceOracle();
+    int getDistance(Vertex* startRegion, Vertex* endRegion, bool overWaterAllowed);
+    vector<Vertex*> getRegionsWithin(Vertex* startRegion, int hops, bool overWaterAllowed);
 
     void setImage(const string& newImage);
     bool setStartVertex(string& startVertexName);
-    vector<set<string>* > getContinents();
-    string getContinentOwner(set<string>* continent);
+    PlayerId getContinentOwner(ContinentId continent);
+    int getNumContinentsOwnedBy(PlayerId player);
+    void updateRegionOwner(Vertex* region, PlayerId previousOwner);
 
 private:
-    GameMap();
-    string findOwnerOfContinent(unordered_map<string, int> *ownedRegionsPerPlayer);
+    void invalidateTopology();
+    void countContinentOwners();
+    void fillArmyMatrix();
+    void emptyArmyMatrix();
+    void adjustTally(RegionTally* tally, PlayerId player, int change);
+    PlayerId findOwnerOfContinent(RegionTally* ownedRegionsPerPlayer);
 };
 
 #endif
@@ -0,0 +1,324 @@
+#include "MapGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <unordered_set>
+
+/**
+ * Initializes a MapGenerator object.
+ *
+ * @param theSettings The shape of the maps to generate.
+ */
+MapGenerator::MapGenerator(const MapGeneratorSettings& theSettings):
+    settings(new MapGeneratorSettings(theSettings)),
+    random(new mt19937_64(theSettings.seed)),
+    continentStarts(new vector<int>()),
+    landEdges(new vector<pair<uint32_t, uint32_t>>()),
+    waterEdges(new vector<pair<uint32_t, uint32_t>>()) {}
+
+/**
+ * Copy Constructor
+ */
+MapGenerator::MapGenerator(MapGenerator* generator) {
+    settings = new MapGeneratorSettings(*generator->settings);
+    random = new mt19937_64(*generator->random);
+    continentStarts = new vector<int>(*generator->continentStarts);
+    landEdges = new vector<pair<uint32_t, uint32_t>>(*generator->landEdges);
+    waterEdges = new vector<pair<uint32_t, uint32_t>>(*generator->waterEdges);
+}
+
+/**
+ * Assignment operator
+ */
+MapGenerator& MapGenerator::operator=(MapGenerator& generator) {
+    if (&generator != this) {
+        *settings = *generator.settings;
+        *random = *generator.random;
+        *continentStarts = *generator.continentStarts;
+        *landEdges = *generator.landEdges;
+        *waterEdges = *generator.waterEdges;
+    }
+    return *this;
+}
+
+/**
+ * Destructor
+ */
+MapGenerator::~MapGenerator() {
+    delete settings;
+    delete random;
+    delete continentStarts;
+    delete landEdges;
+    delete waterEdges;
+
+    settings = nullptr;
+    random = nullptr;
+    continentStarts = nullptr;
+    landEdges = nullptr;
+    waterEdges = nullptr;
+}
+
+/**
+ * Checks that the settings can produce a valid map.
+ *
+ * @return A boolean representing if the settings are valid.
+ */
+bool MapGenerator::validateSettings() {
+    if (settings->numRegions < 2 || settings->numRegions > MAX_GENERATED_REGIONS) {
+        cout << "[ ERROR! ] A generated map must have from 2 to " << MAX_GENERATED_REGIONS << " regions." << endl;
+        return false;
+    }
+
+    if (settings->numContinents < 1 || settings->numContinents * 2 > settings->numRegions) {
+        cout << "[ ERROR! ] Every continent needs at least two regions. " << settings->numRegions
+             << " regions can hold at most " << settings->numRegions / 2 << " continents." << endl;
+        return false;
+    }
+
+    if (settings->sizeSkew < 0 || settings->waterDensity < 0 || settings->averageDegree < 0) {
+        cout << "[ ERROR! ] The size skew, water density and average degree can't be negative." << endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Generates a map and writes it to a file.
+ *
+ * @param path The path of the map file to write.
+ * @return A boolean representing if the map was written.
+ */
+bool MapGenerator::generate(const string& path) {
+    if (!validateSettings())
+        return false;
+
+    random->seed(settings->seed);
+    chooseContinentSizes();
+    generateLandEdges();
+    generateWaterEdges();
+
+    return writeMap(path);
+}
+
+//PRIVATE
+/**
+ * Splits the regions into continents. Every continent gets two regions, and the rest are shared
+ * out in proportion to 1 / rank^sizeSkew, rounding by largest remainder. Regions are numbered so
+ * that each continent is a contiguous range.
+ */
+void MapGenerator::chooseContinentSizes() {
+    const int numContinents = settings->numContinents;
+    const int spareRegions = settings->numRegions - 2 * numContinents;
+
+    vector<double> weights(numContinents);
+    double totalWeight = 0;
+    for (int c = 0; c < numContinents; c++) {
+        weights[c] = pow(double(c + 1), -settings->sizeSkew);
+        totalWeight += weights[c];
+    }
+
+    vector<int> sizes(numContinents, 2);
+    vector<pair<double, int>> remainders(numContinents);
+    int assigned = 0;
+
+    for (int c = 0; c < numContinents; c++) {
+        double share = spareRegions * weights[c] / totalWeight;
+        sizes[c] += int(share);
+        assigned += int(share);
+        remainders[c] = pair<double, int>(share - int(share), -c);
+    }
+
+    sort(remainders.rbegin(), remainders.rend());
+    for (int i = 0; assigned < spareRegions; i++, assigned++)
+        sizes[-remainders[i].second]++;
+
+    continentStarts->assign(1, 0);
+    for (int c = 0; c < numContinents; c++)
+        continentStarts->push_back(continentStarts->back() + sizes[c]);
+}
+
+//PRIVATE
+/**
+ * Connects the regions of each continent over land.
+ *
+ * A random spanning tree keeps every continent connected. Extra edges are then added until the
+ * average degree is reached. With the uniform model both ends of an extra edge are picked at
+ * random. With the power law model one end is picked in proportion to its current degree, which
+ * gives a few heavily connected regions.
+ */
+void MapGenerator::generateLandEdges() {
+    landEdges->clear();
+
+    unordered_set<uint64_t> seen;
+    vector<uint32_t> endpoints;
+
+    for (int c = 0; c < settings->numContinents; c++) {
+        const uint32_t first = (*continentStarts)[c];
+        const uint64_t size = getContinentSize(c);
+        const bool isPowerLaw = settings->degreeModel == POWER_LAW_DEGREE;
+
+        seen.clear();
+        endpoints.clear();
+
+        auto addEdge = [&](uint32_t a, uint32_t b) {
+            uint64_t key = (uint64_t(min(a, b)) << 32) | max(a, b);
+            if (a == b || !seen.insert(key).second)
+                return false;
+
+            landEdges->push_back(pair<uint32_t, uint32_t>(min(a, b), max(a, b)));
+            endpoints.push_back(a);
+            endpoints.push_back(b);
+            return true;
+        };
+
+        for (uint32_t i = 1; i < size; i++) {
+            uint32_t parent = isPowerLaw && !endpoints.empty() ? endpoints[nextBelow(endpoints.size())] : first + uint32_t(nextBelow(i));
+            addEdge(first + i, parent);
+        }
+
+        const uint64_t maxEdges = size * (size - 1) / 2;
+        const uint64_t wantedEdges = min(maxEdges, max(size - 1, uint64_t(llround(settings->averageDegree * size / 2))));
+        uint64_t numEdges = size - 1;
+
+        // Dense continents may run out of free pairs, so give up after a fixed number of misses.
+        for (uint64_t misses = 0; numEdges < wantedEdges && misses < 16 * wantedEdges; ) {
+            uint32_t a = first + uint32_t(nextBelow(size));
+            uint32_t b = isPowerLaw ? endpoints[nextBelow(endpoints.size())] : first + uint32_t(nextBelow(size));
+
+            if (addEdge(a, b))
+                numEdges++;
+            else
+                misses++;
+        }
+    }
+}
+
+//PRIVATE
+/**
+ * Joins the continents with water edges. A random spanning tree over the continents keeps the
+ * map connected, then waterDensity * numRegions extra edges are added between random regions
+ * on different continents.
+ */
+void MapGenerator::generateWaterEdges() {
+    waterEdges->clear();
+
+    const int numContinents = settings->numContinents;
+    if (numContinents < 2)
+        return;
+
+    unordered_set<uint64_t> seen;
+    auto addEdge = [&](uint32_t a, uint32_t b) {
+        uint64_t key = (uint64_t(min(a, b)) << 32) | max(a, b);
+        if (!seen.insert(key).second)
+            return false;
+
+        waterEdges->push_back(pair<uint32_t, uint32_t>(min(a, b), max(a, b)));
+        return true;
+    };
+
+    auto randomRegionOf = [&](int continent) {
+        return uint32_t((*continentStarts)[continent] + nextBelow(getContinentSize(continent)));
+    };
+
+    for (int c = 1; c < numContinents; c++)
+        addEdge(randomRegionOf(c), randomRegionOf(int(nextBelow(c))));
+
+    const uint64_t extraEdges = uint64_t(llround(settings->waterDensity * settings->numRegions));
+    for (uint64_t added = 0, misses = 0; added < extraEdges && misses < 16 * extraEdges; ) {
+        int a = int(nextBelow(numContinents));
+        int b = int(nextBelow(numContinents - 1));
+        if (b >= a)
+            b++;
+
+        if (addEdge(randomRegionOf(a), randomRegionOf(b)))
+            added++;
+        else
+            misses++;
+    }
+}
+
+//PRIVATE
+/**
+ * Writes the generated map in the MapLoader syntax. Each edge is listed once, on the line of
+ * its lower numbered region.
+ *
+ * @param path The path of the map file to write.
+ * @return A boolean representing if the map was written.
+ */
+bool MapGenerator::writeMap(const string& path) {
+    const int numRegions = settings->numRegions;
+
+    // Group the edges by their lower numbered region. Water edges are marked in the high bit.
+    const uint32_t WATER_BIT = 1u << 31;
+    vector<uint32_t> offsets(numRegions + 1, 0);
+    for (const pair<uint32_t, uint32_t>& edge : *landEdges)
+        offsets[edge.first + 1]++;
+    for (const pair<uint32_t, uint32_t>& edge : *waterEdges)
+        offsets[edge.first + 1]++;
+    for (int r = 0; r < numRegions; r++)
+        offsets[r + 1] += offsets[r];
+
+    vector<uint32_t> ends(offsets.back());
+    vector<uint32_t> next(offsets.begin(), offsets.end() - 1);
+    for (const pair<uint32_t, uint32_t>& edge : *landEdges)
+        ends[next[edge.first]++] = edge.second;
+    for (const pair<uint32_t, uint32_t>& edge : *waterEdges)
+        ends[next[edge.first]++] = edge.second | WATER_BIT;
+
+    string text;
+    text.reserve(size_t(numRegions) * 40 + ends.size() * 10);
+
+    for (int c = 0; c < settings->numContinents; c++) {
+        text.append("$Continent").append(to_string(c)).append("\n");
+        for (int r = (*continentStarts)[c]; r < (*continentStarts)[c + 1]; r++)
+            text.append("R").append(to_string(r)).append(":Region ").append(to_string(r)).append("\n");
+    }
+
+    text.append("&\n");
+    for (int r = 0; r < numRegions; r++) {
+        if (offsets[r] == offsets[r + 1])
+            continue;
+
+        text.append("R").append(to_string(r));
+        for (uint32_t i = offsets[r]; i < offsets[r + 1]; i++) {
+            text.append(ends[i] & WATER_BIT ? " w R" : " R").append(to_string(ends[i] & ~WATER_BIT));
+        }
+        text.append("\n");
+    }
+
+    text.append("%\n");
+    text.append("Generated map: ").append(to_string(numRegions)).append(" regions, ")
+        .append(to_string(settings->numContinents)).append(" continents, seed ")
+        .append(to_string(settings->seed)).append(".\n");
+
+    ofstream out(path, ios::binary | ios::trunc);
+    out.write(text.data(), text.size());
+    out.close();
+
+    if (!out) {
+        cout << "[ ERROR! ] Couldn't write the map file < " << path << " >." << endl;
+        return false;
+    }
+
+    cout << "[ MAP GENERATOR ] Wrote < " << path << " > with " << numRegions << " regions, "
+         << settings->numContinents << " continents, " << landEdges->size() << " land edges and "
+         << waterEdges->size() << " water edges." << endl;
+    return true;
+}
+
+//PRIVATE
+/**
+ * Draws a random number from 0 to bound - 1. Uses the raw output of the engine, which is the
+ * same on every platform, unlike the standard distributions.
+ */
+uint64_t MapGenerator::nextBelow(uint64_t bound) {
+    return (*random)() % bound;
+}
+
+//PRIVATE
+int MapGenerator::getContinentSize(int continent) {
+    return (*continentStarts)[continent + 1] - (*continentStarts)[continent];
+}
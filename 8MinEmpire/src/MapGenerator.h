@@ -0,0 +1,65 @@
+#ifndef MAP_GENERATOR_H
+#define MAP_GENERATOR_H
+
+#include <stdint.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+const int MAX_GENERATED_REGIONS = 1000000;
+
+enum DegreeModel { UNIFORM_DEGREE, POWER_LAW_DEGREE };
+
+/**
+ * The shape of a generated map.
+ *
+ * Continent sizes follow a Zipf distribution with exponent sizeSkew, so 0 gives continents of
+ * equal size. waterDensity is the number of extra water edges between continents per region,
+ * on top of the ones that keep the continents connected. averageDegree is the average number
+ * of land edges per region.
+ */
+struct MapGeneratorSettings {
+    int numRegions = 1000;
+    int numContinents = 10;
+    double sizeSkew = 0.0;
+    double waterDensity = 0.01;
+    double averageDegree = 3.0;
+    DegreeModel degreeModel = UNIFORM_DEGREE;
+    uint64_t seed = 1;
+};
+
+/**
+ * Writes random map files in the MapLoader syntax.
+ *
+ * Every generated map is valid: each continent has at least two regions and is connected over
+ * land, continents are only joined by water edges, the whole map is connected, and there are no
+ * self loops or duplicate edges. The same settings and seed always give the same file.
+ */
+class MapGenerator {
+    MapGeneratorSettings* settings;
+    mt19937_64* random;
+    vector<int>* continentStarts;
+    vector<pair<uint32_t, uint32_t>>* landEdges;
+    vector<pair<uint32_t, uint32_t>>* waterEdges;
+
+public:
+    MapGenerator(const MapGeneratorSettings& settings);
+    MapGenerator(MapGenerator* generator);
+    MapGenerator& operator=(MapGenerator& generator);
+    ~MapGenerator();
+
+    bool validateSettings();
+    bool generate(const string& path);
+
+private:
+    void chooseContinentSizes();
+    void generateLandEdges();
+    void generateWaterEdges();
+    bool writeMap(const string& path);
+    uint64_t nextBelow(uint64_t bound);
+    int getContinentSize(int continent);
+};
+
+#endif
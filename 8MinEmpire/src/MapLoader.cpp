@@ -1,8 +1,6 @@
 #include "MapLoader.h"
 #include "util/MapUtil.h"
-#include <fstream>
-#include <sstream>
-#include <iterator>
+#include <cstring>
 
 #define PATH_PREFIX "maps/"
 
@@ -11,20 +9,21 @@ using namespace std;
 /**
  * Default Constructor
  */
-MapLoader::MapLoader() : mapFilePath(new string(".")){}
+MapLoader::MapLoader() : mapFilePath(new string(".")), map(nullptr){}
 
 /**
  * Initializes a MapLoader object.
  *
  * @param fileName The name of the file. This can be a path start from any directory inside the maps/ directory.
  */
-MapLoader::MapLoader(const string& fileName): mapFilePath(new string(PATH_PREFIX + fileName)){}
+MapLoader::MapLoader(const string& fileName): mapFilePath(new string(PATH_PREFIX + fileName)), map(nullptr){}
 
 /**
  * Copy Constructor
  */
 MapLoader::MapLoader(MapLoader* mapLoader){
     mapFilePath = new string(mapLoader->getMapFilePath());
+    map = mapLoader->map;
 }
 
 /**
@@ -34,6 +33,7 @@ MapLoader& MapLoader::operator=(MapLoader& mapLoader){
     if(&mapLoader != this) {
         delete mapFilePath;
         mapFilePath = new string(mapLoader.getMapFilePath());
+        map = mapLoader.map;
     }
     return *this;
 }
@@ -44,6 +44,7 @@ MapLoader& MapLoader::operator=(MapLoader& mapLoader){
 MapLoader::~MapLoader(){
     delete mapFilePath;
     mapFilePath = nullptr;
+    map = nullptr;
 }
 
 //SETTER
@@ -64,71 +65,161 @@ void MapLoader::setMapFilePath(const string& fileName) {
  * %
  * Image Text
  *
+ * If the map was compiled (see compileMap()) and the text file didn't change since, the
+ * compiled map is loaded instead.
+ *
+ * The map is loaded into the GameMap instance.
+ *
  * @return A boolean reprensenting a successful map object creation.
  */
 bool MapLoader::generateMap(){
-    ifstream mapFile(*mapFilePath);
-    unordered_map<string, string> nameMap;
-    string line;
+    return generateMap(GameMap::instance());
+}
+
+/**
+ * Generates a map from the text file, like generateMap(), into a given GameMap object.
+ *
+ * @param target A pointer to the map to load into, which must be empty. The loader doesn't own it.
+ * @return A boolean reprensenting a successful map object creation.
+ */
+bool MapLoader::generateMap(GameMap* target){
+    map = target;
+
+    if (loadCompiledMap())
+        return true;
+
+    return loadTextMap();
+}
+
+/**
+ * Loads the text map, validates it and writes it out as a compiled map file next to the text
+ * file. Later calls to generateMap() use the compiled map while the text file is unchanged.
+ *
+ * The map is loaded into the GameMap instance, which must be empty.
+ *
+ * @return A boolean representing if the compiled map was written.
+ */
+bool MapLoader::compileMap() {
+    map = GameMap::instance();
+
+    if (!loadTextMap())
+        return false;
+
+    if (!validateMap(map)) {
+        cout << "[ ERROR! ] < " << *mapFilePath << " > is not a valid map. It won't be compiled." << endl;
+        return false;
+    }
+
+    return CompiledMap::write(getCompiledMapFilePath(), *mapFilePath, map);
+}
+
+//PRIVATE
+/**
+ * Generates a GameMap object from the text file.
+ *
+ * The file is memory mapped and read in a single pass without copying lines. Regions are added
+ * as they are read, while edges are held back and added once the whole edge section is valid.
+ *
+ * @return A boolean reprensenting a successful map object creation.
+ */
+bool MapLoader::loadTextMap() {
+    // A missing file reads as an empty one, which fails the first check in loadRegions().
+    MappedFile mapFile;
+    mapFile.open(*mapFilePath);
+
+    TextCursor text(mapFile.getData(), mapFile.getSize());
+    KeyIndex keys;
+    vector<PendingEdge> edges;
 
-    if (!loadRegions(&mapFile, &nameMap))
+    // Rough guess at the number of regions so the key index rarely has to grow.
+    keys.reserve(mapFile.getSize() / 32);
+
+    if (!loadRegions(&text, &keys))
         return false;
 
-    if (!loadEdges(&mapFile, &nameMap))
+    if (!loadEdges(&text, &keys, &edges))
+        return false;
+
+    for (const PendingEdge& edge : edges)
+        map->addEdge(edge.start, edge.end, edge.isWaterEdge);
+
+    // The regions and edges are final now. Freeze them into the map topology.
+    map->buildTopology();
+
+    if(!loadImage(&text))
         return false;
 
-    if(!loadImage(&mapFile))
+    return true;
+}
+
+//PRIVATE
+/**
+ * Loads the map from its compiled map file, if there is one and it's up to date.
+ *
+ * @return A boolean representing if the map was loaded from the compiled map.
+ */
+bool MapLoader::loadCompiledMap() {
+    CompiledMap compiledMap;
+
+    if (!compiledMap.open(getCompiledMapFilePath(), *mapFilePath))
         return false;
 
+    cout << "[ MAP LOADER ] Loading compiled map < " << getCompiledMapFilePath() << " >." << endl;
+
+    map->loadTopology(compiledMap.createTopology());
+    map->setImage(compiledMap.getImage());
+    map->printMap();
+
     return true;
 }
 
 /**
  * Adds regions to a map object.
  *
- * @param mapFile A ifstream pointer the map text file
- * @param nameMap An unordeder_map pointer of an object mapping vertex keys to name
- * @return A GameMap pointer to a map.
+ * @param text A TextCursor pointer at the start of the map file
+ * @param keys A KeyIndex pointer to fill with the vertex of each region key
+ * @return A boolean representing if the regions were read.
  */
-bool MapLoader::loadRegions(ifstream* mapFile, unordered_map<string, string>* nameMap) {
+bool MapLoader::loadRegions(TextCursor* text, KeyIndex* keys) {
 
     string continent;
-    string line;
+    TextSpan line;
 
-    getline(*mapFile, line);
+    text->nextLine(&line);
 
-    if (line == "" || line.at(0) != '$') {
-        cout << "[ ERROR! ] Invalid file. First line must be a continent in the form of \"$CONTINENT\"." << endl;
+    if (line.empty() || line.front() != '$') {
+        cout << "[ ERROR! ] Line 1: Invalid file. First line must be a continent in the form of \"$CONTINENT\"." << endl;
         return false;
     }
 
     cout << "[ MAP LOADER ] Getting names of regions." << endl;
 
-    while (line != "&") {
+    while (!line.equals("&")) {
 
-        if (line.at(0) != '$') {
-            size_t pos = line.find(':');
+        if (line.empty() || line.front() != '$') {
+            const char* colon = (const char*) memchr(line.data, ':', line.size);
 
-            if (pos == size_t(-1)) {
-                cout << "[ ERROR! ] Invalid region syntax \"" << line << "\". Must be in the form of KEY:COUNTRY_NAME." << endl;
+            if (!colon) {
+                cout << "[ ERROR! ] Line " << text->getLineNumber() << ": Invalid region syntax \"" << line.str() << "\". Must be in the form of KEY:COUNTRY_NAME." << endl;
                 return false;
             }
 
-            string key = line.substr(0, pos);
-            string name = line.substr(pos+1);
+            TextSpan key = { line.data, size_t(colon - line.data) };
+            string name(colon + 1, line.data + line.size);
 
-            nameMap->insert(pair<string, string> (key, name));
-            GameMap::instance()->addVertex(key, name, continent);
+            // The first region with a given key wins, like the map itself.
+            Vertex* region = map->addVertex(key.str(), name, continent);
+            keys->insert(pair<TextSpan, Vertex*>(key, region));
 
         } else {
             //Continent found.
-            continent=line.substr(1);
+            continent = string(line.data + 1, line.size - 1);
         }
 
-        getline(*mapFile, line);
+        text->nextLine(&line);
 
-        if(mapFile->eof()) {
-            cout << "[ ERROR! ] Reached end of file." << endl;
+        if(text->isAtEnd()) {
+            cout << "[ ERROR! ] Line " << text->getLineNumber() << ": Reached end of file." << endl;
             return false;
         }
     }
@@ -137,56 +228,61 @@ bool MapLoader::loadRegions(ifstream* mapFile, unordered_map<string, string>* na
 }
 
 /**
- * Adds edges to a map object.
+ * Reads the edges of a map object.
  *
- * @param mapFile A ifstream pointer the map text file
- * @param nameMap An unordeder_map pointer of an object mapping vertex keys to name
- * @return A GameMap pointer to a map.
+ * @param text A TextCursor pointer just past the regions of the map file
+ * @param keys A KeyIndex pointer of the vertex of each region key
+ * @param edges A vector pointer to fill with the edges that were read
+ * @return A boolean representing if the edges were read.
  */
-bool MapLoader::loadEdges(ifstream* mapFile, unordered_map<string, string>* nameMap) {
+bool MapLoader::loadEdges(TextCursor* text, KeyIndex* keys, vector<PendingEdge>* edges) {
 
-    string line;
+    TextSpan line;
+    TextSpan token;
 
     cout << "[ MAP LOADER ] Getting edges." << endl;
 
-    //Move file pointer past the break line "&" from the previous step.
-    getline(*mapFile, line);
+    //Move past the break line "&" from the previous step.
+    text->nextLine(&line);
 
-    while(line != "%") {
-        //Split line into a vector of strings
-        string text = line;
-        istringstream iss(text);
-        vector<string> edgeKeys((istream_iterator<string>(iss)), istream_iterator<string>());
+    while(!line.equals("%")) {
+        //Start vertex key is always the first token.
+        if (!TextCursor::nextToken(&line, &token)) {
+            cout << "[ ERROR! ] Line " << text->getLineNumber() << ": Edge lines must start with a region key." << endl;
+            return false;
+        }
 
-        //Start vertex key is always the first string.
-        string startVertexKey = edgeKeys.at(0);
+        Vertex* startVertex = findRegion(keys, token);
 
-        if (nameMap->find(startVertexKey) == nameMap->end()) {
-            cout << "[ ERROR! ] \"" << startVertexKey << "\" is an invalid key." << endl;
+        if (!startVertex) {
+            cout << "[ ERROR! ] Line " << text->getLineNumber() << ": \"" << token.str() << "\" is an invalid key." << endl;
             return false;
         }
 
-        //Iterate through edge keys and create edges that all start from the startVertex
-        for(size_t index = 1; index < edgeKeys.size(); index++) {
+        //Read the remaining keys and create edges that all start from the startVertex
+        while (TextCursor::nextToken(&line, &token)) {
 
-            bool isWaterEdge = edgeKeys.at(index) == "w";
-            if (isWaterEdge)
-                index++; //Skip over 'w' to next edge key
+            bool isWaterEdge = token.equals("w");
+            if (isWaterEdge && !TextCursor::nextToken(&line, &token)) {
+                cout << "[ ERROR! ] Line " << text->getLineNumber() << ": Expecting a region key after \"w\"." << endl;
+                return false;
+            }
 
-            string endVertexKey = edgeKeys.at(index);
+            Vertex* endVertex = findRegion(keys, token);
 
-            if (nameMap->find(endVertexKey) == nameMap->end()) {
-                cout << "[ ERROR! ] \"" << edgeKeys.at(index) << "\" is an invalid key." << endl;
+            if (!endVertex) {
+                cout << "[ ERROR! ] Line " << text->getLineNumber() << ": \"" << token.str() << "\" is an invalid key." << endl;
                 return false;
             }
 
-            GameMap::instance()->addEdge(startVertexKey, endVertexKey, isWaterEdge);
+            PendingEdge edge = { startVertex, endVertex, isWaterEdge };
+            edges->push_back(edge);
         }
 
-        getline(*mapFile, line);
+        text->nextLine(&line);
 
-        if(mapFile->eof()) {
-            cout << "[ ERROR! ] Reached end of file. Expecting image." << endl;
+        if(text->isAtEnd()) {
+            cout << "[ ERROR! ] Line " << text->getLineNumber() << ": Reached end of file. Expecting image." << endl;
             return false;
         }
     }
@@ -197,30 +293,38 @@ bool MapLoader::loadEdges(ifstream* mapFile, unordered_map<string, string>* name
 /**
  * Adds Image to a map object.
  *
- * @param mapFile A ifstream pointer the map text file
- * @return A GameMap pointer to a map.
+ * @param text A TextCursor pointer just past the edges of the map file
+ * @return A boolean representing if the image was read.
  */
-bool MapLoader::loadImage(ifstream* mapFile) {
+bool MapLoader::loadImage(TextCursor* text) {
 
-    string image = "";
-    string line;
-    if(mapFile->eof()) {
-        cout << "[ ERROR! ] Reached end of file. Expecting image." << endl;
+    if(text->isAtEnd()) {
+        cout << "[ ERROR! ] Line " << text->getLineNumber() << ": Reached end of file. Expecting image." << endl;
         return false;
     }
 
     cout << "[ MAP LOADER ] Getting map image." << endl;
 
-    while(getline(*mapFile, line)) {
-        image.append(line);
+    // The image is the rest of the file. Every line of it ends with a newline.
+    string image = text->getRest().str();
+    if (!image.empty() && image.back() != '\n')
         image.append("\n");
-    }
 
-    // Load in map image at end of file.
-    mapFile->close();
-
-    GameMap::instance()->setImage(image);
-    GameMap::instance()->printMap();
+    map->setImage(image);
+    map->printMap();
 
     return true;
-}
\ No newline at end of file
+}
+
+//PRIVATE
+/**
+ * Looks up the vertex of a region key read from the map file.
+ *
+ * @param keys A KeyIndex pointer of the vertex of each region key
+ * @param key The region key
+ * @return A pointer to the vertex. Returns nullptr if the key isn't on the map.
+ */
+Vertex* MapLoader::findRegion(KeyIndex* keys, const TextSpan& key) {
+    KeyIndex::iterator it = keys->find(key);
+    return it == keys->end() ? nullptr : it->second;
+}
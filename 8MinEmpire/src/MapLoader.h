@@ -2,11 +2,25 @@
 #define MAPLOADER_H
 
 #include "Map.h"
+#include "CompiledMap.h"
+#include "util/TextUtil.h"
 
 using namespace std;
 
+typedef unordered_map<TextSpan, Vertex*, TextSpanHash> KeyIndex;
+
+/**
+ * An edge read from a map file, waiting to be added to the map.
+ */
+struct PendingEdge {
+    Vertex* start;
+    Vertex* end;
+    bool isWaterEdge;
+};
+
 class MapLoader {
     string* mapFilePath;
+    GameMap* map;
 
 public:
     MapLoader();
@@ -16,13 +30,19 @@ public:
     ~MapLoader();
 
     bool generateMap();
+    bool generateMap(GameMap* target);
+    bool compileMap();
     string getMapFilePath() { return *mapFilePath; }
+    string getCompiledMapFilePath() { return *mapFilePath + COMPILED_MAP_SUFFIX; }
     void setMapFilePath(const string& fileName);
 
 private:
-    bool loadRegions(ifstream* mapFile, unordered_map<string, string>* nameMap);
-    bool loadEdges(ifstream* mapFile, unordered_map<string, string>* nameMap);
-    bool loadImage(ifstream* mapFile);
+    bool loadCompiledMap();
+    bool loadTextMap();
+    bool loadRegions(TextCursor* text, KeyIndex* keys);
+    bool loadEdges(TextCursor* text, KeyIndex* keys, vector<PendingEdge>* edges);
+    bool loadImage(TextCursor* text);
+    Vertex* findRegion(KeyIndex* keys, const TextSpan& key);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,452 @@
+#include "MapTopology.h"
+#include "DistanceOracle.h"
+
+#include <algorithm>
+#include <cstring>
+
+/**
+ * Default Constructor
+ */
+MapTopology::MapTopology():
+    keys(new vector<string>()),
+    names(new vector<string>()),
+    continents(new vector<string>()),
+    keyHash(new PerfectHash()),
+    edgeOffsets(new vector<uint32_t>(1, 0)),
+    waterOffsets(new vector<uint32_t>()),
+    neighbours(new vector<RegionId>()),
+    continentOf(new vector<ContinentId>()),
+    continentOffsets(new vector<uint32_t>(1, 0)),
+    continentMembers(new vector<RegionId>()),
+    continentNames(new vector<string>()),
+    landMasks(new vector<uint64_t>()),
+    overWaterMasks(new vector<uint64_t>()),
+    droppedEdges(new vector<RawEdge>()),
+    references(new atomic<int>(1)),
+    generation(new uint64_t(nextGeneration())),
+    distanceOracle(new atomic<DistanceOracle*>(nullptr)),
+    oracleLock(new mutex()) {}
+
+/**
+ * Builds the frozen adjacency of a map.
+ *
+ * Region IDs are the indices into the keys, names and continents vectors, which must all
+ * be the same size. Self loops are dropped and duplicate edges are merged. If two regions are
+ * joined by both a land and a water edge, only the land edge is kept. The edges that were left
+ * out are kept in getDroppedEdges().
+ *
+ * @param theKeys The region keys, indexed by region ID.
+ * @param theNames The region names, indexed by region ID.
+ * @param theContinents The continent name of each region, indexed by region ID.
+ * @param edges The undirected edges between regions.
+ */
+MapTopology::MapTopology(const vector<string>& theKeys, const vector<string>& theNames,
+                         const vector<string>& theContinents, const vector<RawEdge>& edges):
+    keys(new vector<string>(theKeys)),
+    names(new vector<string>(theNames)),
+    continents(new vector<string>(theContinents)),
+    keyHash(new PerfectHash()),
+    edgeOffsets(new vector<uint32_t>()),
+    waterOffsets(new vector<uint32_t>()),
+    neighbours(new vector<RegionId>()),
+    continentOf(new vector<ContinentId>()),
+    continentOffsets(new vector<uint32_t>()),
+    continentMembers(new vector<RegionId>()),
+    continentNames(new vector<string>()),
+    landMasks(new vector<uint64_t>()),
+    overWaterMasks(new vector<uint64_t>()),
+    droppedEdges(new vector<RawEdge>()),
+    references(new atomic<int>(1)),
+    generation(new uint64_t(nextGeneration())),
+    distanceOracle(new atomic<DistanceOracle*>(nullptr)),
+    oracleLock(new mutex())
+{
+    keyHash->build(*keys);
+
+    buildAdjacency(edges);
+    buildContinents();
+    buildNeighbourMasks();
+}
+
+/**
+ * Copy Constructor
+ */
+MapTopology::MapTopology(MapTopology* topology) {
+    keys = new vector<string>(*topology->keys);
+    names = new vector<string>(*topology->names);
+    continents = new vector<string>(*topology->continents);
+    keyHash = new PerfectHash(topology->keyHash);
+    edgeOffsets = new vector<uint32_t>(*topology->edgeOffsets);
+    waterOffsets = new vector<uint32_t>(*topology->waterOffsets);
+    neighbours = new vector<RegionId>(*topology->neighbours);
+    continentOf = new vector<ContinentId>(*topology->continentOf);
+    continentOffsets = new vector<uint32_t>(*topology->continentOffsets);
+    continentMembers = new vector<RegionId>(*topology->continentMembers);
+    continentNames = new vector<string>(*topology->continentNames);
+    landMasks = new vector<uint64_t>(*topology->landMasks);
+    overWaterMasks = new vector<uint64_t>(*topology->overWaterMasks);
+    droppedEdges = new vector<RawEdge>(*topology->droppedEdges);
+    references = new atomic<int>(1);
+    generation = new uint64_t(nextGeneration());
+    distanceOracle = new atomic<DistanceOracle*>(nullptr);
+    oracleLock = new mutex();
+}
+
+/**
+ * Assignment operator
+ */
+MapTopology& MapTopology::operator=(MapTopology& topology) {
+    if (&topology != this) {
+        *keys = *topology.keys;
+        *names = *topology.names;
+        *continents = *topology.continents;
+        *keyHash = *topology.keyHash;
+        *edgeOffsets = *topology.edgeOffsets;
+        *waterOffsets = *topology.waterOffsets;
+        *neighbours = *topology.neighbours;
+        *continentOf = *topology.continentOf;
+        *continentOffsets = *topology.continentOffsets;
+        *continentMembers = *topology.continentMembers;
+        *continentNames = *topology.continentNames;
+        *landMasks = *topology.landMasks;
+        *overWaterMasks = *topology.overWaterMasks;
+        *droppedEdges = *topology.droppedEdges;
+        *generation = nextGeneration();
+        delete distanceOracle->exchange(nullptr);
+    }
+    return *this;
+}
+
+/**
+ * Destructor
+ */
+MapTopology::~MapTopology() {
+    delete keys;
+    delete names;
+    delete continents;
+    delete keyHash;
+    delete edgeOffsets;
+    delete waterOffsets;
+    delete neighbours;
+    delete continentOf;
+    delete continentOffsets;
+    delete continentMembers;
+    delete continentNames;
+    delete landMasks;
+    delete overWaterMasks;
+    delete droppedEdges;
+    delete references;
+    delete generation;
+    delete distanceOracle->load();
+    delete distanceOracle;
+    delete oracleLock;
+
+    keys = nullptr;
+    names = nullptr;
+    continents = nullptr;
+    keyHash = nullptr;
+    edgeOffsets = nullptr;
+    waterOffsets = nullptr;
+    neighbours = nullptr;
+    continentOf = nullptr;
+    continentOffsets = nullptr;
+    continentMembers = nullptr;
+    continentNames = nullptr;
+    landMasks = nullptr;
+    overWaterMasks = nullptr;
+    droppedEdges = nullptr;
+    references = nullptr;
+    generation = nullptr;
+    distanceOracle = nullptr;
+    oracleLock = nullptr;
+}
+
+/**
+ * Adds a reference to the topology. A topology never changes once built, so any number of maps,
+ * and the games playing on them, can share it.
+ *
+ * @return A pointer to this topology.
+ */
+MapTopology* MapTopology::acquire() {
+    references->fetch_add(1, memory_order_relaxed);
+    return this;
+}
+
+/**
+ * Drops a reference to a topology, and deletes it once the last reference is gone. A new
+ * topology starts with one reference, held by whoever created it.
+ *
+ * @param topology A pointer to the topology. Nothing happens if this is nullptr.
+ */
+void MapTopology::release(MapTopology* topology) {
+    if (topology && topology->references->fetch_sub(1, memory_order_acq_rel) == 1)
+        delete topology;
+}
+
+/**
+ * Gets the hop distances between the regions, building the oracle on first use. The oracle is
+ * built once however many maps and games share the topology, and lives as long as it does.
+ *
+ * @return A pointer to the DistanceOracle object of the topology.
+ */
+DistanceOracle* MapTopology::getDistanceOracle() const {
+    DistanceOracle* oracle = distanceOracle->load(memory_order_acquire);
+    if (oracle)
+        return oracle;
+
+    lock_guard<mutex> lock(*oracleLock);
+    oracle = distanceOracle->load(memory_order_relaxed);
+    if (!oracle) {
+        oracle = new DistanceOracle(this);
+        distanceOracle->store(oracle, memory_order_release);
+    }
+
+    return oracle;
+}
+
+//PRIVATE
+/**
+ * Hands out a generation no other topology has had. Objects that cache something built from a
+ * topology keep its generation rather than its address, since a new topology can be allocated
+ * where a deleted one was.
+ */
+uint64_t MapTopology::nextGeneration() {
+    static atomic<uint64_t> lastGeneration(0);
+    return lastGeneration.fetch_add(1, memory_order_relaxed) + 1;
+}
+
+/**
+ * Gets the ID of a region from its key, with one lookup in the perfect hash of the keys and
+ * one comparison.
+ *
+ * @param key The characters of the region key.
+ * @param length The number of characters.
+ * @return The region ID, or NO_REGION if the key isn't on the map.
+ */
+RegionId MapTopology::getId(const char* key, size_t length) const {
+    RegionId id = keyHash->find(key, length);
+    if (id == NO_KEY)
+        return NO_REGION;
+
+    const string& candidate = (*keys)[id];
+    return candidate.size() == length && memcmp(candidate.data(), key, length) == 0 ? id : NO_REGION;
+}
+
+/**
+ * Gets every neighbour of a region, land neighbours first, then water neighbours.
+ */
+RegionRange MapTopology::getNeighbours(RegionId id) const {
+    return range((*edgeOffsets)[id], (*edgeOffsets)[id + 1]);
+}
+
+/**
+ * Gets the neighbours of a region that can be reached without crossing water.
+ */
+RegionRange MapTopology::getLandNeighbours(RegionId id) const {
+    return range((*edgeOffsets)[id], (*waterOffsets)[id]);
+}
+
+/**
+ * Gets the neighbours of a region that can only be reached by crossing water.
+ */
+RegionRange MapTopology::getWaterNeighbours(RegionId id) const {
+    return range((*waterOffsets)[id], (*edgeOffsets)[id + 1]);
+}
+
+/**
+ * Gets the regions that make up a continent.
+ *
+ * @param continent The ID of the continent.
+ * @return The IDs of the regions on the continent, in ascending order.
+ */
+RegionRange MapTopology::getContinentRegions(ContinentId continent) const {
+    const RegionId* base = continentMembers->data();
+    RegionRange r = { base + (*continentOffsets)[continent], base + (*continentOffsets)[continent + 1] };
+    return r;
+}
+
+/**
+ * Detects if two regions share an edge.
+ *
+ * @param start The ID of the first region.
+ * @param end The ID of the second region.
+ * @param overWaterAllowed A boolean representing if the edge is allowed to be a water edge.
+ * @return A boolean representing if the regions are adjacent.
+ */
+bool MapTopology::isAdjacent(RegionId start, RegionId end, bool overWaterAllowed) const {
+    RegionRange land = getLandNeighbours(start);
+    if (binary_search(land.begin(), land.end(), end))
+        return true;
+
+    if (!overWaterAllowed)
+        return false;
+
+    RegionRange water = getWaterNeighbours(start);
+    return binary_search(water.begin(), water.end(), end);
+}
+
+//PRIVATE
+/**
+ * Lays out the edges in compressed sparse row form.
+ *
+ * Every undirected edge is stored once in each direction. The directed edges are packed into
+ * a single 64 bit sort key (start, isWater, end) so that one sort groups them by start region,
+ * puts the land edges before the water edges and orders the neighbours in each run.
+ *
+ * @param edges The undirected edges between regions.
+ */
+void MapTopology::buildAdjacency(const vector<RawEdge>& edges) {
+    const size_t numRegions = keys->size();
+
+    vector<uint64_t> packed;
+    packed.reserve(edges.size() * 2);
+
+    droppedEdges->clear();
+
+    for (const RawEdge& edge : edges) {
+        if (edge.start == edge.end) {
+            droppedEdges->push_back(edge);
+            continue;
+        }
+
+        uint64_t water = edge.isWaterEdge ? uint64_t(1) << 32 : 0;
+        packed.push_back((uint64_t(edge.start) << 33) | water | edge.end);
+        packed.push_back((uint64_t(edge.end) << 33) | water | edge.start);
+    }
+
+    sort(packed.begin(), packed.end());
+
+    // A repeated edge sorts next to its first copy. Each edge is packed from both ends, so only
+    // the copy stored on the lower region is recorded.
+    for (size_t i = 1; i < packed.size(); i++) {
+        RegionId start = RegionId(packed[i] >> 33), end = RegionId(packed[i]);
+        if (packed[i] == packed[i - 1] && start < end) {
+            RawEdge edge = { start, end, bool((packed[i] >> 32) & 1) };
+            droppedEdges->push_back(edge);
+        }
+    }
+
+    packed.erase(unique(packed.begin(), packed.end()), packed.end());
+
+    edgeOffsets->assign(numRegions + 1, 0);
+    waterOffsets->assign(numRegions, 0);
+    neighbours->clear();
+    neighbours->reserve(packed.size());
+
+    size_t index = 0;
+    for (RegionId id = 0; id < numRegions; id++) {
+        (*edgeOffsets)[id] = neighbours->size();
+
+        while (index < packed.size() && (packed[index] >> 33) == id && !((packed[index] >> 32) & 1))
+            neighbours->push_back(RegionId(packed[index++]));
+
+        (*waterOffsets)[id] = neighbours->size();
+        RegionRange land = range((*edgeOffsets)[id], (*waterOffsets)[id]);
+
+        // A water edge is redundant when the same two regions are already joined over land.
+        // The land run stays valid while appending since the storage was reserved up front.
+        while (index < packed.size() && (packed[index] >> 33) == id) {
+            RegionId end = RegionId(packed[index++]);
+            if (!binary_search(land.begin(), land.end(), end)) {
+                neighbours->push_back(end);
+            } else if (id < end) {
+                RawEdge edge = { id, end, true };
+                droppedEdges->push_back(edge);
+            }
+        }
+    }
+    (*edgeOffsets)[numRegions] = neighbours->size();
+
+    // Keep one entry per self loop or repeated pair of regions.
+    sort(droppedEdges->begin(), droppedEdges->end(), [](const RawEdge& a, const RawEdge& b) {
+        return a.start != b.start ? a.start < b.start : a.end < b.end;
+    });
+    droppedEdges->erase(unique(droppedEdges->begin(), droppedEdges->end(), [](const RawEdge& a, const RawEdge& b) {
+        return a.start == b.start && a.end == b.end;
+    }), droppedEdges->end());
+}
+
+//PRIVATE
+/**
+ * Partitions the regions into continents. A continent is a group of regions with the same
+ * continent name that are connected over land. Continent IDs are assigned in order of the
+ * lowest region ID on each continent.
+ *
+ * On a valid map this gives exactly one continent per continent name. The partition never
+ * changes after the map is loaded, so it is only computed once here.
+ */
+void MapTopology::buildContinents() {
+    const size_t numRegions = keys->size();
+
+    continentOf->assign(numRegions, NO_REGION);
+    continentNames->clear();
+
+    vector<RegionId> nextToVisit;
+    nextToVisit.reserve(numRegions);
+
+    for (RegionId seed = 0; seed < numRegions; seed++) {
+        if ((*continentOf)[seed] != NO_REGION)
+            continue;
+
+        ContinentId continent = ContinentId(continentNames->size());
+        continentNames->push_back((*continents)[seed]);
+
+        (*continentOf)[seed] = continent;
+        nextToVisit.clear();
+        nextToVisit.push_back(seed);
+
+        for (size_t head = 0; head < nextToVisit.size(); head++) {
+            for (RegionId next : getLandNeighbours(nextToVisit[head])) {
+                if ((*continentOf)[next] == NO_REGION && (*continents)[next] == (*continents)[seed]) {
+                    (*continentOf)[next] = continent;
+                    nextToVisit.push_back(next);
+                }
+            }
+        }
+    }
+
+    // Group the region IDs by continent with a counting sort.
+    continentOffsets->assign(continentNames->size() + 1, 0);
+    for (RegionId id = 0; id < numRegions; id++)
+        (*continentOffsets)[(*continentOf)[id] + 1]++;
+
+    for (size_t c = 0; c < continentNames->size(); c++)
+        (*continentOffsets)[c + 1] += (*continentOffsets)[c];
+
+    continentMembers->resize(numRegions);
+    vector<uint32_t> next(continentOffsets->begin(), continentOffsets->end() - 1);
+    for (RegionId id = 0; id < numRegions; id++)
+        (*continentMembers)[next[(*continentOf)[id]]++] = id;
+}
+
+//PRIVATE
+/**
+ * Fills in the neighbour bitsets from the adjacency lists. Skipped on maps too large for them,
+ * in which case callers fall back to the adjacency lists (see hasNeighbourMasks()).
+ */
+void MapTopology::buildNeighbourMasks() {
+    if (!hasNeighbourMasks())
+        return;
+
+    const size_t numWords = getMaskWords();
+    landMasks->assign(getNumRegions() * numWords, 0);
+    overWaterMasks->assign(getNumRegions() * numWords, 0);
+
+    for (RegionId id = 0; id < getNumRegions(); id++) {
+        uint64_t* landRow = landMasks->data() + id * numWords;
+        uint64_t* overWaterRow = overWaterMasks->data() + id * numWords;
+
+        for (RegionId next : getLandNeighbours(id))
+            landRow[next >> 6] |= uint64_t(1) << (next & 63);
+
+        for (RegionId next : getNeighbours(id))
+            overWaterRow[next >> 6] |= uint64_t(1) << (next & 63);
+    }
+}
+
+//PRIVATE
+RegionRange MapTopology::range(uint32_t first, uint32_t last) const {
+    const RegionId* base = neighbours->data();
+    RegionRange r = { base + first, base + last };
+    return r;
+}
@@ -0,0 +1,139 @@
+#ifndef MAP_TOPOLOGY_H
+#define MAP_TOPOLOGY_H
+
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "PerfectHash.h"
+
+using namespace std;
+
+typedef uint32_t RegionId;
+typedef uint32_t ContinentId;
+
+const RegionId NO_REGION = UINT32_MAX;
+
+// Neighbour bitsets take numRegions^2 / 4 bytes, so they are only built for maps up to this size.
+const size_t MAX_MASK_REGIONS = 16384;
+
+/**
+ * A read-only view over a contiguous run of region IDs. Used to walk the
+ * neighbours of a region without copying or allocating.
+ */
+struct RegionRange {
+    const RegionId* first;
+    const RegionId* last;
+
+    const RegionId* begin() const { return first; }
+    const RegionId* end() const { return last; }
+    size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+    RegionId operator[](size_t index) const { return first[index]; }
+};
+
+/**
+ * An undirected edge between two regions, as read from a map file.
+ */
+struct RawEdge {
+    RegionId start;
+    RegionId end;
+    bool isWaterEdge;
+};
+
+class DistanceOracle;
+
+class MapTopology {
+    vector<string>* keys;
+    vector<string>* names;
+    vector<string>* continents;
+    PerfectHash* keyHash;
+
+    // Compressed sparse row adjacency. The neighbours of region v are stored in
+    // neighbours[edgeOffsets[v], edgeOffsets[v+1]). The land neighbours come first,
+    // followed by the water neighbours starting at waterOffsets[v]. Both runs are sorted.
+    vector<uint32_t>* edgeOffsets;
+    vector<uint32_t>* waterOffsets;
+    vector<RegionId>* neighbours;
+
+    // Continent partition. The regions of continent c are stored in
+    // continentMembers[continentOffsets[c], continentOffsets[c+1]), sorted by ID.
+    vector<ContinentId>* continentOf;
+    vector<uint32_t>* continentOffsets;
+    vector<RegionId>* continentMembers;
+    vector<string>* continentNames;
+
+    // Neighbour bitsets. Row v holds one bit per region, set for each neighbour of v. The land
+    // rows only hold land neighbours, the over water rows hold every neighbour.
+    vector<uint64_t>* landMasks;
+    vector<uint64_t>* overWaterMasks;
+
+    // Self loops and repeated edges left out of the adjacency lists, kept for the map validator.
+    vector<RawEdge>* droppedEdges;
+
+    // Number of maps sharing the topology. See acquire() and release().
+    atomic<int>* references;
+
+    // Unique to this topology and its current contents. See getGeneration().
+    uint64_t* generation;
+
+    // Hop distances, built on first use. See getDistanceOracle().
+    atomic<DistanceOracle*>* distanceOracle;
+    mutex* oracleLock;
+
+    friend class CompiledMap;
+
+public:
+    MapTopology();
+    MapTopology(const vector<string>& keys, const vector<string>& names,
+                const vector<string>& continents, const vector<RawEdge>& edges);
+    MapTopology(MapTopology* topology);
+    MapTopology& operator=(MapTopology& topology);
+    ~MapTopology();
+
+    MapTopology* acquire();
+    static void release(MapTopology* topology);
+    int getReferenceCount() const { return references->load(); }
+    uint64_t getGeneration() const { return *generation; }
+
+    size_t getNumRegions() const { return keys->size(); }
+    size_t getNumEdges() const { return neighbours->size() / 2; }
+
+    RegionId getId(const string& key) const { return getId(key.data(), key.size()); }
+    RegionId getId(const char* key, size_t length) const;
+    const string& getKey(RegionId id) const { return (*keys)[id]; }
+    const string& getName(RegionId id) const { return (*names)[id]; }
+    const string& getContinent(RegionId id) const { return (*continents)[id]; }
+
+    RegionRange getNeighbours(RegionId id) const;
+    RegionRange getLandNeighbours(RegionId id) const;
+    RegionRange getWaterNeighbours(RegionId id) const;
+
+    bool isAdjacent(RegionId start, RegionId end, bool overWaterAllowed) const;
+
+    size_t getNumContinents() const { return continentNames->size(); }
+    ContinentId getContinentId(RegionId id) const { return (*continentOf)[id]; }
+    const ContinentId* getContinentIds() const { return continentOf->data(); }
+    const string& getContinentName(ContinentId continent) const { return (*continentNames)[continent]; }
+    RegionRange getContinentRegions(ContinentId continent) const;
+
+    bool hasNeighbourMasks() const { return getNumRegions() <= MAX_MASK_REGIONS; }
+    const uint64_t* getLandMask(RegionId id) const { return landMasks->data() + id * getMaskWords(); }
+    const uint64_t* getOverWaterMask(RegionId id) const { return overWaterMasks->data() + id * getMaskWords(); }
+
+    const vector<RawEdge>& getDroppedEdges() const { return *droppedEdges; }
+
+    DistanceOracle* getDistanceOracle() const;
+
+private:
+    void buildAdjacency(const vector<RawEdge>& edges);
+    void buildContinents();
+    void buildNeighbourMasks();
+    static uint64_t nextGeneration();
+    size_t getMaskWords() const { return (getNumRegions() + 63) / 64; }
+    RegionRange range(uint32_t first, uint32_t last) const;
+};
+
+#endif
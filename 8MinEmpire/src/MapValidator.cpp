@@ -0,0 +1,340 @@
+#include "MapValidator.h"
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * Initializes a MapValidator object.
+ *
+ * @param topology A pointer to the topology to check. The validator doesn't own it.
+ */
+MapValidator::MapValidator(const MapTopology* topology):
+    graph(topology),
+    issues(new vector<MapIssue>()),
+    parents(new vector<atomic<RegionId>>()),
+    numThreads(new int(0)) {}
+
+/**
+ * Copy Constructor
+ */
+MapValidator::MapValidator(MapValidator* validator) {
+    graph = validator->graph;
+    issues = new vector<MapIssue>(*validator->issues);
+    parents = new vector<atomic<RegionId>>();
+    numThreads = new int(*validator->numThreads);
+}
+
+/**
+ * Assignment operator
+ */
+MapValidator& MapValidator::operator=(MapValidator& validator) {
+    if (&validator != this) {
+        graph = validator.graph;
+        *issues = *validator.issues;
+        *numThreads = *validator.numThreads;
+    }
+    return *this;
+}
+
+/**
+ * Destructor
+ */
+MapValidator::~MapValidator() {
+    delete issues;
+    delete parents;
+    delete numThreads;
+
+    graph = nullptr;
+    issues = nullptr;
+    parents = nullptr;
+    numThreads = nullptr;
+}
+
+/**
+ * Checks the whole map. The issues found are kept in getIssues().
+ *
+ * @return A boolean representing if the map is valid.
+ */
+bool MapValidator::validate() {
+    issues->clear();
+
+    const size_t numRegions = graph->getNumRegions();
+    if (numRegions == 0) {
+        MapIssue issue = { EMPTY_MAP, NO_REGION, NO_REGION };
+        issues->push_back(issue);
+        return false;
+    }
+
+    uint32_t numNames = 0;
+    vector<uint32_t> nameOf = getContinentNameIds(&numNames);
+
+    // Every region starts as its own component.
+    vector<atomic<RegionId>> components(numRegions);
+    parents->swap(components);
+    for (RegionId id = 0; id < numRegions; id++)
+        (*parents)[id].store(id, memory_order_relaxed);
+
+    // Each thread checks the edges of a run of regions. Its issues are kept apart and appended
+    // in region order afterwards, so the result doesn't depend on the thread timing.
+    const int threadCount = getThreadCount();
+    vector<vector<MapIssue>> found(threadCount);
+    vector<thread> workers;
+
+    for (int t = 1; t < threadCount; t++) {
+        RegionId first = RegionId(numRegions * t / threadCount);
+        RegionId last = RegionId(numRegions * (t + 1) / threadCount);
+        workers.push_back(thread(&MapValidator::checkEdges, this, first, last, cref(nameOf), &found[t]));
+    }
+
+    checkEdges(0, RegionId(numRegions / threadCount), nameOf, &found[0]);
+    for (thread& worker : workers)
+        worker.join();
+
+    checkConnected();
+    checkContinents(nameOf, numNames);
+    for (const vector<MapIssue>& threadIssues : found)
+        issues->insert(issues->end(), threadIssues.begin(), threadIssues.end());
+    checkDroppedEdges();
+
+    stable_sort(issues->begin(), issues->end(), [](const MapIssue& a, const MapIssue& b) {
+        return a.type < b.type;
+    });
+
+    vector<atomic<RegionId>>().swap(*parents);
+    return issues->empty();
+}
+
+/**
+ * Detects if the last call to validate() found an issue of a given type.
+ */
+bool MapValidator::hasIssue(MapIssueType type) {
+    for (const MapIssue& issue : *issues)
+        if (issue.type == type)
+            return true;
+
+    return false;
+}
+
+/**
+ * Describes an issue using the names of the regions and continents involved.
+ */
+string MapValidator::describe(const MapIssue& issue) {
+    const string regionName = issue.region == NO_REGION ? "" : graph->getName(issue.region);
+    const string otherName = issue.other == NO_REGION ? "" : graph->getName(issue.other);
+    const string continent = issue.region == NO_REGION ? "" : graph->getContinent(issue.region);
+
+    switch (issue.type) {
+        case EMPTY_MAP:
+            return "Map is empty.";
+        case DISCONNECTED_MAP:
+            return "Map is not connected. " + regionName + " can't be reached from " + otherName + ".";
+        case SMALL_CONTINENT:
+            return continent + " only has " + regionName + ". A continent can't have less than two regions!";
+        case DISCONNECTED_CONTINENT:
+            return continent + " is not connected over land. " + otherName + " can't be reached from " + regionName + ".";
+        case LAND_EDGE_BETWEEN_CONTINENTS:
+            return regionName + " on " + continent + " and " + otherName + " on " + graph->getContinent(issue.other)
+                + " are joined over land. Continents can only be joined by water edges.";
+        case INTERNAL_WATER_EDGE:
+            return continent + " contains an internal water edge between " + regionName + " and " + otherName;
+        case SELF_LOOP:
+            return regionName + " points to itself.";
+        case DUPLICATE_EDGE:
+            return regionName + " points twice to " + otherName;
+    }
+
+    return "Unknown issue.";
+}
+
+/**
+ * Prints the issues found by the last call to validate().
+ *
+ * @param maxIssues The most issues to print. A broken map can have millions of them.
+ */
+void MapValidator::printIssues(size_t maxIssues) {
+    for (size_t i = 0; i < issues->size() && i < maxIssues; i++)
+        cout << "[ ERROR! ] " << describe((*issues)[i]) << endl;
+
+    if (issues->size() > maxIssues)
+        cout << "[ ERROR! ] ... and " << issues->size() - maxIssues << " more issues." << endl;
+}
+
+//PRIVATE
+/**
+ * Checks the edges of a run of regions and joins their end points in the union-find. Each
+ * edge is seen from both ends, so only the copy on the lower region is looked at.
+ *
+ * @param first The first region to check.
+ * @param last One past the last region to check.
+ * @param nameOf The continent name ID of each region.
+ * @param found A pointer to the list to add the issues to.
+ */
+void MapValidator::checkEdges(RegionId first, RegionId last, const vector<uint32_t>& nameOf, vector<MapIssue>* found) {
+    for (RegionId region = first; region < last; region++) {
+        for (RegionId next : graph->getLandNeighbours(region)) {
+            if (next < region)
+                continue;
+
+            if (nameOf[next] != nameOf[region]) {
+                MapIssue issue = { LAND_EDGE_BETWEEN_CONTINENTS, region, next };
+                found->push_back(issue);
+            }
+            unite(region, next);
+        }
+
+        for (RegionId next : graph->getWaterNeighbours(region)) {
+            if (next < region)
+                continue;
+
+            if (nameOf[next] == nameOf[region]) {
+                MapIssue issue = { INTERNAL_WATER_EDGE, region, next };
+                found->push_back(issue);
+            }
+            unite(region, next);
+        }
+    }
+}
+
+//PRIVATE
+/**
+ * Checks the size and land connectivity of each continent.
+ *
+ * The topology already splits each continent name into the pieces that are connected over
+ * land (see MapTopology::buildContinents()), so a name with more than one piece is a continent
+ * that isn't connected.
+ *
+ * @param nameOf The continent name ID of each region.
+ * @param numNames The number of continent names.
+ */
+void MapValidator::checkContinents(const vector<uint32_t>& nameOf, uint32_t numNames) {
+    vector<uint32_t> sizes(numNames, 0);
+    vector<RegionId> firstRegion(numNames, NO_REGION);
+    vector<bool> isSplit(numNames, false);
+
+    for (ContinentId continent = 0; continent < graph->getNumContinents(); continent++) {
+        RegionRange regions = graph->getContinentRegions(continent);
+        uint32_t name = nameOf[regions[0]];
+
+        if (firstRegion[name] == NO_REGION) {
+            firstRegion[name] = regions[0];
+        } else if (!isSplit[name]) {
+            MapIssue issue = { DISCONNECTED_CONTINENT, firstRegion[name], regions[0] };
+            issues->push_back(issue);
+            isSplit[name] = true;
+        }
+
+        sizes[name] += uint32_t(regions.size());
+    }
+
+    for (uint32_t name = 0; name < numNames; name++) {
+        if (sizes[name] < 2) {
+            MapIssue issue = { SMALL_CONTINENT, firstRegion[name], NO_REGION };
+            issues->push_back(issue);
+        }
+    }
+}
+
+//PRIVATE
+/**
+ * Finds the regions that can't be reached from region 0. The union-find always keeps the
+ * lowest region of a component as its root, so every other root starts a separate component.
+ */
+void MapValidator::checkConnected() {
+    for (RegionId id = 1; id < graph->getNumRegions(); id++) {
+        if (findRoot(id) == id) {
+            MapIssue issue = { DISCONNECTED_MAP, id, 0 };
+            issues->push_back(issue);
+        }
+    }
+}
+
+//PRIVATE
+/**
+ * Reports the self loops and repeated edges the topology left out of its adjacency lists.
+ */
+void MapValidator::checkDroppedEdges() {
+    for (const RawEdge& edge : graph->getDroppedEdges()) {
+        MapIssue issue = { edge.start == edge.end ? SELF_LOOP : DUPLICATE_EDGE, edge.start, edge.end };
+        issues->push_back(issue);
+    }
+}
+
+//PRIVATE
+/**
+ * Numbers the continent names. Regions on the same continent get the same number.
+ *
+ * @param numNames A pointer to an integer to fill with the number of continent names.
+ * @return The continent name ID of each region.
+ */
+vector<uint32_t> MapValidator::getContinentNameIds(uint32_t* numNames) {
+    unordered_map<string, uint32_t> nameIds;
+    vector<uint32_t> continentNameIds(graph->getNumContinents());
+
+    for (ContinentId continent = 0; continent < graph->getNumContinents(); continent++) {
+        pair<unordered_map<string, uint32_t>::iterator, bool> inserted =
+            nameIds.insert(pair<string, uint32_t>(graph->getContinentName(continent), uint32_t(nameIds.size())));
+        continentNameIds[continent] = inserted.first->second;
+    }
+
+    vector<uint32_t> nameOf(graph->getNumRegions());
+    for (RegionId id = 0; id < nameOf.size(); id++)
+        nameOf[id] = continentNameIds[graph->getContinentId(id)];
+
+    *numNames = uint32_t(nameIds.size());
+    return nameOf;
+}
+
+//PRIVATE
+/**
+ * Finds the root of a region's component, halving the path on the way up.
+ */
+RegionId MapValidator::findRoot(RegionId region) {
+    while (true) {
+        RegionId parent = (*parents)[region].load(memory_order_relaxed);
+        if (parent == region)
+            return region;
+
+        RegionId grandparent = (*parents)[parent].load(memory_order_relaxed);
+        if (grandparent != parent)
+            (*parents)[region].compare_exchange_weak(parent, grandparent, memory_order_relaxed);
+
+        region = grandparent;
+    }
+}
+
+//PRIVATE
+/**
+ * Joins the components of two regions. The higher root is linked under the lower one, and only
+ * if it is still a root, so threads can join components at the same time.
+ */
+void MapValidator::unite(RegionId a, RegionId b) {
+    while (true) {
+        a = findRoot(a);
+        b = findRoot(b);
+        if (a == b)
+            return;
+
+        if (a < b)
+            swap(a, b);
+
+        RegionId expected = a;
+        if ((*parents)[a].compare_exchange_strong(expected, b))
+            return;
+    }
+}
+
+//PRIVATE
+/**
+ * Gets the number of threads to validate with. Small maps aren't worth starting threads for.
+ */
+int MapValidator::getThreadCount() {
+    if (*numThreads > 0)
+        return *numThreads;
+
+    if (graph->getNumRegions() < MIN_PARALLEL_REGIONS)
+        return 1;
+
+    return max(1, int(thread::hardware_concurrency()));
+}
@@ -0,0 +1,81 @@
+#ifndef MAP_VALIDATOR_H
+#define MAP_VALIDATOR_H
+
+#include "MapTopology.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Maps with fewer regions than this are validated on the calling thread.
+const size_t MIN_PARALLEL_REGIONS = 65536;
+
+enum MapIssueType {
+    EMPTY_MAP,
+    DISCONNECTED_MAP,
+    SMALL_CONTINENT,
+    DISCONNECTED_CONTINENT,
+    LAND_EDGE_BETWEEN_CONTINENTS,
+    INTERNAL_WATER_EDGE,
+    SELF_LOOP,
+    DUPLICATE_EDGE
+};
+
+/**
+ * A problem found on a map. region and other are the regions involved, or NO_REGION.
+ *
+ * DISCONNECTED_MAP: region can't be reached from other.
+ * SMALL_CONTINENT, DISCONNECTED_CONTINENT: region is the first region of the continent. For a
+ *     disconnected continent, other is a region of the same continent that region can't reach.
+ * The edge issues: region and other are the end points of the edge.
+ */
+struct MapIssue {
+    MapIssueType type;
+    RegionId region;
+    RegionId other;
+};
+
+/**
+ * Checks a map topology in a single pass.
+ *
+ * A valid map is connected, every continent has at least two regions and is connected over land,
+ * continents are only joined by water edges, and there are no internal water edges, self loops
+ * or repeated edges. A continent is every region with the same continent name.
+ *
+ * The edges are checked and the connected components found with a concurrent union-find, split
+ * across threads on large maps. The issues are reported in the same order on every run.
+ */
+class MapValidator {
+    const MapTopology* graph;
+    vector<MapIssue>* issues;
+    vector<atomic<RegionId>>* parents;
+    int* numThreads;
+
+public:
+    MapValidator(const MapTopology* topology);
+    MapValidator(MapValidator* validator);
+    MapValidator& operator=(MapValidator& validator);
+    ~MapValidator();
+
+    bool validate();
+
+    const vector<MapIssue>& getIssues() { return *issues; }
+    bool hasIssue(MapIssueType type);
+    string describe(const MapIssue& issue);
+    void printIssues(size_t maxIssues = 10);
+    void setNumThreads(int threads) { *numThreads = threads; }
+
+private:
+    void checkEdges(RegionId first, RegionId last, const vector<uint32_t>& nameOf, vector<MapIssue>* found);
+    void checkContinents(const vector<uint32_t>& nameOf, uint32_t numNames);
+    void checkConnected();
+    void checkDroppedEdges();
+    vector<uint32_t> getContinentNameIds(uint32_t* numNames);
+    RegionId findRoot(RegionId region);
+    void unite(RegionId a, RegionId b);
+    int getThreadCount();
+};
+
+#endif
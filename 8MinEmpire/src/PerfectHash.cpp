@@ -0,0 +1,214 @@
+#include "PerfectHash.h"
+
+#include <algorithm>
+
+// Displacements tried for a bucket before starting over with another seed.
+const int32_t MAX_DISPLACEMENT = 1 << 20;
+
+/**
+ * Mixes the bits of a 64 bit value (the splitmix64 finalizer).
+ */
+static uint64_t mix(uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+/**
+ * Default Constructor
+ */
+PerfectHash::PerfectHash():
+    seed(new uint64_t(0)),
+    displacements(new vector<int32_t>()),
+    slots(new vector<uint32_t>()) {}
+
+/**
+ * Copy Constructor
+ */
+PerfectHash::PerfectHash(PerfectHash* perfectHash) {
+    seed = new uint64_t(*perfectHash->seed);
+    displacements = new vector<int32_t>(*perfectHash->displacements);
+    slots = new vector<uint32_t>(*perfectHash->slots);
+}
+
+/**
+ * Assignment operator
+ */
+PerfectHash& PerfectHash::operator=(PerfectHash& perfectHash) {
+    if (&perfectHash != this) {
+        *seed = *perfectHash.seed;
+        *displacements = *perfectHash.displacements;
+        *slots = *perfectHash.slots;
+    }
+    return *this;
+}
+
+/**
+ * Destructor
+ */
+PerfectHash::~PerfectHash() {
+    delete seed;
+    delete displacements;
+    delete slots;
+
+    seed = nullptr;
+    displacements = nullptr;
+    slots = nullptr;
+}
+
+/**
+ * Builds the hash over a list of keys. The index of a key in the list is what find() returns.
+ *
+ * @param keys The keys. They must all be different.
+ */
+void PerfectHash::build(const vector<string>& keys) {
+    for (uint64_t attempt = 0; ; attempt++) {
+        *seed = mix(attempt);
+        if (tryBuild(keys))
+            return;
+    }
+}
+
+/**
+ * Finds the index of a key.
+ *
+ * @param key The characters of the key.
+ * @param length The number of characters.
+ * @return The index the key would have. It is only the right key if it compares equal to the
+ * key at that index. Returns NO_KEY if the hash is empty.
+ */
+uint32_t PerfectHash::find(const char* key, size_t length) const {
+    if (slots->empty())
+        return NO_KEY;
+
+    uint64_t hash = hashKey(key, length);
+    int32_t displacement = (*displacements)[(hash >> 32) % displacements->size()];
+    return (*slots)[getSlot(hash, displacement)];
+}
+
+//PRIVATE
+/**
+ * Tries to place every key with the current seed.
+ *
+ * The buckets are placed from the largest to the smallest, while the table is still mostly
+ * empty. Buckets with a single key don't need a search and go straight to a free slot.
+ *
+ * @param keys The keys.
+ * @return A boolean representing if every bucket found a displacement.
+ */
+bool PerfectHash::tryBuild(const vector<string>& keys) {
+    const uint32_t numKeys = uint32_t(keys.size());
+    const uint32_t numBuckets = numKeys;
+
+    displacements->assign(numBuckets, 0);
+    slots->assign(numKeys, NO_KEY);
+    if (numKeys == 0)
+        return true;
+
+    vector<uint64_t> hashes(numKeys);
+    vector<uint32_t> bucketStart(numBuckets + 1, 0);
+    for (uint32_t key = 0; key < numKeys; key++) {
+        hashes[key] = hashKey(keys[key].data(), keys[key].size());
+        bucketStart[(hashes[key] >> 32) % numBuckets + 1]++;
+    }
+
+    // Sort the keys by bucket, then the buckets by size, both with a counting sort.
+    uint32_t largest = 0;
+    for (uint32_t bucket = 0; bucket < numBuckets; bucket++) {
+        largest = max(largest, bucketStart[bucket + 1]);
+        bucketStart[bucket + 1] += bucketStart[bucket];
+    }
+
+    vector<uint32_t> members(numKeys);
+    vector<uint32_t> next(bucketStart.begin(), bucketStart.end() - 1);
+    for (uint32_t key = 0; key < numKeys; key++)
+        members[next[(hashes[key] >> 32) % numBuckets]++] = key;
+
+    vector<uint32_t> sizeStart(largest + 2, 0);
+    for (uint32_t bucket = 0; bucket < numBuckets; bucket++)
+        sizeStart[largest - (bucketStart[bucket + 1] - bucketStart[bucket]) + 1]++;
+    for (uint32_t i = 0; i <= largest; i++)
+        sizeStart[i + 1] += sizeStart[i];
+
+    vector<uint32_t> order(numBuckets);
+    for (uint32_t bucket = 0; bucket < numBuckets; bucket++)
+        order[sizeStart[largest - (bucketStart[bucket + 1] - bucketStart[bucket])]++] = bucket;
+
+    vector<bool> taken(numKeys, false);
+    vector<uint32_t> chosen;
+    uint32_t freeSlot = 0;
+
+    for (uint32_t bucket : order) {
+        const uint32_t first = bucketStart[bucket];
+        const uint32_t last = bucketStart[bucket + 1];
+
+        if (last - first == 0)
+            break;
+
+        if (last - first == 1) {
+            while (taken[freeSlot])
+                freeSlot++;
+
+            taken[freeSlot] = true;
+            (*slots)[freeSlot] = members[first];
+            (*displacements)[bucket] = -int32_t(freeSlot) - 1;
+            continue;
+        }
+
+        int32_t displacement = 1;
+        while (true) {
+            if (displacement == MAX_DISPLACEMENT)
+                return false;
+
+            chosen.clear();
+            for (uint32_t i = first; i < last; i++) {
+                uint32_t slot = getSlot(hashes[members[i]], displacement);
+                if (taken[slot])
+                    break;
+
+                taken[slot] = true;
+                chosen.push_back(slot);
+            }
+
+            if (chosen.size() == last - first)
+                break;
+
+            for (uint32_t slot : chosen)
+                taken[slot] = false;
+            displacement++;
+        }
+
+        for (uint32_t i = first; i < last; i++)
+            (*slots)[chosen[i - first]] = members[i];
+        (*displacements)[bucket] = displacement;
+    }
+
+    return true;
+}
+
+//PRIVATE
+/**
+ * Gets the slot of a key. Negative displacements hold the slot itself, for buckets with a
+ * single key.
+ */
+uint32_t PerfectHash::getSlot(uint64_t hash, int32_t displacement) const {
+    if (displacement < 0)
+        return uint32_t(-(displacement + 1));
+
+    return uint32_t((hash + uint64_t(displacement) * (mix(hash) | 1)) % slots->size());
+}
+
+//PRIVATE
+/**
+ * Hashes a key with the current seed: 64 bit FNV-1a, mixed so every bit depends on every byte.
+ */
+uint64_t PerfectHash::hashKey(const char* key, size_t length) const {
+    uint64_t hash = 14695981039346656037ULL ^ *seed;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= uint8_t(key[i]);
+        hash *= 1099511628211ULL;
+    }
+
+    return mix(hash);
+}
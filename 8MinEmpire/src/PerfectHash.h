@@ -0,0 +1,45 @@
+#ifndef PERFECT_HASH_H
+#define PERFECT_HASH_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+const uint32_t NO_KEY = UINT32_MAX;
+
+/**
+ * A minimal perfect hash over a fixed list of distinct keys, built with hash and displace.
+ *
+ * The keys are thrown into buckets, and each bucket gets a displacement that sends all of its
+ * keys to free slots. There are as many slots as keys, so every key gets a slot of its own and
+ * a lookup is two hashes and two array reads, with no probing. Only the keys' indices are kept,
+ * not the keys themselves, so a key that isn't in the list still maps to some index and the
+ * caller has to compare it against the key at that index.
+ */
+class PerfectHash {
+    uint64_t* seed;
+    vector<int32_t>* displacements;
+    vector<uint32_t>* slots;
+
+    friend class CompiledMap;
+
+public:
+    PerfectHash();
+    PerfectHash(PerfectHash* perfectHash);
+    PerfectHash& operator=(PerfectHash& perfectHash);
+    ~PerfectHash();
+
+    void build(const vector<string>& keys);
+    uint32_t find(const char* key, size_t length) const;
+    uint32_t find(const string& key) const { return find(key.data(), key.size()); }
+    size_t size() const { return slots->size(); }
+
+private:
+    bool tryBuild(const vector<string>& keys);
+    uint32_t getSlot(uint64_t hash, int32_t displacement) const;
+    uint64_t hashKey(const char* key, size_t length) const;
+};
+
+#endif
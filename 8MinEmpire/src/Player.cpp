@@ -3,28 +3,36 @@
 #include "Cards.h"
 #include "util/MapUtil.h"
 #include "PlayerStrategies.h"
-#include "GameInit.h"
+#include "GameContext.h"
 
 #include <algorithm>
+#include <cstring>
 
 class GameMap;
-class InitGameEngine;
 
 /**
  * Default constructor
  */
 Player::Player():
     name(new string("N O  O N E")),
-    regions(new Vertices()),
-    armies(new int(14)),
-    cities(new int(3)),
+    regions(new OccupiedRegions()),
+    armies(new int(START_ARMIES)),
+    cities(new int(START_CITIES)),
     coins(new int(0)),
-    hand(new vector<Card*>()),
+    hand(new vector<const CardInfo*>()),
+    goods(new GoodsCount()),
     bidder(new Bidder(this)),
     colour(new string("none")),
-    playerEntry(new PlayerEntry(*name, *colour)),
+    id(new PlayerId(NO_PLAYER)),
     controlledRegions(new int(0)),
-    strategy(new HumanStrategy()) {}
+    strategy(new HumanStrategy()),
+    occupiedMask(new RegionSet()),
+    landReach(new RegionSet()),
+    overWaterReach(new RegionSet()),
+    reachIsStale(new bool(true)),
+    maskTopology(nullptr),
+    maskGeneration(new uint64_t(0)),
+    context(nullptr) {}
 
 /**
  * Initializes a Player object.
@@ -37,16 +45,24 @@ Player::Player():
  */
 Player::Player(const string &playerName, const string& theColour):
     name(new string(playerName)),
-    regions(new Vertices()),
-    armies(new int(14)),
-    cities(new int(3)),
+    regions(new OccupiedRegions()),
+    armies(new int(START_ARMIES)),
+    cities(new int(START_CITIES)),
     coins(new int(0)),
-    hand(new vector<Card*>()),
+    hand(new vector<const CardInfo*>()),
+    goods(new GoodsCount()),
     bidder(new Bidder(this)),
     colour(new string(theColour)),
-    playerEntry(new PlayerEntry(*name, *colour)),
+    id(new PlayerId(NO_PLAYER)),
     controlledRegions(new int(0)),
-    strategy(new HumanStrategy())
+    strategy(new HumanStrategy()),
+    occupiedMask(new RegionSet()),
+    landReach(new RegionSet()),
+    overWaterReach(new RegionSet()),
+    reachIsStale(new bool(true)),
+    maskTopology(nullptr),
+    maskGeneration(new uint64_t(0)),
+    context(nullptr)
 {
     cout << "\n{ " << *name << " } CREATED. [ " << *colour << " ] (Purse = 0)." << endl;
 }
@@ -62,16 +78,24 @@ Player::Player(const string &playerName, const string& theColour):
  */
 Player::Player(const string& playerName, const int& startCoins):
     name(new string(playerName)),
-    regions(new Vertices()),
-    armies(new int(14)),
-    cities(new int(3)),
+    regions(new OccupiedRegions()),
+    armies(new int(START_ARMIES)),
+    cities(new int(START_CITIES)),
     coins(new int(startCoins)),
-    hand(new vector<Card*>()),
+    hand(new vector<const CardInfo*>()),
+    goods(new GoodsCount()),
     bidder(new Bidder(this)),
     colour(new string("")),
-    playerEntry(new PlayerEntry(*name, *colour)),
+    id(new PlayerId(NO_PLAYER)),
     controlledRegions(new int(0)),
-    strategy(new HumanStrategy())
+    strategy(new HumanStrategy()),
+    occupiedMask(new RegionSet()),
+    landReach(new RegionSet()),
+    overWaterReach(new RegionSet()),
+    reachIsStale(new bool(true)),
+    maskTopology(nullptr),
+    maskGeneration(new uint64_t(0)),
+    context(nullptr)
 {
     cout << "{ " << *name << " } CREATED. (Purse = " << startCoins << ")." << endl;
 }
@@ -88,16 +112,24 @@ Player::Player(const string& playerName, const int& startCoins):
  */
 Player::Player(const string &playerName, const string& theColour, Strategy* theStrategy):
     name(new string(playerName)),
-    regions(new Vertices()),
-    armies(new int(14)),
-    cities(new int(3)),
+    regions(new OccupiedRegions()),
+    armies(new int(START_ARMIES)),
+    cities(new int(START_CITIES)),
     coins(new int(0)),
-    hand(new vector<Card*>()),
+    hand(new vector<const CardInfo*>()),
+    goods(new GoodsCount()),
     bidder(new Bidder(this)),
     colour(new string(theColour)),
-    playerEntry(new PlayerEntry(*name, *colour)),
+    id(new PlayerId(NO_PLAYER)),
     controlledRegions(new int(0)),
-    strategy(theStrategy)
+    strategy(theStrategy),
+    occupiedMask(new RegionSet()),
+    landReach(new RegionSet()),
+    overWaterReach(new RegionSet()),
+    reachIsStale(new bool(true)),
+    maskTopology(nullptr),
+    maskGeneration(new uint64_t(0)),
+    context(nullptr)
 {
     cout << "\n{ " << *name << " } CREATED. [ " << *colour << " ] (Purse = 0) { Strategy " << strategy->getType() << " }." << endl;
 }
@@ -107,16 +139,24 @@ Player::Player(const string &playerName, const string& theColour, Strategy* theS
  */
 Player::Player(Player* player){
     name = new string(player->getName());
-    regions = new Vertices(*player->getOccupiedRegions());
+    regions = new OccupiedRegions(*player->getOccupiedRegions());
     armies = new int(player->getArmies());
     cities = new int(player->getCities());
     coins = new int(player->getCoins());
-    hand = new vector<Card*>(*player->getHand());
+    hand = new vector<const CardInfo*>(*player->getHand());
+    goods = new GoodsCount(*player->goods);
     bidder = new Bidder(player->getBidder());
     colour = new string(player->getColour());
-    playerEntry = new PlayerEntry(player->getPlayerEntry()->first, player->getPlayerEntry()->second);
+    id = new PlayerId(*player->id);
     controlledRegions = new int(player->getControlledRegions());
     strategy = player->getStrategy();
+    occupiedMask = new RegionSet(player->occupiedMask);
+    landReach = new RegionSet(player->landReach);
+    overWaterReach = new RegionSet(player->overWaterReach);
+    reachIsStale = new bool(*player->reachIsStale);
+    maskTopology = player->maskTopology;
+    maskGeneration = new uint64_t(*player->maskGeneration);
+    context = player->context;
 }
 
 /**
@@ -124,33 +164,43 @@ Player::Player(Player* player){
  */
 Player& Player::operator=(Player& player) {
     if (&player != this) {
-        //Delete all the cards the player holds.
-        for(vector<Card*>::iterator it = hand->begin(); it != hand->end(); ++it)
-            delete *it;
-
         delete name;
         delete regions;
         delete armies;
         delete cities;
         delete coins;
         delete hand;
+        delete goods;
         delete bidder;
         delete colour;
-        delete playerEntry;
+        delete id;
         delete controlledRegions;
         delete strategy;
+        delete occupiedMask;
+        delete landReach;
+        delete overWaterReach;
+        delete reachIsStale;
+        delete maskGeneration;
 
         name = new string(player.getName());
-        regions = new Vertices(*player.getOccupiedRegions());
+        regions = new OccupiedRegions(*player.getOccupiedRegions());
         armies = new int(player.getArmies());
         cities = new int(player.getCities());
         coins = new int(player.getCoins());
-        hand = new vector<Card*>(*player.getHand());
+        hand = new vector<const CardInfo*>(*player.getHand());
+        goods = new GoodsCount(*player.goods);
         bidder = new Bidder(player.getBidder());
         colour = new string(player.getColour());
-        playerEntry = new PlayerEntry(player.getPlayerEntry()->first, player.getPlayerEntry()->second);
+        id = new PlayerId(*player.id);
         controlledRegions = new int(player.getControlledRegions());
         strategy = player.getStrategy();
+        occupiedMask = new RegionSet(player.occupiedMask);
+        landReach = new RegionSet(player.landReach);
+        overWaterReach = new RegionSet(player.overWaterReach);
+        reachIsStale = new bool(*player.reachIsStale);
+        maskTopology = player.maskTopology;
+        maskGeneration = new uint64_t(*player.maskGeneration);
+        context = player.context;
     }
     return *this;
 }
@@ -159,21 +209,23 @@ Player& Player::operator=(Player& player) {
  * Destructor
  */
 Player::~Player(){
-    //Delete all the cards the player holds.
-    for(vector<Card*>::iterator it = hand->begin(); it != hand->end(); ++it)
-        delete *it;
-
     delete name;
     delete regions;
     delete armies;
     delete cities;
     delete coins;
     delete hand;
+    delete goods;
     delete bidder;
     delete colour;
-    delete playerEntry;
+    delete id;
     delete controlledRegions;
     delete strategy;
+    delete occupiedMask;
+    delete landReach;
+    delete overWaterReach;
+    delete reachIsStale;
+    delete maskGeneration;
 
     name = nullptr;
     regions = nullptr;
@@ -181,11 +233,19 @@ Player::~Player(){
     cities = nullptr;
     coins = nullptr;
     hand = nullptr;
+    goods = nullptr;
     bidder = nullptr;
     colour = nullptr;
-    playerEntry = nullptr;
+    id = nullptr;
     controlledRegions = nullptr;
     strategy = nullptr;
+    occupiedMask = nullptr;
+    landReach = nullptr;
+    overWaterReach = nullptr;
+    reachIsStale = nullptr;
+    maskTopology = nullptr;
+    maskGeneration = nullptr;
+    context = nullptr;
 }
 
 /**
@@ -222,7 +282,7 @@ void Player::BuildCity() {
  *
  * @param action The action to be executed.
  */
-void Player::MoveOverLand(const string action, Players* players){
+void Player::MoveOverLand(const Action& action, Players* players){
     MoveArmies(action, players);
 }
 
@@ -231,7 +291,7 @@ void Player::MoveOverLand(const string action, Players* players){
  *
  * @param action The action to be executed.
  */
-void Player::MoveOverWater(const string action, Players* players){
+void Player::MoveOverWater(const Action& action, Players* players){
     MoveArmies(action, players);
 }
 
@@ -242,7 +302,7 @@ void Player::MoveOverWater(const string action, Players* players){
  *
  * @param action The action to be executed.
  */
-void Player::MoveArmies(const string action, Players* players) {
+void Player::MoveArmies(const Action& action, Players* players) {
     strategy->MoveArmies(this, action, players);
 }
 
@@ -254,7 +314,7 @@ void Player::MoveArmies(const string action, Players* players) {
  * @param action The action to be executed.
  * @param players A pointer to the players in the game.
  */
-void Player::PlaceNewArmies(const string action, Players* players) {
+void Player::PlaceNewArmies(const Action& action, Players* players) {
     strategy->PlaceNewArmies(this, action, players);
 }
 
@@ -276,15 +336,32 @@ void Player::DestroyArmy(Players* players) {
  * @param action The action that contains an AND/OR double action
  * @param players A pointer to a map of Player pointers and their names.
  */
-void Player::AndOrAction(const string action, Players* players) {
+void Player::AndOrAction(const CardAction& action, Players* players) {
     strategy->AndOrAction(this, action, players);
 }
 
+/**
+ * Executes the action of a card. Double actions go to AndOrAction(), single actions are
+ * dispatched on their type by the player's strategy.
+ *
+ * @param action The compiled action of the card.
+ * @param players A pointer to a map of Player pointers and their names.
+ */
+void Player::performCardAction(const CardAction& action, Players* players) {
+    if (action.isDouble())
+        AndOrAction(action, players);
+    else
+        strategy->performAction(this, action.first, players);
+}
+
 /**
  * Ignores the card action.
  */
 void Player::Ignore() {
     cout << "\n{ " << *name << " } Ignoring card action ... \n" << endl;
+
+    if (getRecorder())
+        getRecorder()->recordIgnore(this);
 }
 
 /**
@@ -361,14 +438,15 @@ int Player::computeContinentScore() {
  * @return The total victory points for each card type.
  */
 int Player::computeGoodsScore() {
-    unordered_map<string, int>* goodsCount = getGoodsCount();
+    GoodsCount goodsCount = *goods;
 
     findAndDistributeWildCards(goodsCount);
 
     int points = getVPFromGoods(goodsCount);
 
-    for(unordered_map<string, int>::iterator it = goodsCount->begin(); it != goodsCount->end(); ++it) {
-        cout << "{ " << *name << " } Owns " << it->second << " " << it->first << " cards." << endl;
+    for (int good = 0; good < GOOD_WILD; good++) {
+        if (goodsCount[good] > 0)
+            cout << "{ " << *name << " } Owns " << int(goodsCount[good]) << " " << getGoodName(GoodId(good)) << " cards." << endl;
     }
 
     cout << "{ " << *name << " } Has " << points << " card points." << endl;
@@ -383,11 +461,11 @@ int Player::computeGoodsScore() {
 vector<string>* Player::getRegions() {
     vector<string>* ownedRegions = new vector<string>();
 
-    Vertices::iterator it;
+    OccupiedRegions::iterator it;
     for (it = regions->begin(); it != regions->end(); ++it) {
         Vertex* region = it->second;
 
-        if (region->getRegionOwner() == *name) {
+        if (region->getOwner() == getId()) {
             ownedRegions->push_back(region->getName());
         }
     }
@@ -400,138 +478,98 @@ vector<string>* Player::getRegions() {
  * @return A pointer to a vector of strings.
  */
 vector<string>* Player::getOwnedContinents() {
-
-    vector<set<string>* > continents = GameMap::instance()->getContinents();
+    GameMap* map = getMap();
+    MapTopology* graph = map->getTopology();
     vector<string>* ownedContinents = new vector<string>();
 
      //Iterate through each continent and get the owner.
-    for(vector<set<string>* >::iterator it = continents.begin(); it != continents.end(); ++it) {
-
-        set<string>* continent = *it;
-        string continentName = GameMap::instance()->getVertices()->find(*continent->begin())->second->getContinent();
-        string owner = GameMap::instance()->getContinentOwner(continent);
-
-        if(owner == *name) {
-            ownedContinents->push_back(continentName);
+    for(ContinentId continent = 0; continent < graph->getNumContinents(); continent++) {
+        if(map->getContinentOwner(continent) == getId()) {
+            ownedContinents->push_back(graph->getContinentName(continent));
         }
     }
 
-    for ( set<string>* c : continents) {
-        delete c;
-    }
-
     return ownedContinents;
 }
 
 /**
  * Returns the number of victory points calculated from the cards the player holds in their hand.
  *
- * @param goodsCount An unordered_map<string,int> pointer that maps the name of the good to how many.
+ * @param goodsCount How many of each good, with the wild goods already added to the others.
  * @return The number of victory points.
  */
-int Player::getVPFromGoods(unordered_map<string, int>* goodsCount) {
-                                    // 0 1 2 3 4 5 6 7 8 9 0 1 2 3
-    int woodValuePerCardCount[]     = {0,0,1,1,2,3,5,5,5,5,5,5,5,5};
-    int ironValuePerCardCount[]     = {0,0,1,1,2,2,3,5,5,5,5,5,5,5};
-    int carrotValuePerCardCount[]   = {0,0,0,1,1,2,2,3,5,5,5,5,5,5};
-    int stoneValuePerCardCount[]    = {0,0,1,2,3,5,5,5,5,5,5,5,5,5};
-    int gemValuePerCardCount[]      = {0,1,2,3,5,5,5,5,5,5,5,5,5,5};
-
-    int points = 0;
-
-    for(unordered_map<string, int>::iterator it = goodsCount->begin(); it != goodsCount->end(); ++it) {
-        if (it->first == GEM)
-            points += gemValuePerCardCount[it->second];
-        else if(it->first == WOOD)
-            points += woodValuePerCardCount[it->second];
-        else if(it->first == IRON)
-            points += ironValuePerCardCount[it->second];
-        else if(it->first == STONE)
-            points += stoneValuePerCardCount[it->second];
-        else if(it->first == CARROT)
-            points += carrotValuePerCardCount[it->second];
-        else if(it->first == WILD)
-            ;//Do nothing
-        else if(it->first == NONE)
-            ;//Do nothing
-        else
-            cout << "[ ERROR! ] Invalid card type. " << it->first << endl;
-    }
-
-    return points;
-}
-
-/**
- * Returns a mapping of the type of good to how many the player has in their hand.
- * @return unordered_map<string, int> pointer.
- */
-unordered_map<string, int>* Player::getGoodsCount() {
-    unordered_map<string, int>* goodsCount = new unordered_map<string, int>();
-
-    for(vector<Card*>::iterator it = hand->begin(); it != hand->end(); ++it) {
-        string good = (*it)->getGood();
-
-        // Check if card has double good
-        size_t spaceCharIndex = good.find(" ");
-
-        int countIncrement = 1;
-        if (spaceCharIndex != size_t(-1)) {
-            countIncrement = 2;
-            good = good.substr(0, spaceCharIndex);
-        }
-
-        if (goodsCount->find(good) != goodsCount->end()) {
-            int count = goodsCount->find(good)->second;
-            goodsCount->erase(good);
-            goodsCount->insert(pair<string,int>(good,count+countIncrement));
-        } else
-            goodsCount->insert(pair<string,int>(good,countIncrement));
-    }
-
-    return goodsCount;
+int Player::getVPFromGoods(const GoodsCount& goodsCount) {
+    return getGoodsPoints(goodsCount);
 }
 
 /**
  * Detects if a region is adjacent to at least one the player's currently
  * occupied regions.
  *
+ * The player keeps the union of the neighbour bitsets of every occupied region, so this
+ * is a single bit test. Maps too large for bitsets fall back to the adjacency lists.
+ *
  * @param target A Vertex pointer to the target region.
  * @param overWaterAllowed A boolean representing if the region is allowed to be across a water edge.
  * @return a boolean representing if the region is adjacent.
  */
 bool Player::isAdjacent(Vertex* target, const bool& overWaterAllowed){
-    return isAdjacent(target->getName(), overWaterAllowed);
+    MapTopology* graph = getMap()->getTopology();
+    RegionId targetId = target->getId();
+
+    if (graph->hasNeighbourMasks()) {
+        syncOccupiedMask();
+        if (*reachIsStale)
+            rebuildReach();
+
+        return (overWaterAllowed ? overWaterReach : landReach)->contains(targetId);
+    }
+
+    for (OccupiedRegions::iterator it = regions->begin(); it != regions->end(); ++it) {
+        RegionId regionId = it->second->getId();
+
+        if (regionId == targetId || graph->isAdjacent(regionId, targetId, overWaterAllowed))
+            return true;
+    }
+
+    return false;
 }
 
 /**
  * Detects if a region is adjacent to at least one the player's currently
  * occupied regions.
  *
- * @param target The target region name.
+ * @param target The target region key.
  * @param overWaterAllowed A boolean representing if the region is allowed to be across a water edge.
  * @return a boolean representing if the region is adjacent.
  */
 bool Player::isAdjacent(const string& target, const bool& overWaterAllowed){
-    typedef pair<Vertex*, bool> Edge;
-
-    Vertices::iterator it = regions->begin();
-    set<string> visited;
+    GameMap* map = getMap();
+    RegionId targetId = map->getTopology()->getId(target);
 
-    while(it != regions->end()) {
-
-        if (it->second->getName() == target)
-            return true;
+    if (targetId == NO_REGION)
+        return false;
 
-        if (visited.find(it->first) == visited.end())
-            for(Edge& e : *it->second->getEdges())
-                if (e.first->getName() == target && (!e.second || (e.second && overWaterAllowed)))
-                    return true;
+    return isAdjacent(map->getVertex(targetId), overWaterAllowed);
+}
 
-        visited.insert(it->first);
-        ++it;
+/**
+ * Detects if the player occupies a region, with a single bit test on the occupied regions bitset.
+ *
+ * @param region A Vertex pointer to the region.
+ * @return a boolean representing if the region is one of the player's occupied regions.
+ */
+bool Player::occupiesRegion(Vertex* region) {
+    syncOccupiedMask();
+    RegionId id = region->getId();
+
+    // A region that isn't on the map has no bit, so it can only be in the list.
+    if (id >= maskTopology->getNumRegions()) {
+        OccupiedRegions::iterator it = regions->find(id);
+        return it != regions->end() && it->second == region;
     }
 
-    return false;
+    return occupiedMask->contains(id);
 }
 
 /**
@@ -541,8 +579,8 @@ bool Player::isAdjacent(const string& target, const bool& overWaterAllowed){
  * @return the number of armies on the region.
  */
 int Player::getArmiesOnRegion(Vertex* region) {
-    if(regions->find(region->getKey()) != regions->end()) {
-        int numArmies = region->getArmies()->find(playerEntry)->second;
+    if(occupiesRegion(region)) {
+        int numArmies = region->getArmiesOf(getId());
         string army = numArmies == 1 ? "army" : "armies";
         cout << "{ " << *name << " } Has " << numArmies << " " << army << " on region < " << region->getName() << " >." << endl;
         return numArmies;
@@ -558,8 +596,8 @@ int Player::getArmiesOnRegion(Vertex* region) {
  * @return the number of cities on the region.
  */
 int Player::getCitiesOnRegion(Vertex* region){
-    if(regions->find(region->getKey()) != regions->end()) {
-        int numCities = region->getCities()->find(playerEntry)->second;
+    if(occupiesRegion(region)) {
+        int numCities = region->getCitiesOf(getId());
         string city = numCities == 1 ? "city" : "cities";
         cout << "{ " << *name << " } Has " << numCities << " " << city << " on region < " << region->getName() << " >." << endl;
         return numCities;
@@ -573,11 +611,14 @@ int Player::getCitiesOnRegion(Vertex* region){
  *
  * Preconditions: Player has successfuly paid for card.
  *
- * @param card A Card pointer. Used to create a deep copy of the card for the Player's hand.
+ * @param card A pointer to the card. The player doesn't own it, the cards of the game are shared (see Deck::getCard()).
  */
-void Player::addCardToHand(Card* card) {
+void Player::addCardToHand(const CardInfo* card) {
     cout << "{ " << *name << " } [ " << strategy->getType() << " ] Added card { " << card->getGood() << " : \"" << card->getAction() << "\" } to hand.\n" << endl;
     hand->push_back(card);
+
+    if (card->getGoodId() != NO_GOOD)
+        (*goods)[card->getGoodId()] += card->getGoodCount();
 }
 
 /**
@@ -589,7 +630,21 @@ void Player::addCardToHand(Card* card) {
  * @param region A Vertex pointer to the target region.
  */
 void Player::addRegion(Vertex* region){
-    regions->insert(pair<string, Vertex*> (region->getKey(), region));
+    // The region IDs are only valid once the map topology is up to date.
+    syncOccupiedMask();
+    RegionId id = region->getId();
+    regions->insert(pair<RegionId, Vertex*> (id, region));
+    bool isOnMap = id < maskTopology->getNumRegions();
+    if (isOnMap)
+        occupiedMask->insert(id);
+
+    // Extend the reach in place rather than rebuilding it.
+    if (isOnMap && !*reachIsStale && maskTopology->hasNeighbourMasks()) {
+        landReach->insert(id);
+        landReach->unite(maskTopology->getLandMask(id));
+        overWaterReach->insert(id);
+        overWaterReach->unite(maskTopology->getOverWaterMask(id));
+    }
     cout << "{ " << *name << " } [ " << strategy->getType() << " ] " << "Added region < " << region->getName() << " > to player's regions." << endl;
 }
 
@@ -602,20 +657,20 @@ void Player::addRegion(Vertex* region){
  * @param region A Vertex pointer to the target region.
  */
 void Player::removeRegion(Vertex* region) {
-    if(regions->find(region->getKey()) != regions->end()) {
-        int numArmies = 0, numCities = 0;
-
+    if(occupiesRegion(region)) {
         //Get current number of armies and cities if they exist on the region.
-        if (region->getArmies()->find(playerEntry) != region->getArmies()->end())
-            numArmies = region->getArmies()->find(playerEntry)->second;
-        if (region->getCities()->find(playerEntry) != region->getCities()->end())
-            numCities = region->getCities()->find(playerEntry)->second;
+        int numArmies = region->getArmiesOf(getId());
+        int numCities = region->getCitiesOf(getId());
 
         //Only remove the region if the player has 0 armies and 0 cities on the region.
         if (numArmies == 0 && numCities == 0) {
-            region->getArmies()->erase(playerEntry);
-            region->getCities()->erase(playerEntry);
-            regions->erase(region->getKey());
+            // The region may still be reachable from another occupied region, so the reach
+            // is rebuilt from the occupied regions the next time it's needed.
+            regions->erase(region->getId());
+            if (region->getId() < maskTopology->getNumRegions())
+                occupiedMask->erase(region->getId());
+            *reachIsStale = true;
+
             cout << "{ " << *name << " } " << "Removed < " << region->getName() << " >." << endl;
         } else
             cout << "[ ERROR! ] Can't remove < " << region->getName() << " >. " << *name << " still owns "
@@ -625,6 +680,158 @@ void Player::removeRegion(Vertex* region) {
     }
 }
 
+/**
+ * Adds a region to the player's occupied regions or removes it, without checking the pieces on
+ * it. Used when pieces are put straight on the map, eg. by GameContext::restore().
+ *
+ * @param region A Vertex pointer to the region.
+ * @param isOccupied A boolean representing if the region should be one of the player's regions.
+ */
+void Player::setOccupied(Vertex* region, bool isOccupied) {
+    if (occupiesRegion(region) == isOccupied)
+        return;
+
+    RegionId id = region->getId();
+    if (isOccupied)
+        regions->insert(pair<RegionId, Vertex*>(id, region));
+    else
+        regions->erase(id);
+
+    // A region that isn't on the map has no bit, and is never part of the reach.
+    if (id < maskTopology->getNumRegions()) {
+        if (isOccupied)
+            occupiedMask->insert(id);
+        else
+            occupiedMask->erase(id);
+        *reachIsStale = true;
+    }
+}
+
+/**
+ * Takes every region off the player's occupied regions at once, without checking the pieces on
+ * them. Used when the whole map is cleared, eg. by a GameReplayer going to another game.
+ */
+void Player::clearRegions() {
+    syncOccupiedMask();
+    regions->clear();
+    occupiedMask->reset(maskTopology->getNumRegions());
+    *reachIsStale = true;
+}
+
+/**
+ * Saves the coins, armies, cities and cards of the player into a GameState.
+ *
+ * @param state Set to the counters of the player.
+ * @param cards Set to the IDs of the cards of the player, in the order they were bought.
+ */
+void Player::saveState(PlayerState* state, uint8_t* cards) {
+    state->coins = uint8_t(*coins);
+    state->armies = uint8_t(*armies);
+    state->cities = uint8_t(*cities);
+    state->numCards = uint8_t(hand->size());
+    state->goods = *goods;
+
+    for (size_t i = 0; i < hand->size(); i++)
+        cards[i] = uint8_t((*hand)[i]->getID());
+}
+
+/**
+ * Puts back the coins, armies, cities and cards saved by saveState().
+ *
+ * @param state The counters of the player.
+ * @param cards The IDs of the cards of the player.
+ */
+void Player::loadState(const PlayerState& state, const uint8_t* cards) {
+    *coins = state.coins;
+    *armies = state.armies;
+    *cities = state.cities;
+    *goods = state.goods;
+
+    hand->resize(state.numCards);
+    for (int i = 0; i < state.numCards; i++)
+        (*hand)[i] = Deck::getCard(cards[i]);
+}
+
+/**
+ * Saves the regions the player occupies into a GameState, as a bitset of the regions on the map.
+ *
+ * @param words Set to the bitset. Must hold RegionSet::wordsFor() the number of regions words.
+ */
+void Player::saveOccupied(uint64_t* words) {
+    syncOccupiedMask();
+    memcpy(words, occupiedMask->getWords(), occupiedMask->getNumWords() * sizeof(uint64_t));
+}
+
+/**
+ * Puts back the regions the player occupies from a bitset saved by saveOccupied(). Only the
+ * regions whose bit differs are added to or taken out of the list, and the reach is only marked
+ * stale when the bitset changed.
+ *
+ * @param words The bitset of the occupied regions.
+ */
+void Player::loadOccupied(const uint64_t* words) {
+    syncOccupiedMask();
+    const uint64_t* current = occupiedMask->getWords();
+    GameMap* map = getMap();
+
+    for (size_t i = 0; i < occupiedMask->getNumWords(); i++) {
+        for (uint64_t changed = current[i] ^ words[i]; changed != 0; changed &= changed - 1) {
+            RegionId id = RegionId(i * 64 + __builtin_ctzll(changed));
+            if ((words[i] >> (id & 63)) & 1)
+                regions->insert(pair<RegionId, Vertex*>(id, map->getVertex(id)));
+            else
+                regions->erase(id);
+        }
+    }
+
+    if (occupiedMask->assign(words))
+        *reachIsStale = true;
+}
+
+//PRIVATE
+/**
+ * Makes sure the occupied regions and their bitset were built against the current map topology.
+ * If the topology was rebuilt since, the region IDs and the number of regions may have changed,
+ * so both are keyed again. Topologies are told apart by generation, as a rebuilt one can be
+ * allocated at the address of the one it replaced.
+ */
+void Player::syncOccupiedMask() {
+    MapTopology* graph = getMap()->getTopology();
+    if (graph->getGeneration() == *maskGeneration)
+        return;
+
+    maskTopology = graph;
+    *maskGeneration = graph->getGeneration();
+    OccupiedRegions rekeyed;
+    occupiedMask->reset(graph->getNumRegions());
+    for (OccupiedRegions::iterator it = regions->begin(); it != regions->end(); ++it) {
+        RegionId id = it->second->getId();
+        rekeyed.insert(pair<RegionId, Vertex*>(id, it->second));
+        if (id < graph->getNumRegions())
+            occupiedMask->insert(id);
+    }
+    regions->swap(rekeyed);
+
+    *reachIsStale = true;
+}
+
+//PRIVATE
+/**
+ * Rebuilds the regions the player can reach over land and over water. Each one is the
+ * occupied regions plus the union of their neighbour bitsets.
+ */
+void Player::rebuildReach() {
+    *landReach = *occupiedMask;
+    *overWaterReach = *occupiedMask;
+
+    for (RegionId id : occupiedMask->getIds()) {
+        landReach->unite(maskTopology->getLandMask(id));
+        overWaterReach->unite(maskTopology->getOverWaterMask(id));
+    }
+
+    *reachIsStale = false;
+}
+
 /**
  * Prints a list of the Player's occupied regions.
  */
@@ -632,19 +839,16 @@ void Player::printRegions(){
 
     cout << "\n{ " << *name << " } Occupied Regions: [ " << *colour << " ]\n" << endl;
     cout << "---------------------------------------------------------------------------" << endl;
-    Vertices::iterator it;
+    Vertex* startVertex = getMap()->getStartVertex();
+    PlayerId playerId = getId();
+    OccupiedRegions::iterator it;
     for(it = regions->begin(); it != regions->end(); ++it) {
-        int numArmies = 0;
-        int numCities = 0;
-        if (it->second->getArmies()->find(playerEntry) != it->second->getArmies()->end())
-            numArmies = it->second->getArmies()->find(playerEntry)->second;
-        if (it->second->getCities()->find(playerEntry) != it->second->getCities()->end())
-            numCities = it->second->getCities()->find(playerEntry)->second;
-
-        if (it->second->getKey() == GameMap::instance()->getStartVertex()->getKey())
-            printf("\t%-3s : %-20s ARMIES: %-5d CITIES: %-5d [ START ]\n", it->second->getKey().c_str(), it->second->getName().c_str(), numArmies, numCities);
-        else
-            printf("\t%-3s : %-20s ARMIES: %-5d CITIES: %-5d\n", it->second->getKey().c_str(), it->second->getName().c_str(), numArmies, numCities);
+        int numArmies = it->second->getArmiesOf(playerId);
+        int numCities = it->second->getCitiesOf(playerId);
+
+        char regionbuff[256];
+        snprintf(regionbuff, sizeof(regionbuff), "\t%-3s : %-20s ARMIES: %-5d CITIES: %-5d", it->second->getKey().c_str(), it->second->getName().c_str(), numArmies, numCities);
+        cout << regionbuff << (it->second == startVertex ? " [ START ]\n" : "\n");
     }
 
     cout << "---------------------------------------------------------------------------\n" << endl;
@@ -663,19 +867,12 @@ void Player::printRegions(){
  */
 void Player::addArmiesToRegion(Vertex* region, const int& numArmies) {
     //Add region to the Player's list of occupied regions if it hasn't been added yet.
-    if(regions->find(region->getKey()) == regions->end()) {
+    if(!occupiesRegion(region)) {
         addRegion(region);
     }
 
-    if (region->getArmies()->find(playerEntry) == region->getArmies()->end()) {
-        //Region doesn't have any of Player's armies. Create a new record.
-        region->getArmies()->insert(pair<PlayerEntry*, int> (playerEntry, numArmies));
-    } else {
-        //Region already has some of Player's armies. Add to current number of armies.
-        int currentArmies = region->getArmies()->find(playerEntry)->second;
-        region->getArmies()->erase(playerEntry);
-        region->getArmies()->insert(pair<PlayerEntry*, int> (playerEntry, currentArmies + numArmies));
-    }
+    //Add to current number of armies. The region updates its owner.
+    region->setArmies(getId(), region->getArmiesOf(getId()) + numArmies);
 }
 
 /**
@@ -685,16 +882,13 @@ void Player::addArmiesToRegion(Vertex* region, const int& numArmies) {
  * @param numArmies The number of armies to remove from region.
  */
 void Player::removeArmiesFromRegion(Vertex* region, const int& numArmies) {
-    int currentArmies = region->getArmies()->find(playerEntry)->second;
+    int currentArmies = region->getArmiesOf(getId());
 
-    // erase current record
-    region->getArmies()->erase(playerEntry);
+    // The record is erased when no armies are left on region. The region updates its owner.
+    region->setArmies(getId(), currentArmies - numArmies);
 
-    // only update army count if there are still armies left on region
-    if (currentArmies - numArmies > 0)
-        region->getArmies()->insert(pair<PlayerEntry*, int> (playerEntry, currentArmies - numArmies));
     // remove region if resulting num armies is 0 and no cities exist
-    else if (numArmies == currentArmies && region->getCities()->find(playerEntry) == region->getCities()->end())
+    if (numArmies == currentArmies && region->getCitiesOf(getId()) == 0)
         removeRegion(region);
 }
 
@@ -709,9 +903,7 @@ void Player::removeArmiesFromRegion(Vertex* region, const int& numArmies) {
  * @return a boolean that shows the action was successful.
  */
 bool Player::executeAddArmies(const int& newArmies, Vertex* region){
-    string start = GameMap::instance()->getStartVertexName();
-
-    if (region->getKey() == start || region->getCities()->find(playerEntry) != region->getCities()->end()){
+    if (region == getMap()->getStartVertex() || region->getCitiesOf(getId()) > 0){
         if (newArmies > *armies) {
             cout << "{ " << *name << " } [ " << strategy->getType() << " ] doesn't have enough armies to place " << newArmies << " new armies on < " << region->getName() << " >." << endl;
             cout << "{ " << *name << " } [ " << strategy->getType() << " ] placing " << *armies << " instead." << endl;
@@ -723,6 +915,9 @@ bool Player::executeAddArmies(const int& newArmies, Vertex* region){
         }
 
         cout << "{ " << *name << " } [ " << strategy->getType() << " ] Added " << newArmies << " new armies to < "<< region->getName() << " >." << endl;
+
+        if (getRecorder())
+            getRecorder()->recordAddArmies(this, newArmies, region);
         return true;
     }
     cout << "[ ERROR! ] " << *name << " Chose an invalid region. It must be either START or contain one of the player's cities->" << endl;
@@ -746,8 +941,8 @@ bool Player::executeMoveArmies(const int& numArmies, Vertex* start, Vertex* end,
     //is region an adjacent region to an occupied region?
     if (isAdjacent(end, moveOverWater)) {
         //does start vertex even have armies on it?
-        if (start->getArmies()->find(playerEntry) != start->getArmies()->end()) {
-            int currentArmies = start->getArmies()->find(playerEntry)->second;
+        int currentArmies = start->getArmiesOf(getId());
+        if (currentArmies > 0) {
             if (numArmies > currentArmies) {
                 cout << "[ ERROR! ] " << *name << " doesn't have enough armies on < " << start->getName()
                      << " > to move " << numArmies << "." << endl;
@@ -759,6 +954,9 @@ bool Player::executeMoveArmies(const int& numArmies, Vertex* start, Vertex* end,
 
             cout << "{ " << *name << " } [ " << strategy->getType() << " ] Moved " << numArmies
                  << " armies from < " << start->getName() << " > to < " << end->getName() << " >.\n" << endl;
+
+            if (getRecorder())
+                getRecorder()->recordMoveArmies(this, numArmies, start, end, moveOverWater);
             return true;
         }
 
@@ -779,24 +977,18 @@ bool Player::executeMoveArmies(const int& numArmies, Vertex* start, Vertex* end,
  * @return a boolean that shows the action was successful.
  */
 bool Player::executeBuildCity(Vertex* region){
-    unordered_map<PlayerEntry*, int>* armies = region->getArmies();
-
     //does region belong to the player and does it contain at least one army?
-    if (armies->find(playerEntry) != armies->end()) {
-        if (armies->find(playerEntry)->second > 0) {
-
-            //If region contains a player owned city, increase the count
-            int currentCities = 1;
-            if (region->getCities()->find(playerEntry) != region->getCities()->end()) {
-                currentCities += region->getCities()->find(playerEntry)->second;
-                region->getCities()->erase(playerEntry);
-                region->getCities()->insert(pair<PlayerEntry*,int>(playerEntry, currentCities));
-            } else //Else insert new record
-                region->getCities()->insert(pair<PlayerEntry*, int> (playerEntry, currentCities));
-
-            cout << "{ " << *name << " } [ " << strategy->getType() << " ] Added an city to < " << region->getName() << " >. (New city count = " << currentCities << ")." << endl;
-            return true;
-        }
+    if (region->getArmiesOf(getId()) > 0) {
+
+        //If region contains a player owned city, increase the count. The region updates its owner.
+        int currentCities = region->getCitiesOf(getId()) + 1;
+        region->setCities(getId(), currentCities);
+
+        cout << "{ " << *name << " } [ " << strategy->getType() << " ] Added an city to < " << region->getName() << " >. (New city count = " << currentCities << ")." << endl;
+
+        if (getRecorder())
+            getRecorder()->recordBuildCity(this, region);
+        return true;
     }
 
     cout << "[ ERROR! ] " << *name << " can't place city on < " << region->getName() << " > because the player has no armies on it." << endl;
@@ -815,34 +1007,32 @@ bool Player::executeBuildCity(Vertex* region){
  */
 bool Player::executeDestroyArmy(Vertex* region, Player* opponent){
 
-    if (opponent->getName() == *name) {
+    if (opponent == this) {
         cout << "\n[ ERROR! ] Can't destroy own army." << endl;
         return false;
     }
 
-    PlayerEntry* opponentPlayerEntry = opponent->getPlayerEntry();
+    PlayerId opponentId = opponent->getId();
     //Does opponent region contain an army to destroy?
-    if (region->getArmies()->find(opponentPlayerEntry) != region->getArmies()->end()
-        && region->getArmies()->find(opponentPlayerEntry)->second > 0) {
+    if (region->getArmiesOf(opponentId) > 0) {
 
-        int currentArmies = region->getArmies()->find(opponentPlayerEntry)->second;
-        currentArmies--;
+        int currentArmies = region->getArmiesOf(opponentId) - 1;
 
         //Add destroyed army back in opponents available armies
         opponent->increaseAvailableArmies(1);
 
-        //Remove old record of opponent's armies on region
-        region->getArmies()->erase(opponentPlayerEntry);
+        //Update the record with decremented army count. The region updates its owner.
+        region->setArmies(opponentId, currentArmies);
 
-        if (currentArmies != 0)
-            //Insert new record with decremented army count
-            region->getArmies()->insert(pair<PlayerEntry*, int> (opponentPlayerEntry, currentArmies));
-        else {
+        if (currentArmies == 0) {
             //Remove region from opponent's list of occupied regions because the last army was destroyed.
             opponent->removeRegion(region);
         }
 
         cout << "{ " << *name << " } [ " << strategy->getType() << " ] Destroyed one of " << opponent->getName() << "'s armies on < " << region->getName() << " >." << endl;
+
+        if (getRecorder())
+            getRecorder()->recordDestroyArmy(this, region, opponent);
         return true;
     }
 
@@ -863,54 +1053,63 @@ void Player::fillPurseFromSupply(const int& numCoins) {
 //PRIVATE
 /**
  * Finds any wild cards the user may have in their hand and asks them to increment
- * another good that they own.
- */
-void Player::findAndDistributeWildCards(unordered_map<string, int>* goodsCount) {
-    if (goodsCount->find(WILD) != goodsCount->end()) {
-        int numWildCards = goodsCount->find(WILD)->second;
-        goodsCount->erase(WILD);
-
-        cout << "{ " << *name << " } has " << numWildCards << " WILD cards!" << endl;
-
-        if (InitGameEngine::instance()->isTournament()) {
-            unordered_map<string, int>::iterator it = goodsCount->begin();
-            for (int i = 0; i < numWildCards; i++) {
-                if (it->first == WILD) it++;
-
-                cout << "{ " << *name << " } added a " << it->first << " card." << endl;
-                int count = it->second;
-                string good = it->first;
-                goodsCount->erase(it->first);
-                goodsCount->insert(pair<string, int>(good, count+1));
-                it++;
-            }
-        } else {
-            for (int i = 0; i < numWildCards; i++) {
-                // Only ask to move Wild cards around if there the player owns other goods.
-                while(goodsCount->size() > 1) {
-                    string resource;
+ * another good that they own. Computer players in a tournament add them where they score
+ * the most (see assignWilds()).
+ */
+void Player::findAndDistributeWildCards(GoodsCount& goodsCount) {
+    int numWildCards = goodsCount[GOOD_WILD];
+    if (numWildCards == 0)
+        return;
 
-                    cout << "\n{ " << *name << " } Choose which resource to add the WILD card to ( " << numWildCards - i << " WILD cards left ):" << endl;
+    cout << "{ " << *name << " } has " << numWildCards << " WILD cards!" << endl;
 
-                    for (unordered_map<string, int>::iterator it  = goodsCount->begin(); it != goodsCount->end(); ++it)
-                        cout << "{ " << *name << " } You have " << it->second << " " << it->first << " cards." << endl;
+    if (isInTournament()) {
+        // Add the wilds where they score the most.
+        GoodsCount assigned = assignWilds(goodsCount);
 
-                    cout << "{ " << *name << " } > ";
+        for (int good = 0; good < GOOD_WILD; good++) {
+            for (int i = goodsCount[good]; i < assigned[good]; i++)
+                cout << "{ " << *name << " } added a " << getGoodName(GoodId(good)) << " card." << endl;
+        }
 
-                    getline(cin, resource);
-                    transform(resource.begin(), resource.end(), resource.begin(), ::toupper);
+        goodsCount = assigned;
+        return;
+    }
 
-                    if (goodsCount->find(resource) != goodsCount->end()) {
-                        cout << "{ " << *name << " } Adding 1 count of " << resource << "." << endl;
-                        int count = goodsCount->find(resource)->second;
-                        goodsCount->erase(resource);
-                        goodsCount->insert(pair<string,int>(resource,count+1));
-                        break;
-                    }
+    goodsCount[GOOD_WILD] = 0;
 
-                    cout << "\n[ ERROR! ] Invalid resource name. Please choose a resource that you own.\n" << endl;
-                }
+    int numOwnedGoods = 0;
+    for (int good = 0; good < GOOD_WILD; good++) {
+        if (goodsCount[good] > 0)
+            numOwnedGoods++;
+    }
+
+    for (int i = 0; i < numWildCards; i++) {
+        // Only ask to move Wild cards around if there the player owns other goods.
+        while(numOwnedGoods > 1) {
+            string resource;
+
+            cout << "\n{ " << *name << " } Choose which resource to add the WILD card to ( " << numWildCards - i << " WILD cards left ):" << endl;
+
+            for (int good = 0; good < GOOD_WILD; good++) {
+                if (goodsCount[good] > 0)
+                    cout << "{ " << *name << " } You have " << int(goodsCount[good]) << " " << getGoodName(GoodId(good)) << " cards." << endl;
             }
+
+            cout << "{ " << *name << " } > ";
+
+            getline(cin, resource);
+            transform(resource.begin(), resource.end(), resource.begin(), ::toupper);
+
+            int count;
+            GoodId good = parseGood(resource, count);
+            if (good < GOOD_WILD && goodsCount[good] > 0) {
+                cout << "{ " << *name << " } Adding 1 count of " << resource << "." << endl;
+                goodsCount[good]++;
+                break;
+            }
+
+            cout << "\n[ ERROR! ] Invalid resource name. Please choose a resource that you own.\n" << endl;
         }
     }
 }
@@ -923,6 +1122,44 @@ void Player::setStrategy(Strategy* newStrategy) {
     strategy = newStrategy;
 }
 
+/**
+ * Gets the ID of the player on its map. The player joins the map the first time this is called,
+ * and joins again if the map changed or was reset since.
+ *
+ * @return The PlayerId of the player. Returns NO_PLAYER if the map has no room left for players.
+ */
+PlayerId Player::getId() {
+    GameMap* map = getMap();
+    if (map->getPlayer(*id) != this)
+        *id = map->addPlayer(this);
+    return *id;
+}
+
+/**
+ * Gets the map the player is playing on. Players that aren't part of a game yet use the
+ * GameMap instance, like the test drivers do.
+ */
+GameMap* Player::getMap() {
+    return context ? context->getMap() : GameMap::instance();
+}
+
+/**
+ * Detects if the player is playing in a tournament game.
+ */
+bool Player::isInTournament() {
+    return context && context->isTournament();
+}
+
+//PRIVATE
+/**
+ * Gets the recorder of the player's game.
+ *
+ * @return The recorder, or nullptr if the game isn't recorded.
+ */
+GameRecorder* Player::getRecorder() {
+    return context ? context->getRecorder() : nullptr;
+}
+
 //PRIVATE
 /**
  * Increases number of free armies available to a Player.
@@ -7,39 +7,59 @@
 #include <unordered_map>
 #include <stdio.h>
 
+#include "CardAction.h"
 #include "Cards.h"
+#include "Goods.h"
 #include "Map.h"
 #include "Bidder.h"
 #include "util/ScoreTest.h"
 #include "PlayerStrategies.h"
+#include "RegionSet.h"
+#include "ArmyMatrix.h"
 
-class Card;
+struct CardInfo;
 class Vertex;
 class Bidder;
 class Player;
 class GameMap;
+class GameContext;
+class GameRecorder;
 class Strategy;
+struct PlayerState;
 
 typedef map<string, Vertex*> Vertices;
+typedef map<RegionId, Vertex*> OccupiedRegions;
 typedef unordered_map<string, Player*> Players;
-typedef pair<string, string> PlayerEntry;
 
 const string ANON = "Anon";
 
+// The armies and cities each player starts with, to place on the map during the game.
+const int START_ARMIES = 14;
+const int START_CITIES = 3;
+
 class Player {
     string* name;
-    Vertices* regions;
+    OccupiedRegions* regions;
     int* armies;
     int* cities;
     int* coins;
-    vector<Card*>* hand;
+    vector<const CardInfo*>* hand;
+    GoodsCount* goods;
     Bidder* bidder;
     string* colour;
-    PlayerEntry* playerEntry;
+    PlayerId* id;
     int* controlledRegions;
     Strategy* strategy;
+    RegionSet* occupiedMask;
+    RegionSet* landReach;
+    RegionSet* overWaterReach;
+    bool* reachIsStale;
+    MapTopology* maskTopology;
+    uint64_t* maskGeneration;
+    GameContext* context;
 
     friend class ScoreTest;
+    friend class GameReplayer;
 
 public:
     Player();
@@ -51,13 +71,14 @@ public:
     ~Player();
 
     bool PayCoins(const int& amount);
-    void PlaceNewArmies(const string action, Players* players);
-    void MoveArmies(const string action, Players* players);
-    void MoveOverLand(const string action, Players* players);
-    void MoveOverWater(const string action, Players* players);
+    void PlaceNewArmies(const Action& action, Players* players);
+    void MoveArmies(const Action& action, Players* players);
+    void MoveOverLand(const Action& action, Players* players);
+    void MoveOverWater(const Action& action, Players* players);
     void BuildCity();
     void DestroyArmy(Players* players);
-    void AndOrAction(const string action, Players* players);
+    void AndOrAction(const CardAction& action, Players* players);
+    void performCardAction(const CardAction& action, Players* players);
     void Ignore();
     int ComputeScore();
 
@@ -66,16 +87,17 @@ public:
     int computeGoodsScore();
     vector<string>* getRegions();
     vector<string>* getOwnedContinents();
-    unordered_map<string, int>* getGoodsCount();
-    int getVPFromGoods(unordered_map<string, int>* goodsCount);
+    const GoodsCount& getGoodsCount() { return *goods; }
+    int getVPFromGoods(const GoodsCount& goodsCount);
 
     void fillPurseFromSupply(const int& coins);
-    void addCardToHand(Card* card);
+    void addCardToHand(const CardInfo* card);
     void addRegion(Vertex* region);
     void removeRegion(Vertex* region);
     void printRegions();
     bool isAdjacent(Vertex* region, const bool& overWaterAllowed);
-    bool isAdjacent(const string& regionName, const bool& overWaterAllowed);
+    bool isAdjacent(const string& regionKey, const bool& overWaterAllowed);
+    bool occupiesRegion(Vertex* region);
     int getArmiesOnRegion(Vertex* region);
     int getCitiesOnRegion(Vertex* region);
 
@@ -86,27 +108,40 @@ public:
 
     void addArmiesToRegion(Vertex* region, const int& numArmies);
     void removeArmiesFromRegion(Vertex* region, const int& numArmies);
+    void setOccupied(Vertex* region, bool isOccupied);
+    void clearRegions();
+
+    void saveState(PlayerState* state, uint8_t* cards);
+    void loadState(const PlayerState& state, const uint8_t* cards);
+    void saveOccupied(uint64_t* words);
+    void loadOccupied(const uint64_t* words);
 
     //GETTERS
-    string getName() { return *name; }
-    Vertices* getOccupiedRegions() { return regions; }
+    const string& getName() { return *name; }
+    OccupiedRegions* getOccupiedRegions() { return regions; }
     int getArmies() { return *armies; }
     int getCities() { return *cities; }
     int getCoins() { return *coins; }
-    vector<Card*>* getHand() { return hand;}
+    vector<const CardInfo*>* getHand() { return hand;}
     Bidder* getBidder() { return bidder; }
-    string getColour() { return *colour; }
-    PlayerEntry* getPlayerEntry() { return playerEntry; }
+    const string& getColour() { return *colour; }
+    PlayerId getId();
     int getControlledRegions() { return *controlledRegions; }
     Strategy* getStrategy() { return strategy; }
+    GameContext* getContext() { return context; }
+    GameMap* getMap();
+    bool isInTournament();
 
     void setStrategy(Strategy* newStrategy);
+    void setContext(GameContext* newContext) { context = newContext; }
 
 private:
     void increaseAvailableArmies(const int& numArmies);
     void decreaseAvailableArmies(const int& numArmies);
-    void performCardAction(string& action, Players* players);
-    void findAndDistributeWildCards(unordered_map<string, int>* goodsCount);
+    void findAndDistributeWildCards(GoodsCount& goodsCount);
+    void syncOccupiedMask();
+    void rebuildReach();
+    GameRecorder* getRecorder();
 };
 
 #endif
\ No newline at end of file
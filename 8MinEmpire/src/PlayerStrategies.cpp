@@ -6,8 +6,6 @@
 #include <cstdlib>
 #include <map>
 
-typedef map<string, Vertex*> Vertices;
-
 /**
  * Default Constructor
  */
@@ -27,6 +25,44 @@ Strategy::~Strategy() {
     delete type;
 }
 
+typedef void (*ActionHandler)(Strategy* strategy, Player* player, const Action& action, Players* players);
+
+static void moveArmies(Strategy* strategy, Player* player, const Action& action, Players* players) {
+    strategy->MoveArmies(player, action, players);
+}
+
+static void addArmies(Strategy* strategy, Player* player, const Action& action, Players* players) {
+    strategy->PlaceNewArmies(player, action, players);
+}
+
+static void destroyArmy(Strategy* strategy, Player* player, const Action& action, Players* players) {
+    strategy->DestroyArmy(player, players);
+}
+
+static void buildCity(Strategy* strategy, Player* player, const Action& action, Players* players) {
+    strategy->BuildCity(player);
+}
+
+static void invalidAction(Strategy* strategy, Player* player, const Action& action, Players* players) {
+    cout << "[ ERROR! ] Invalid action." << endl;
+}
+
+// Indexed by ActionType.
+static const ActionHandler ACTION_HANDLERS[NUM_ACTION_TYPES] = {
+    moveArmies, addArmies, destroyArmy, moveArmies, buildCity, invalidAction
+};
+
+/**
+ * Executes a single action with this strategy, dispatching on the type of the action.
+ *
+ * @param player A pointer to the player using this strategy.
+ * @param action The action being executed.
+ * @param players A pointer to a list of all the players in the game.
+ */
+void Strategy::performAction(Player* player, const Action& action, Players* players) {
+    ACTION_HANDLERS[action.type](this, player, action, players);
+}
+
 /**
  * Constructor
  */
@@ -47,19 +83,19 @@ GreedyStrategy::~GreedyStrategy() {
  * @param action The action being executed.
  * @param players A pointer to a list of all the players in the game.
  */
-void GreedyStrategy::PlaceNewArmies(Player* player, const string action, Players* players) {
-    int maxArmies = stoi(action.substr(4, 5));
-    Vertices* playerRegions = player->getOccupiedRegions();
-    Vertex* addVertex = GameMap::instance()->getStartVertex();
-    PlayerEntry* entry = player->getPlayerEntry();
+void GreedyStrategy::PlaceNewArmies(Player* player, const Action& action, Players* players) {
+    int maxArmies = action.amount;
+    OccupiedRegions* playerRegions = player->getOccupiedRegions();
+    Vertex* addVertex = player->getMap()->getStartVertex();
+    PlayerId playerId = player->getId();
 
-    cout << "\n\n[[ ACTION ]] " << action << ".\n\n" << endl;
+    cout << "\n\n[[ ACTION ]] " << describeAction(action) << ".\n\n" << endl;
     cout << "{ " << player->getName() << " } [ GREEDY ] has the choice of adding " << maxArmies << " armies on the board." << endl;
 
-    for(Vertices::iterator it = playerRegions->begin(); it != playerRegions->end(); ++it) {
+    for(OccupiedRegions::iterator it = playerRegions->begin(); it != playerRegions->end(); ++it) {
         // Find vertex with a city
         Vertex* vertex = it->second;
-        if (vertex->getCities()->find(entry) != vertex->getCities()->end()) {
+        if (vertex->getCitiesOf(playerId) > 0) {
             addVertex = vertex;
             break;
         }
@@ -81,44 +117,49 @@ void GreedyStrategy::PlaceNewArmies(Player* player, const string action, Players
  * @param action The action being executed.
  * @param players A pointer to a list of all the players in the game.
  */
-void GreedyStrategy::MoveArmies(Player* player, const string action, Players* players) {
-    int maxArmies = stoi(action.substr(5, 6));
-    bool overWaterAllowed = action.find("water") != size_t(-1);
+void GreedyStrategy::MoveArmies(Player* player, const Action& action, Players* players) {
+    int maxArmies = action.amount;
+    bool overWaterAllowed = action.isOverWater();
 
     string actionSuffix = overWaterAllowed ? " armies over water.\n" : " armies over land.\n";
 
     cout << "\n\n[[ ACTION ]] Move " << maxArmies << actionSuffix << "\n\n" << endl;
     cout << "{ " << player->getName() << " } [ GREEDY ] Can move " << maxArmies << " armies around the board." << endl;
 
-    PlayerEntry* entry = player->getPlayerEntry();
-    Vertices* vertices = player->getOccupiedRegions();
+    PlayerId playerId = player->getId();
+    OccupiedRegions* vertices = player->getOccupiedRegions();
+    GameMap* map = player->getMap();
+    MapTopology* graph = map->getTopology();
 
-    string previousStartVertex = "";
+    Vertex* previousStartVertex = nullptr;
 
-    Vertices::reverse_iterator r = vertices->rbegin();
+    OccupiedRegions::reverse_iterator r = vertices->rbegin();
 
     while(maxArmies > 0) {
         Vertex* currentVertex = r->second;
 
         // Skip vertex if there are no armies on it.
-        if (currentVertex->getArmies()->find(entry) == currentVertex->getArmies()->end()) {
+        if (currentVertex->getArmiesOf(playerId) == 0) {
             r++;
             continue;
         }
 
         bool moveTaken = false;
 
-        vector<Edge>* edges = currentVertex->getEdges();
-        vector<Edge>::iterator e = edges->begin();
+        // The land neighbours come first, then the water neighbours.
+        RegionRange edges = graph->getNeighbours(currentVertex->getId());
+        size_t numLandEdges = graph->getLandNeighbours(currentVertex->getId()).size();
+        size_t e = 0;
 
-        while(e != edges->end() && maxArmies > 0) {
+        while(e < edges.size() && maxArmies > 0) {
 
-            bool isWaterEdge = e->second;
+            bool isWaterEdge = e >= numLandEdges;
+            Vertex* endVertex = map->getVertex(edges[e]);
             if(!isWaterEdge || (overWaterAllowed && isWaterEdge)) {
-                if (edges->size() > 2 && previousStartVertex != e->first->getName()) {
-                    if (player->executeMoveArmies(1, currentVertex, e->first, overWaterAllowed)) {
+                if (edges.size() > 2 && previousStartVertex != endVertex) {
+                    if (player->executeMoveArmies(1, currentVertex, endVertex, overWaterAllowed)) {
                         maxArmies--;
-                        previousStartVertex = currentVertex->getName();
+                        previousStartVertex = currentVertex;
                         moveTaken = true;
 
                         //If the curernt vertex has no armies or cities on it after the move, it gets removed from player's
@@ -130,7 +171,7 @@ void GreedyStrategy::MoveArmies(Player* player, const string action, Players* pl
                 } else {
                     if (player->executeMoveArmies(1, currentVertex, currentVertex, overWaterAllowed)) {
                         maxArmies--;
-                        previousStartVertex = currentVertex->getName();
+                        previousStartVertex = currentVertex;
                         moveTaken = true;
 
                         //If the curernt vertex has no armies or cities on it after the move, it gets removed from player's
@@ -163,14 +204,13 @@ void GreedyStrategy::MoveArmies(Player* player, const string action, Players* pl
 void GreedyStrategy::BuildCity(Player* player) {
     cout << "\n\n[[ ACTION ]] Build a city.\n\n" << endl;
 
-    Vertices* playerRegions = player->getOccupiedRegions();
+    OccupiedRegions* playerRegions = player->getOccupiedRegions();
     Vertex* buildVertex = playerRegions->begin()->second;
 
-    for(Vertices::iterator it = playerRegions->begin(); it != playerRegions->end(); ++it) {
+    for(OccupiedRegions::iterator it = playerRegions->begin(); it != playerRegions->end(); ++it) {
 
         Vertex* vertex = it->second;
-        PlayerEntry* entry = player->getPlayerEntry();
-        if (vertex->getCities()->find(entry) == vertex->getCities()->end() && vertex != GameMap::instance()->getStartVertex()) {
+        if (vertex->getCitiesOf(player->getId()) == 0 && vertex != player->getMap()->getStartVertex()) {
             buildVertex = vertex;
             break;
         }
@@ -192,25 +232,22 @@ void GreedyStrategy::BuildCity(Player* player) {
 void GreedyStrategy::DestroyArmy(Player* player, Players* players) {
     cout << "\n\n[[ ACTION ]] Destroy an army.\n\n" << endl;
 
-    Vertices* vertices = GameMap::instance()->getVertices();
-
-    for(Vertices::iterator it = vertices->begin(); it != vertices->end(); ++it) {
-        Vertex* currentVertex = it->second;
+    // Region IDs are in key order.
+    GameMap* map = player->getMap();
 
-        unordered_map<PlayerEntry*, int>* armies = currentVertex->getArmies();
-        unordered_map<PlayerEntry*, int>::iterator a;
+    for(RegionId id = 0; id < map->getNumRegions(); id++) {
+        Vertex* currentVertex = map->getVertex(id);
 
-        string opponentName = "";
+        Player* opponent = nullptr;
 
-        for (a = armies->begin(); a != armies->end(); ++a) {
-            if (a->first != player->getPlayerEntry()) {
-                opponentName = a->first->first;
+        for (PlayerId opponentId = 0; opponentId < MAX_PLAYERS; opponentId++) {
+            if (opponentId != player->getId() && currentVertex->getArmiesOf(opponentId) > 0) {
+                opponent = player->getMap()->getPlayer(opponentId);
                 break;
             }
         }
 
-        if (opponentName != "") {
-            Player* opponent = players->find(opponentName)->second;
+        if (opponent) {
             player->executeDestroyArmy(currentVertex, opponent);
             break;
         }
@@ -225,40 +262,19 @@ void GreedyStrategy::DestroyArmy(Player* player, Players* players) {
  * @param action The action being executed.
  * @param players A pointer to a list of all the players in the game.
  */
-void GreedyStrategy::AndOrAction(Player* player, const string action, Players* players) {
-    vector<string> actionArr;
-
-    if (action.find("OR") != size_t(-1)) {
-        int orPos = action.find("OR");
-        string firstChoice = action.substr(0, orPos - 1);
-        string secondChoice = action.substr(orPos + 3);
-        string chosenAction;
-
-        if (firstChoice.find("Build") != size_t(-1) || firstChoice.find("Destroy") != size_t(-1)) {
-            chosenAction = firstChoice;
-            cout << "\n{ " << player->getName() << " } [ GREEDY ] Chose Option 1 \"" << chosenAction << "\"" << endl;
+void GreedyStrategy::AndOrAction(Player* player, const CardAction& action, Players* players) {
+    if (action.combinator == OR_ACTION) {
+        if (action.first.type == BUILD_CITY || action.first.type == DESTROY_ARMY) {
+            cout << "\n{ " << player->getName() << " } [ GREEDY ] Chose Option 1 \"" << describeAction(action.first) << "\"" << endl;
+            performAction(player, action.first, players);
         } else {
-            chosenAction = secondChoice;
-            cout << "\n{ " << player->getName() << " } [ GREEDY ] Chose Option 2 \"" << chosenAction << "\"" << endl;
+            cout << "\n{ " << player->getName() << " } [ GREEDY ] Chose Option 2 \"" << describeAction(action.second) << "\"" << endl;
+            performAction(player, action.second, players);
         }
-
-        actionArr.push_back(chosenAction);
     }
     else {
-        size_t andPos = action.find("AND");
-        actionArr.push_back(action.substr(0, andPos));
-        actionArr.push_back(action.substr(andPos+4));
-    }
-
-    for(vector<string>::iterator it = actionArr.begin(); it != actionArr.end(); ++it) {
-        if ((*it).find("Move") != size_t(-1))
-            MoveArmies(player, *it, players);
-        else if ((*it).find("Add") != size_t(-1))
-            PlaceNewArmies(player, *it, players);
-        else if ((*it).find("Destroy") != size_t(-1))
-            DestroyArmy(player, players);
-        else if ((*it).find("Build") != size_t(-1))
-            BuildCity(player);
+        performAction(player, action.first, players);
+        performAction(player, action.second, players);
     }
 }
 
@@ -271,17 +287,16 @@ void GreedyStrategy::AndOrAction(Player* player, const string action, Players* p
  * @return The position of the chosen card.
  */
 int GreedyStrategy::chooseCardPosition(Player* player, Hand* hand) {
-    vector<Card*>::iterator it = hand->getHand()->begin();
     int count = 0;
 
-    while(it != hand->getHand()->end() && count <= player->getCoins()) {
-        if ((*it)->getAction().find("Build") != size_t(-1) || (*it)->getAction().find("Destroy") != size_t(-1)) {
+    while(count < hand->size() && count <= player->getCoins()) {
+        const CardAction& action = hand->getCard(count)->getCardAction();
+        if (action.contains(BUILD_CITY) || action.contains(DESTROY_ARMY)) {
             cout << "{ " << player->getName() << " } [ GREEDY ] Chose position " << count + 1 << ". { Cards in hand "
              << player->getHand()->size()+1 << " }." << endl;
             return count;
         }
         count++;
-        it++;
     }
 
     cout << "{ " << player->getName() << " } [ GREEDY ] Chose position " << 1
@@ -308,28 +323,33 @@ ModerateStrategy::~ModerateStrategy() {
  * @param action The action being executed.
  * @param players A pointer to a list of all the players in the game.
  */
-void ModerateStrategy::MoveArmies(Player* player, const string action, Players* players) {
-    int maxArmies = stoi(action.substr(5, 6));
-    bool overWaterAllowed = action.find("water") != size_t(-1);
+void ModerateStrategy::MoveArmies(Player* player, const Action& action, Players* players) {
+    int maxArmies = action.amount;
+    bool overWaterAllowed = action.isOverWater();
 
     string actionSuffix = overWaterAllowed ? " armies over water.\n" : " armies over land.\n";
 
     cout << "\n\n[[ ACTION ]] Move " << maxArmies << actionSuffix << "\n\n" << endl;
     cout << "{ " << player->getName() << " } Can move " << maxArmies << " armies around the board." << endl;
 
-    PlayerEntry* entry = player->getPlayerEntry();
-    Vertices* vertices = player->getOccupiedRegions();
+    PlayerId playerId = player->getId();
+    OccupiedRegions* vertices = player->getOccupiedRegions();
+    GameMap* map = player->getMap();
+    MapTopology* graph = map->getTopology();
 
-    string previousStartVertex = "";
+    Vertex* previousStartVertex = nullptr;
 
     // For each of the player's occupied regions, find first adjacent region that moving armies would change ownership.
-    Vertices::iterator it = vertices->begin();
+    OccupiedRegions::iterator it = vertices->begin();
     while(it != vertices->end() && maxArmies > 0) {
         Vertex* currentVertex = it->second;
-        vector<Edge>* edges = currentVertex->getEdges();
+
+        // The land neighbours come first, then the water neighbours.
+        RegionRange edges = graph->getNeighbours(currentVertex->getId());
+        size_t numLandEdges = graph->getLandNeighbours(currentVertex->getId()).size();
 
         // Skip this vertex if there are no armies on it
-        if (currentVertex->getArmies()->find(entry) == currentVertex->getArmies()->end()) {
+        if (currentVertex->getArmiesOf(playerId) == 0) {
             it++;
             continue;
         }
@@ -337,19 +357,19 @@ void ModerateStrategy::MoveArmies(Player* player, const string action, Players*
         bool moveTaken = false;
 
         // Cycle through all adjacent vertices
-        vector<Edge>::iterator e = edges->begin();
-        while(e != edges->end() && maxArmies > 0) {
+        size_t e = 0;
+        while(e < edges.size() && maxArmies > 0) {
 
-            bool isWaterEdge = e->second;
-            if ((!isWaterEdge || (overWaterAllowed && isWaterEdge)) && previousStartVertex != e->first->getName()) {
-                Vertex* endVertex = e->first;
+            bool isWaterEdge = e >= numLandEdges;
+            Vertex* endVertex = map->getVertex(edges[e]);
+            if ((!isWaterEdge || (overWaterAllowed && isWaterEdge)) && previousStartVertex != endVertex) {
 
-                Vertices::iterator next = it;
+                OccupiedRegions::iterator next = it;
                 next++;
 
                 // If change of ownership is possible, then execute move armies and continue to next owned region.
                 if(changeOwnership(currentVertex, endVertex, player, maxArmies, players, overWaterAllowed)) {
-                    previousStartVertex = currentVertex->getName();
+                    previousStartVertex = currentVertex;
                     moveTaken = true;
 
                     //If the current vertex has no armies or cities on it after the move, it gets removed from player's
@@ -382,35 +402,27 @@ void ModerateStrategy::MoveArmies(Player* player, const string action, Players*
  * @return A boolean indicating the operation was successful.
  */
 bool ModerateStrategy::changeOwnership(Vertex* startVertex, Vertex* endVertex, Player* currentPlayer, int& maxArmies, Players* players, bool overWaterAllowed){
-    string ownerName = endVertex->getRegionOwner();
+    PlayerId playerId = currentPlayer->getId();
+    PlayerId owner = endVertex->getOwner();
 
-    int ownerEndArmies = 0;
-    int playerEndArmies = 0;
-    int playerStartArmies = startVertex->getArmies()->find(currentPlayer->getPlayerEntry())->second;
+    int playerStartArmies = startVertex->getArmiesOf(playerId);
     int maxMovableArmies = playerStartArmies < maxArmies ? playerStartArmies : maxArmies;
 
     // Get owner's armies on end vertex.
-    if (ownerName != "") {
-        Player* owner = players->find(ownerName)->second;
-        ownerEndArmies = endVertex->getArmies()->find(owner->getPlayerEntry())->second;
-    }
+    int ownerEndArmies = endVertex->getArmiesOf(owner);
 
     // Get current player's armies on end vertex.
-    if (endVertex->getArmies()->find(currentPlayer->getPlayerEntry()) != endVertex->getArmies()->end()) {
-        playerEndArmies = endVertex->getArmies()->find(currentPlayer->getPlayerEntry())->second;
-    }
+    int playerEndArmies = endVertex->getArmiesOf(playerId);
 
     // If the current player is the owner of the start vertex, find the max armies to move from
     // the start vertex in order to remain the owner.
-    string startVertexOwner = startVertex->getRegionOwner();
-    if (startVertexOwner == currentPlayer->getName()) {
+    if (startVertex->getOwner() == playerId) {
 
         // Find next highest army count that is not the current player.
         int nextHighest = 0;
-        unordered_map<PlayerEntry*, int>::iterator it;
-        for (it = startVertex->getArmies()->begin(); it != startVertex->getArmies()->end(); ++it) {
-            if (it->first != currentPlayer->getPlayerEntry() && it->second > nextHighest) {
-                nextHighest = it->second;
+        for (PlayerId other = 0; other < MAX_PLAYERS; other++) {
+            if (other != playerId && startVertex->getArmiesOf(other) > nextHighest) {
+                nextHighest = startVertex->getArmiesOf(other);
             }
         }
 
@@ -439,25 +451,22 @@ bool ModerateStrategy::changeOwnership(Vertex* startVertex, Vertex* endVertex, P
 void ModerateStrategy::DestroyArmy(Player* player, Players* players) {
     cout << "\n\n[[ ACTION ]] Destroy an army.\n\n" << endl;
 
-    Vertices* vertices = GameMap::instance()->getVertices();
-
-    for(Vertices::iterator it = vertices->begin(); it != vertices->end(); ++it) {
-        Vertex* currentVertex = it->second;
+    // Region IDs are in key order.
+    GameMap* map = player->getMap();
 
-        unordered_map<PlayerEntry*, int>* armies = currentVertex->getArmies();
-        unordered_map<PlayerEntry*, int>::iterator a;
+    for(RegionId id = 0; id < map->getNumRegions(); id++) {
+        Vertex* currentVertex = map->getVertex(id);
 
-        string opponentName = "";
+        Player* opponent = nullptr;
 
-        for (a = armies->begin(); a != armies->end(); ++a) {
-            if (a->first != player->getPlayerEntry()) {
-                opponentName = a->first->first;
+        for (PlayerId opponentId = 0; opponentId < MAX_PLAYERS; opponentId++) {
+            if (opponentId != player->getId() && currentVertex->getArmiesOf(opponentId) > 0) {
+                opponent = player->getMap()->getPlayer(opponentId);
                 break;
             }
         }
 
-        if (opponentName != "") {
-            Player* opponent = players->find(opponentName)->second;
+        if (opponent) {
             player->executeDestroyArmy(currentVertex, opponent);
             break;
         }
@@ -473,43 +482,37 @@ void ModerateStrategy::DestroyArmy(Player* player, Players* players) {
  * @param action The action being executed.
  * @param players A pointer to a list of all the players in the game.
  */
-void ModerateStrategy::PlaceNewArmies(Player* player, const string action, Players* players) {
-    int maxArmies = stoi(action.substr(4, 5));
-    Vertices* playerRegions = player->getOccupiedRegions();
-    Vertex* addVertex = GameMap::instance()->getStartVertex();
-    PlayerEntry* entry = player->getPlayerEntry();
+void ModerateStrategy::PlaceNewArmies(Player* player, const Action& action, Players* players) {
+    int maxArmies = action.amount;
+    OccupiedRegions* playerRegions = player->getOccupiedRegions();
+    Vertex* addVertex = player->getMap()->getStartVertex();
+    PlayerId playerId = player->getId();
 
-    cout << "\n\n[[ ACTION ]] " << action << ".\n\n" << endl;
+    cout << "\n\n[[ ACTION ]] " << describeAction(action) << ".\n\n" << endl;
     cout << "{ " << player->getName() << " } has the choice of adding " << maxArmies << " armies on the board." << endl;
 
     while (maxArmies > 0) {
         int numArmiesToPlace = maxArmies;
 
-        for(Vertices::iterator it = playerRegions->begin(); it != playerRegions->end(); ++it) {
+        for(OccupiedRegions::iterator it = playerRegions->begin(); it != playerRegions->end(); ++it) {
             // Find vertex with a city
             Vertex* vertex = it->second;
-            if (vertex->getCities()->find(entry) != vertex->getCities()->end()) {
+            if (vertex->getCitiesOf(playerId) > 0) {
 
                 // Get number of armies on that vertex
-                int playerArmies = 0;
-                if (vertex->getArmies()->find(entry) != vertex->getArmies()->end()) {
-                    playerArmies = vertex->getArmies()->find(entry)->second;
-                }
+                int playerArmies = vertex->getArmiesOf(playerId);
 
                 // Get owner of vertex.
-                string ownerName = vertex->getRegionOwner();
-                int ownerArmies = 0;
+                PlayerId owner = vertex->getOwner();
 
                 // Get number of owner armies if the owner is not none and the owner is not the same as current player
-                if (ownerName != "" && ownerName != player->getName()) {
-                    Player* owner = players->find(ownerName)->second;
-                    PlayerEntry* ownerEntry = owner->getPlayerEntry();
-                    ownerArmies = vertex->getArmies()->find(ownerEntry)->second;
+                if (owner != NO_PLAYER && owner != playerId) {
+                    int ownerArmies = vertex->getArmiesOf(owner);
 
                     // If the difference between the current player's armies and the owner's armies + 1 is <= maxArmies
-                    // then add the difference to that vertex
+                    // then add the difference to that vertex. An owner ahead only on cities has no difference to make up.
                     int numArmiesDifference = ownerArmies - playerArmies + 1;
-                    if(numArmiesDifference <= maxArmies) {
+                    if(numArmiesDifference > 0 && numArmiesDifference <= maxArmies) {
                         numArmiesToPlace = numArmiesDifference;
                         addVertex = vertex;
                         break;
@@ -536,40 +539,19 @@ void ModerateStrategy::PlaceNewArmies(Player* player, const string action, Playe
  * @param action The action being executed.
  * @param players A pointer to a list of all the players in the game.
  */
-void ModerateStrategy::AndOrAction(Player* player, const string action, Players* players) {
-    vector<string> actionArr;
-
-    if (action.find("OR") != size_t(-1)) {
-        int orPos = action.find("OR");
-        string firstChoice = action.substr(0, orPos - 1);
-        string secondChoice = action.substr(orPos + 3);
-        string chosenAction;
-
-        if (firstChoice.find("Add") != size_t(-1) || firstChoice.find("Move") != size_t(-1)) {
-            chosenAction = firstChoice;
-            cout << "\n{ " << player->getName() << " } [ MODERATE ] Chose Option 1 \"" << chosenAction << "\"" << endl;
+void ModerateStrategy::AndOrAction(Player* player, const CardAction& action, Players* players) {
+    if (action.combinator == OR_ACTION) {
+        if (action.first.type == ADD_ARMY || action.first.isMove()) {
+            cout << "\n{ " << player->getName() << " } [ MODERATE ] Chose Option 1 \"" << describeAction(action.first) << "\"" << endl;
+            performAction(player, action.first, players);
         } else {
-            chosenAction = secondChoice;
-            cout << "\n{ " << player->getName() << " } [ MODERATE ] Chose Option 2 \"" << chosenAction << "\"" << endl;
+            cout << "\n{ " << player->getName() << " } [ MODERATE ] Chose Option 2 \"" << describeAction(action.second) << "\"" << endl;
+            performAction(player, action.second, players);
         }
-
-        actionArr.push_back(chosenAction);
     }
     else {
-        size_t andPos = action.find("AND");
-        actionArr.push_back(action.substr(0, andPos));
-        actionArr.push_back(action.substr(andPos+4));
-    }
-
-    for(vector<string>::iterator it = actionArr.begin(); it != actionArr.end(); ++it) {
-        if ((*it).find("Move") != size_t(-1))
-            MoveArmies(player, *it, players);
-        else if ((*it).find("Add") != size_t(-1))
-            PlaceNewArmies(player, *it, players);
-        else if ((*it).find("Destroy") != size_t(-1))
-            DestroyArmy(player, players);
-        else if ((*it).find("Build") != size_t(-1))
-            BuildCity(player);
+        performAction(player, action.first, players);
+        performAction(player, action.second, players);
     }
 }
 
@@ -579,14 +561,13 @@ void ModerateStrategy::AndOrAction(Player* player, const string action, Players*
  * @param player A pointer to the player using this strategy.
  */
 void ModerateStrategy::BuildCity(Player* player) {
-    Vertices* playerRegions = player->getOccupiedRegions();
+    OccupiedRegions* playerRegions = player->getOccupiedRegions();
     Vertex* buildVertex = playerRegions->begin()->second;
 
-    for(Vertices::iterator it = playerRegions->begin(); it != playerRegions->end(); ++it) {
+    for(OccupiedRegions::iterator it = playerRegions->begin(); it != playerRegions->end(); ++it) {
         // Find first vertex with a city. If none, defaults to the start vertex.
         Vertex* vertex = it->second;
-        PlayerEntry* entry = player->getPlayerEntry();
-        if (vertex->getCities()->find(entry) == vertex->getCities()->end() && vertex != GameMap::instance()->getStartVertex()) {
+        if (vertex->getCitiesOf(player->getId()) == 0 && vertex != player->getMap()->getStartVertex()) {
             cout << "{ " << player->getName() << " } [ MODERATE ] Chose < " << vertex->getName() << " > to build a city." << endl;
             buildVertex = vertex;
             break;
@@ -607,17 +588,16 @@ void ModerateStrategy::BuildCity(Player* player) {
  * @return The position of the chosen card.
  */
 int ModerateStrategy::chooseCardPosition(Player* player, Hand* hand) {
-    vector<Card*>::iterator it = hand->getHand()->begin();
     int count = 0;
 
-    while(it != hand->getHand()->end() && count <= player->getCoins()) {
-        if ((*it)->getAction().find("Add") != size_t(-1) || (*it)->getAction().find("Move") != size_t(-1)) {
+    while(count < hand->size() && count <= player->getCoins()) {
+        const CardAction& action = hand->getCard(count)->getCardAction();
+        if (action.contains(ADD_ARMY) || action.contains(MOVE_OVER_LAND) || action.contains(MOVE_OVER_WATER)) {
             cout << "{ " << player->getName() << " } [ MODERATE ] Chose position " << count + 1<< ". { Cards in hand "
              << player->getHand()->size()+1 << " }." << endl;
             return count;
         }
         count++;
-        it++;
     }
 
     cout << "{ " << player->getName() << " } [ MODERATE ] Chose position " << 1
@@ -664,18 +644,14 @@ void HumanStrategy::BuildCity(Player* player) {
  *
  * @param action The action to be executed.
  */
-void HumanStrategy::MoveArmies(Player* player, const string action, Players* players) {
+void HumanStrategy::MoveArmies(Player* player, const Action& action, Players* players) {
     Vertex* startVertex;
     Vertex* endVertex;
-    int maxArmies;
-    int remainderArmies;
-
-    stringstream toInt(action.substr(5, 6));
-    toInt >> maxArmies;
-    remainderArmies = maxArmies;
+    int maxArmies = action.amount;
+    int remainderArmies = maxArmies;
 
-    bool overWaterAllowed = action.find("water") != size_t(-1);
-    ActionType type = overWaterAllowed ? ActionType::MOVE_OVER_WATER : ActionType::MOVE_OVER_LAND;
+    bool overWaterAllowed = action.isOverWater();
+    ActionType type = action.type;
     string actionSuffix = overWaterAllowed ? " armies over water.\n" : " armies over land.\n";
 
     cout << "\n\n[[ ACTION ]] Move " << maxArmies << actionSuffix << "\n\n" << endl;
@@ -688,7 +664,7 @@ void HumanStrategy::MoveArmies(Player* player, const string action, Players* pla
         cout << "{ " << player->getName() << " } Please choose a region to move armies to." << endl;
         endVertex = chooseEndVertex(player, type);
 
-        int startVertexArmies = startVertex->getArmies()->find(player->getPlayerEntry())->second;
+        int startVertexArmies = startVertex->getArmiesOf(player->getId());
         armies = chooseArmies(player, maxArmies, remainderArmies, startVertexArmies, startVertex->getName());
 
         if (!player->executeMoveArmies(armies, startVertex, endVertex, overWaterAllowed)) {
@@ -708,16 +684,12 @@ void HumanStrategy::MoveArmies(Player* player, const string action, Players* pla
  *
  * @param action The action to be executed.
  */
-void HumanStrategy::PlaceNewArmies(Player* player, const string action, Players* players) {
+void HumanStrategy::PlaceNewArmies(Player* player, const Action& action, Players* players) {
     Vertex* endVertex;
+    int maxArmies = action.amount;
+    int remainderArmies = maxArmies;
 
-    stringstream toInt(action.substr(4, 5));
-    int maxArmies;
-    int remainderArmies;
-    toInt >> maxArmies;
-    remainderArmies = maxArmies;
-
-    cout << "\n\n[[ ACTION ]] " << action << ".\n\n" << endl;
+    cout << "\n\n[[ ACTION ]] " << describeAction(action) << ".\n\n" << endl;
     cout << "{ " << player->getName() << " } You have the choice of adding " << maxArmies << " armies on the board." << endl;
 
     while(remainderArmies > 0) {
@@ -772,27 +744,13 @@ void HumanStrategy::DestroyArmy(Player* player, Players* players) {
  * @param action The action that contains an AND/OR double action
  * @param players A pointer to a map of Player pointers and their names.
  */
-void HumanStrategy::AndOrAction(Player* player, const string action, Players* players) {
-    vector<string> actionArr;
-
-    if (action.find("OR") != size_t(-1)) {
-        actionArr.push_back(chooseORAction(player, action));
+void HumanStrategy::AndOrAction(Player* player, const CardAction& action, Players* players) {
+    if (action.combinator == OR_ACTION) {
+        performAction(player, chooseORAction(player, action), players);
     }
     else {
-        size_t andPos = action.find("AND");
-        actionArr.push_back(action.substr(0, andPos));
-        actionArr.push_back(action.substr(andPos+4));
-    }
-
-    for(vector<string>::iterator it = actionArr.begin(); it != actionArr.end(); ++it) {
-        if ((*it).find("Move") != size_t(-1))
-            MoveArmies(player, *it, players);
-        else if ((*it).find("Add") != size_t(-1))
-            PlaceNewArmies(player, *it, players);
-        else if ((*it).find("Destroy") != size_t(-1))
-            DestroyArmy(player, players);
-        else if ((*it).find("Build") != size_t(-1))
-            BuildCity(player);
+        performAction(player, action.first, players);
+        performAction(player, action.second, players);
     }
 }
 
@@ -859,10 +817,11 @@ Vertex* HumanStrategy::chooseStartVertex(Player* player){
         getline(cin, startName);
         transform(startName.begin(), startName.end(),startName.begin(), ::toupper);
 
-        if (player->getOccupiedRegions()->find(startName) == player->getOccupiedRegions()->end()) {
+        Vertex* startVertex = player->getMap()->findVertex(startName);
+        if (!startVertex || !player->occupiesRegion(startVertex)) {
             cout << "[ ERROR! ] You chose an invalid region name. Please try again." << endl;
         } else {
-            return player->getOccupiedRegions()->find(startName)->second;
+            return startVertex;
         }
     }
 }
@@ -881,8 +840,8 @@ Vertex* HumanStrategy::chooseEndVertex(Player* player, const ActionType& type){
         if (type == ActionType::ADD_ARMY || type == ActionType::BUILD_CITY)
             player->printRegions();
         else if (type == ActionType::MOVE_OVER_LAND || type == ActionType::MOVE_OVER_WATER || type == ActionType::DESTROY_ARMY) {
-            GameMap::instance()->printMap();
-            GameMap::instance()->printOccupiedRegions();
+            player->getMap()->printMap();
+            player->getMap()->printOccupiedRegions();
         } else {
             cerr << "[ ERROR! ] Invalid action type." << endl;
             return 0;
@@ -893,12 +852,13 @@ Vertex* HumanStrategy::chooseEndVertex(Player* player, const ActionType& type){
         transform(endName.begin(), endName.end(), endName.begin(), ::toupper);
         cout << "{ " << player->getName() << " } [ HUMAN ] You chose < " << endName << " >.\n" << endl;
 
-        if (GameMap::instance()->getVertices()->find(endName) == GameMap::instance()->getVertices()->end()) {
+        Vertex* endVertex = player->getMap()->findVertex(endName);
+        if (!endVertex) {
             cerr << "[ ERROR! ] That region doesn't exist on the map." << endl;
             continue;
         }
 
-        return GameMap::instance()->getVertices()->find(endName)->second;
+        return endVertex;
     }
 }
 
@@ -910,29 +870,22 @@ Vertex* HumanStrategy::chooseEndVertex(Player* player, const ActionType& type){
  * @param action The action containing an OR'd action.
  * @return The action chosen by the player.
  */
-string HumanStrategy::chooseORAction(Player* player, const string action) {
+const Action& HumanStrategy::chooseORAction(Player* player, const CardAction& action) {
     string answer;
-    string firstChoice;
-    string secondChoice;
-
-    int orPos = action.find("OR");
 
     while(true) {
         cout << "\n{ " << player->getName() << " } [ HUMAN ] Which action do you want? 1 or 2 ?" << endl;
 
-        firstChoice = action.substr(0, orPos - 1);
-        secondChoice = action.substr(orPos + 3);
-
-        cout << "[ OPTION 1 ] " << firstChoice << endl;
-        cout << "[ OPTION 2 ] " << secondChoice << endl;
+        cout << "[ OPTION 1 ] " << describeAction(action.first) << endl;
+        cout << "[ OPTION 2 ] " << describeAction(action.second) << endl;
 
         cout << "{ " << player->getName() << " } > ";
         getline(cin, answer);
 
         if (answer == "1")
-            return firstChoice;
+            return action.first;
         if (answer == "2")
-            return secondChoice;
+            return action.second;
 
         cout << "[ ERROR! ] Invalid choice. Please enter either '1' or '2'." << endl;
     }
@@ -1,12 +1,11 @@
 #ifndef PLAYER_STRATEGIES_H
 #define PLAYER_STRATEGIES_H
 
+#include "CardAction.h"
 #include "Cards.h"
 #include "Map.h"
 #include "Player.h"
 
-enum ActionType { MOVE_OVER_LAND, ADD_ARMY, DESTROY_ARMY, MOVE_OVER_WATER, BUILD_CITY };
-
 class Card;
 class Hand;
 class Vertex;
@@ -26,13 +25,15 @@ public:
 
     string getType() { return *type; }
 
-    virtual void PlaceNewArmies(Player* player, const string action, Players* players) = 0;
-    virtual void MoveArmies(Player* player, const string action, Players* players) = 0;
+    virtual void PlaceNewArmies(Player* player, const Action& action, Players* players) = 0;
+    virtual void MoveArmies(Player* player, const Action& action, Players* players) = 0;
     virtual void BuildCity(Player* player) = 0;
     virtual void DestroyArmy(Player* player, Players* players) = 0;
-    virtual void AndOrAction(Player* player, const string action, Players* players) = 0;
+    virtual void AndOrAction(Player* player, const CardAction& action, Players* players) = 0;
     virtual int chooseCardPosition(Player* player, Hand* hand) = 0;
 
+    void performAction(Player* player, const Action& action, Players* players);
+
 };
 
 class GreedyStrategy: public Strategy {
@@ -41,11 +42,11 @@ public:
     GreedyStrategy();
     ~GreedyStrategy();
 
-    void PlaceNewArmies(Player* player, const string action, Players* players);
-    void MoveArmies(Player* player, const string action, Players* players);
+    void PlaceNewArmies(Player* player, const Action& action, Players* players);
+    void MoveArmies(Player* player, const Action& action, Players* players);
     void BuildCity(Player* player);
     void DestroyArmy(Player* player, Players* players);
-    void AndOrAction(Player* player, const string action, Players* players);
+    void AndOrAction(Player* player, const CardAction& action, Players* players);
     int chooseCardPosition(Player* player, Hand* hand);
 
 };
@@ -57,11 +58,11 @@ public:
     ModerateStrategy();
     ~ModerateStrategy();
 
-    void PlaceNewArmies(Player* player, const string action, Players* players);
-    void MoveArmies(Player* player, const string action, Players* players);
+    void PlaceNewArmies(Player* player, const Action& action, Players* players);
+    void MoveArmies(Player* player, const Action& action, Players* players);
     void BuildCity(Player* player);
     void DestroyArmy(Player* player, Players* players);
-    void AndOrAction(Player* player, const string action, Players* players);
+    void AndOrAction(Player* player, const CardAction& action, Players* players);
     int chooseCardPosition(Player* player, Hand* hand);
     bool changeOwnership(Vertex* startVertex, Vertex* endVertex, Player* currentPlayer, int& maxNumArmies, Players* players, bool overWaterAllowed);
 
@@ -72,17 +73,17 @@ public:
     HumanStrategy();
     ~HumanStrategy();
 
-    void PlaceNewArmies(Player* player, const string action, Players* players);
-    void MoveArmies(Player* player, const string action, Players* players);
+    void PlaceNewArmies(Player* player, const Action& action, Players* players);
+    void MoveArmies(Player* player, const Action& action, Players* players);
     void BuildCity(Player* player);
     void DestroyArmy(Player* player, Players* players);
-    void AndOrAction(Player* player, const string action, Players* players);
+    void AndOrAction(Player* player, const CardAction& action, Players* players);
 
 private:
     Vertex* chooseStartVertex(Player* player);
     Vertex* chooseEndVertex(Player* player, const ActionType& type);
     int chooseArmies(Player* player, const int&, const int&, int, const string&);
-    string chooseORAction(Player* player, const string action);
+    const Action& chooseORAction(Player* player, const CardAction& action);
     Player* chooseOpponent(Player* player, Players* players);
     int chooseCardPosition(Player* player, Hand* hand);
 };
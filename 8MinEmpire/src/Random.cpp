@@ -0,0 +1,106 @@
+#include "Random.h"
+
+#include <atomic>
+#include <time.h>
+
+// Number of seeds handed out by makeSeed(), so games started in the same second still differ.
+static atomic<uint64_t> seedsMade(0);
+
+/**
+ * Steps a splitmix64 generator. Used to spread a single seed over the whole state.
+ */
+static uint64_t splitMix(uint64_t& value) {
+    uint64_t z = (value += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Default Constructor
+ *
+ * Seeds the generator with makeSeed().
+ */
+Random::Random(): state(new uint64_t[RANDOM_STATE_WORDS]) {
+    seed(makeSeed());
+}
+
+/**
+ * Initializes the generator from a seed.
+ *
+ * @param theSeed The seed. Generators with the same seed draw the same numbers.
+ */
+Random::Random(uint64_t theSeed): state(new uint64_t[RANDOM_STATE_WORDS]) {
+    seed(theSeed);
+}
+
+/**
+ * Copy Constructor
+ *
+ * The copy draws the same numbers as the original from this point on.
+ */
+Random::Random(Random* random): state(new uint64_t[RANDOM_STATE_WORDS]) {
+    for (int i = 0; i < RANDOM_STATE_WORDS; i++)
+        state[i] = random->state[i];
+}
+
+/**
+ * Assignment operator
+ */
+Random& Random::operator=(Random& random) {
+    if (&random != this) {
+        for (int i = 0; i < RANDOM_STATE_WORDS; i++)
+            state[i] = random.state[i];
+    }
+    return *this;
+}
+
+/**
+ * Destructor
+ */
+Random::~Random() {
+    delete[] state;
+    state = nullptr;
+}
+
+/**
+ * Restarts the generator from a seed.
+ *
+ * @param theSeed The seed.
+ */
+void Random::seed(uint64_t theSeed) {
+    for (int i = 0; i < RANDOM_STATE_WORDS; i++)
+        state[i] = splitMix(theSeed);
+}
+
+/**
+ * Draws a number from 0 to bound - 1 without modulo bias, using Lemire's multiply and shift.
+ *
+ * @param bound The number of possible values. Must be at least 1.
+ * @return The random number.
+ */
+uint32_t Random::nextBelow(uint32_t bound) {
+    uint64_t product = (next() >> 32) * bound;
+    uint32_t low = uint32_t(product);
+
+    if (low < bound) {
+        const uint32_t threshold = uint32_t(-bound) % bound;
+        while (low < threshold) {
+            product = (next() >> 32) * bound;
+            low = uint32_t(product);
+        }
+    }
+
+    return uint32_t(product >> 32);
+}
+
+/**
+ * Makes a seed for a game that wasn't given one. Mixes the current time with the number of
+ * seeds made so far, so no two games in the same process get the same seed.
+ *
+ * @return The seed.
+ */
+uint64_t Random::makeSeed() {
+    uint64_t value = uint64_t(time(0)) ^ (seedsMade++ << 32);
+    return splitMix(value);
+}
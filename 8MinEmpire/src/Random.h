@@ -0,0 +1,56 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+using namespace std;
+
+const int RANDOM_STATE_WORDS = 4;
+
+/**
+ * A small, fast, explicitly seeded random number generator (xoshiro256**).
+ *
+ * Everything random in a game draws from the generator of its GameContext, so a game played
+ * with the same seed and the same moves always turns out the same, no matter when it's played
+ * or how many other games are running next to it.
+ */
+class Random {
+    uint64_t* state;
+
+public:
+    Random();
+    Random(uint64_t seed);
+    Random(Random* random);
+    Random& operator=(Random& random);
+    ~Random();
+
+    void seed(uint64_t seed);
+    uint32_t nextBelow(uint32_t bound);
+
+    static uint64_t makeSeed();
+
+    // The words of the state, eg. to save the generator and put it back later.
+    uint64_t* getState() { return state; }
+
+    /**
+     * Draws the next 64 random bits.
+     */
+    uint64_t next() {
+        const uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+        const uint64_t shifted = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= shifted;
+        state[3] = rotateLeft(state[3], 45);
+
+        return result;
+    }
+
+private:
+    static uint64_t rotateLeft(uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); }
+};
+
+#endif
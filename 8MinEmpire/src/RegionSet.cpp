@@ -0,0 +1,102 @@
+#include "RegionSet.h"
+
+#include <cstring>
+
+/**
+ * Default Constructor
+ */
+RegionSet::RegionSet():
+    words(new vector<uint64_t>()) {}
+
+/**
+ * Initializes an empty set that can hold the regions of a map.
+ *
+ * @param numRegions The number of regions on the map.
+ */
+RegionSet::RegionSet(size_t numRegions):
+    words(new vector<uint64_t>(wordsFor(numRegions), 0)) {}
+
+/**
+ * Copy Constructor
+ */
+RegionSet::RegionSet(RegionSet* regionSet) {
+    words = new vector<uint64_t>(*regionSet->words);
+}
+
+/**
+ * Assignment operator
+ */
+RegionSet& RegionSet::operator=(RegionSet& regionSet) {
+    if (&regionSet != this)
+        *words = *regionSet.words;
+    return *this;
+}
+
+/**
+ * Destructor
+ */
+RegionSet::~RegionSet() {
+    delete words;
+    words = nullptr;
+}
+
+/**
+ * Empties the set and resizes it to hold the regions of a map.
+ *
+ * @param numRegions The number of regions on the map.
+ */
+void RegionSet::reset(size_t numRegions) {
+    words->assign(wordsFor(numRegions), 0);
+}
+
+/**
+ * Adds every region of another set of the same size to this one.
+ *
+ * Maps of up to 64 regions fit in a single word. Larger maps are merged a word at a time in a
+ * plain loop that the compiler turns into vector instructions.
+ *
+ * @param otherWords The words of the other set. Must hold at least getNumWords() words.
+ */
+void RegionSet::unite(const uint64_t* otherWords) {
+    uint64_t* out = words->data();
+    const size_t numWords = words->size();
+
+    if (numWords == 1) {
+        out[0] |= otherWords[0];
+        return;
+    }
+
+    for (size_t i = 0; i < numWords; i++)
+        out[i] |= otherWords[i];
+}
+
+/**
+ * Replaces the regions in the set with the ones of another set of the same size.
+ *
+ * @param otherWords The words of the other set. Must hold at least getNumWords() words.
+ * @return A boolean representing if the set changed.
+ */
+bool RegionSet::assign(const uint64_t* otherWords) {
+    size_t numBytes = words->size() * sizeof(uint64_t);
+    if (memcmp(words->data(), otherWords, numBytes) == 0)
+        return false;
+
+    memcpy(words->data(), otherWords, numBytes);
+    return true;
+}
+
+/**
+ * Lists the regions in the set.
+ *
+ * @return The IDs of the regions in the set, in ascending order.
+ */
+vector<RegionId> RegionSet::getIds() {
+    vector<RegionId> ids;
+
+    for (size_t i = 0; i < words->size(); i++) {
+        for (uint64_t word = (*words)[i]; word; word &= word - 1)
+            ids.push_back(RegionId(i * 64 + __builtin_ctzll(word)));
+    }
+
+    return ids;
+}
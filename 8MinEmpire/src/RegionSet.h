@@ -0,0 +1,41 @@
+#ifndef REGION_SET_H
+#define REGION_SET_H
+
+#include "MapTopology.h"
+
+#include <cassert>
+#include <stdint.h>
+#include <vector>
+
+using namespace std;
+
+/**
+ * A fixed size set of region IDs stored as a bitset, one bit per region on the map.
+ */
+class RegionSet {
+    vector<uint64_t>* words;
+
+public:
+    RegionSet();
+    RegionSet(size_t numRegions);
+    RegionSet(RegionSet* regionSet);
+    RegionSet& operator=(RegionSet& regionSet);
+    ~RegionSet();
+
+    void reset(size_t numRegions);
+    void insert(RegionId id) { assert((id >> 6) < words->size()); (*words)[id >> 6] |= uint64_t(1) << (id & 63); }
+    void erase(RegionId id) { assert((id >> 6) < words->size()); (*words)[id >> 6] &= ~(uint64_t(1) << (id & 63)); }
+    bool contains(RegionId id) { return (id >> 6) < words->size() && ((*words)[id >> 6] >> (id & 63)) & 1; }
+
+    void unite(const uint64_t* otherWords);
+    void unite(RegionSet* regionSet) { unite(regionSet->getWords()); }
+    bool assign(const uint64_t* otherWords);
+
+    size_t getNumWords() { return words->size(); }
+    const uint64_t* getWords() { return words->data(); }
+    vector<RegionId> getIds();
+
+    static size_t wordsFor(size_t numRegions) { return (numRegions + 63) / 64; }
+};
+
+#endif
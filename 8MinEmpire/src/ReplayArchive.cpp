@@ -0,0 +1,331 @@
+#include "ReplayArchive.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+/**
+ * Initializes a ReplayArchiveWriter object.
+ *
+ * @param interval The number of turns between two keyframes of a game. Fewer turns make the
+ * archive bigger and every turn quicker to reach.
+ */
+ReplayArchiveWriter::ReplayArchiveWriter(int interval):
+    out(new ofstream()),
+    path(new string()),
+    offset(new uint64_t(0)),
+    keyframeInterval(new int(max(interval, 1))),
+    games(new vector<ArchivedGame>()),
+    keyframes(new vector<ArchivedKeyframe>()),
+    error(new string()) {}
+
+/**
+ * Destructor
+ *
+ * An archive that wasn't closed is left unfinished and removed.
+ */
+ReplayArchiveWriter::~ReplayArchiveWriter() {
+    if (out->is_open()) {
+        out->close();
+        remove((*path + ".tmp").c_str());
+    }
+
+    delete out;
+    delete path;
+    delete offset;
+    delete keyframeInterval;
+    delete games;
+    delete keyframes;
+    delete error;
+
+    out = nullptr;
+    path = nullptr;
+    offset = nullptr;
+    keyframeInterval = nullptr;
+    games = nullptr;
+    keyframes = nullptr;
+    error = nullptr;
+}
+
+/**
+ * Starts a new archive.
+ *
+ * @param archivePath The path of the archive, which is replaced when the archive is closed.
+ * @return A boolean representing if the archive could be started.
+ */
+bool ReplayArchiveWriter::open(const string& archivePath) {
+    *path = archivePath;
+    *offset = 0;
+    games->clear();
+    keyframes->clear();
+    error->clear();
+
+    out->open(*path + ".tmp", ios::binary | ios::trunc);
+    if (!*out) {
+        *error = "couldn't write " + *path;
+        return false;
+    }
+
+    ReplayArchiveHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, REPLAY_ARCHIVE_MAGIC, sizeof(header.magic));
+    header.version = REPLAY_ARCHIVE_VERSION;
+    header.keyframeInterval = uint32_t(*keyframeInterval);
+    write(&header, sizeof(header));
+    return true;
+}
+
+/**
+ * Plays back a game record, then adds it to the archive with its keyframes.
+ *
+ * @param gameLog The record of the game.
+ * @param map A pointer to the map of the record, or nullptr to load the map file of the record.
+ * @return A boolean representing if the game played back in step and was added. If it wasn't,
+ * getError() tells why.
+ */
+bool ReplayArchiveWriter::addGame(const vector<uint8_t>& gameLog, GameMap* map) {
+    if (!out->is_open()) {
+        *error = "the archive isn't open";
+        return false;
+    }
+
+    GameReplayer replayer(gameLog, map);
+    vector<vector<uint8_t>> gameKeyframes;
+    vector<uint32_t> turns;
+
+    while (replayer.replayTurn()) {
+        if (replayer.getNumTurns() % *keyframeInterval == 0) {
+            gameKeyframes.push_back(vector<uint8_t>());
+            replayer.writeKeyframe(&gameKeyframes.back());
+            turns.push_back(uint32_t(replayer.getNumTurns()));
+        }
+    }
+
+    if (!replayer.getError().empty()) {
+        *error = "game " + to_string(games->size()) + ": " + replayer.getError();
+        return false;
+    }
+
+    ArchivedGame game;
+    game.recordOffset = *offset;
+    game.recordSize = uint32_t(gameLog.size());
+    game.numTurns = uint32_t(replayer.getNumTurns());
+    game.firstKeyframe = uint32_t(keyframes->size());
+    game.numKeyframes = uint32_t(gameKeyframes.size());
+    write(gameLog.data(), gameLog.size());
+
+    for (size_t i = 0; i < gameKeyframes.size(); i++) {
+        ArchivedKeyframe keyframe;
+        keyframe.offset = *offset;
+        keyframe.size = uint32_t(gameKeyframes[i].size());
+        keyframe.turn = turns[i];
+        write(gameKeyframes[i].data(), gameKeyframes[i].size());
+        keyframes->push_back(keyframe);
+    }
+
+    games->push_back(game);
+    return true;
+}
+
+/**
+ * Writes the game and keyframe tables and the footer, and puts the archive at its final path.
+ *
+ * @return A boolean representing if the archive was written.
+ */
+bool ReplayArchiveWriter::close() {
+    if (!out->is_open()) {
+        *error = "the archive isn't open";
+        return false;
+    }
+
+    ReplayArchiveFooter footer;
+    memset(&footer, 0, sizeof(footer));
+    memcpy(footer.magic, REPLAY_ARCHIVE_MAGIC, sizeof(footer.magic));
+    footer.numGames = games->size();
+    footer.numKeyframes = keyframes->size();
+
+    align();
+    footer.gamesOffset = *offset;
+    write(games->data(), games->size() * sizeof(ArchivedGame));
+
+    align();
+    footer.keyframesOffset = *offset;
+    write(keyframes->data(), keyframes->size() * sizeof(ArchivedKeyframe));
+    write(&footer, sizeof(footer));
+
+    out->close();
+    string tempPath = *path + ".tmp";
+    if (!*out || rename(tempPath.c_str(), path->c_str()) != 0) {
+        *error = "couldn't write " + *path;
+        remove(tempPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+//PRIVATE
+void ReplayArchiveWriter::write(const void* bytes, size_t size) {
+    out->write((const char*) bytes, streamsize(size));
+    *offset += size;
+}
+
+//PRIVATE
+/**
+ * Pads the archive to a multiple of 8 bytes, so the table that comes next can be used straight
+ * from a memory mapping.
+ */
+void ReplayArchiveWriter::align() {
+    static const char padding[8] = { 0 };
+    write(padding, (8 - *offset % 8) % 8);
+}
+
+/**
+ * Default Constructor
+ */
+ReplayArchive::ReplayArchive():
+    file(new MappedFile()),
+    replayer(nullptr),
+    error(new string()) {}
+
+/**
+ * Destructor
+ */
+ReplayArchive::~ReplayArchive() {
+    delete file;
+    delete replayer;
+    delete error;
+
+    file = nullptr;
+    replayer = nullptr;
+    error = nullptr;
+}
+
+/**
+ * Maps a replay archive into memory and checks its tables.
+ *
+ * @param path The path of the archive.
+ * @return A boolean representing if the archive is open and can be used. If it isn't,
+ * getError() tells why.
+ */
+bool ReplayArchive::open(const string& path) {
+    error->clear();
+
+    if (!file->open(path)) {
+        *error = "couldn't read " + path;
+        return false;
+    }
+
+    if (!isValid()) {
+        *error = path + " isn't a complete replay archive of this version";
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Unmaps the archive. The replayer of the last turn reached is deleted with it, as it reads its
+ * record from the mapping.
+ */
+void ReplayArchive::close() {
+    delete replayer;
+    replayer = nullptr;
+    file->close();
+}
+
+/**
+ * Reaches a turn of a game in the archive. The game is set up straight from the nearest
+ * keyframe at or before the turn, or from its record when the turn comes before the first
+ * keyframe, then the turns after it are played back. Every turn reached reuses the replayer of
+ * the last one, and its game context when the game is on the same map between the same players.
+ *
+ * @param game The index of the game in the archive.
+ * @param turn The turn to reach, 0 being the end of the setup.
+ * @param map A pointer to the map of the game, or nullptr to load the map file of the record.
+ * @return The replayer of the archive at the end of the turn, which stays valid until the next
+ * turn is reached or the archive is closed, or nullptr if the archive has no such turn or the
+ * game went out of step before it. getError() tells which.
+ */
+GameReplayer* ReplayArchive::loadTurn(long game, int turn, GameMap* map) {
+    if (!isOpen() || game < 0 || game >= getNumGames() || turn < 0 || turn > getNumTurns(game)) {
+        *error = "no turn " + to_string(turn) + " in game " + to_string(game);
+        return nullptr;
+    }
+
+    const ArchivedGame& entry = getGames()[game];
+    const uint8_t* record = (const uint8_t*) getData() + entry.recordOffset;
+    if (replayer)
+        replayer->rewind(record, entry.recordSize, map);
+    else
+        replayer = new GameReplayer(record, entry.recordSize, map);
+
+    // The keyframes of a game are in turn order.
+    const ArchivedKeyframe* first = getKeyframes() + entry.firstKeyframe;
+    const ArchivedKeyframe* last = first + entry.numKeyframes;
+    const ArchivedKeyframe* keyframe = upper_bound(first, last, uint32_t(turn),
+        [](uint32_t target, const ArchivedKeyframe& candidate) { return target < candidate.turn; });
+
+    bool isInStep;
+    if (keyframe != first) {
+        keyframe--;
+        isInStep = replayer->setUpFromKeyframe((const uint8_t*) getData() + keyframe->offset, keyframe->size);
+    } else
+        isInStep = replayer->setUp();
+
+    while (isInStep && replayer->getNumTurns() < turn)
+        isInStep = replayer->replayTurn();
+
+    if (!isInStep) {
+        *error = "game " + to_string(game) + ": " + replayer->getError();
+        return nullptr;
+    }
+
+    return replayer;
+}
+
+//PRIVATE
+/**
+ * Checks the header and the footer of the open file, and that every record and keyframe the
+ * tables point to is inside it.
+ */
+bool ReplayArchive::isValid() {
+    const uint64_t size = file->getSize();
+    if (size < sizeof(ReplayArchiveHeader) + sizeof(ReplayArchiveFooter))
+        return false;
+
+    const ReplayArchiveHeader* header = getHeader();
+    const ReplayArchiveFooter* footer = getFooter();
+    if (memcmp(header->magic, REPLAY_ARCHIVE_MAGIC, sizeof(header->magic)) != 0
+        || memcmp(footer->magic, REPLAY_ARCHIVE_MAGIC, sizeof(footer->magic)) != 0
+        || header->version != REPLAY_ARCHIVE_VERSION
+        || header->keyframeInterval == 0)
+        return false;
+
+    // The tables come last, so every record and keyframe ends before them.
+    const uint64_t tablesOffset = footer->gamesOffset;
+    const uint64_t footerOffset = size - sizeof(ReplayArchiveFooter);
+    if (tablesOffset % 8 != 0 || footer->keyframesOffset % 8 != 0
+        || tablesOffset < sizeof(ReplayArchiveHeader)
+        || footer->numGames > (footerOffset - tablesOffset) / sizeof(ArchivedGame)
+        || footer->keyframesOffset < tablesOffset + footer->numGames * sizeof(ArchivedGame)
+        || footer->keyframesOffset > footerOffset
+        || footer->numKeyframes > (footerOffset - footer->keyframesOffset) / sizeof(ArchivedKeyframe))
+        return false;
+
+    for (uint64_t i = 0; i < footer->numGames; i++) {
+        const ArchivedGame& game = getGames()[i];
+        if (game.recordOffset + game.recordSize > tablesOffset
+            || uint64_t(game.firstKeyframe) + game.numKeyframes > footer->numKeyframes)
+            return false;
+    }
+
+    for (uint64_t i = 0; i < footer->numKeyframes; i++) {
+        const ArchivedKeyframe& keyframe = getKeyframes()[i];
+        if (keyframe.offset + keyframe.size > tablesOffset)
+            return false;
+    }
+
+    return true;
+}
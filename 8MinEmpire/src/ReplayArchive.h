@@ -0,0 +1,131 @@
+#ifndef REPLAY_ARCHIVE_H
+#define REPLAY_ARCHIVE_H
+
+#include "GameRecorder.h"
+#include "util/TextUtil.h"
+
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+const char REPLAY_ARCHIVE_MAGIC[8] = { '8', 'M', 'E', 'A', 'R', 'C', 'H', '\0' };
+const uint32_t REPLAY_ARCHIVE_VERSION = 1;
+const int DEFAULT_KEYFRAME_INTERVAL = 8;
+
+/**
+ * The header at the start of a replay archive.
+ */
+struct ReplayArchiveHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t keyframeInterval;
+};
+
+/**
+ * One row of the game table of a replay archive. Rows are indexed by the order the games were
+ * added in, and the keyframes of a game are consecutive rows of the keyframe table.
+ */
+struct ArchivedGame {
+    uint64_t recordOffset;
+    uint32_t recordSize;
+    uint32_t numTurns;
+    uint32_t firstKeyframe;
+    uint32_t numKeyframes;
+};
+
+/**
+ * One row of the keyframe table of a replay archive: the state of a game after a turn (see
+ * GameReplayer::writeKeyframe()).
+ */
+struct ArchivedKeyframe {
+    uint64_t offset;
+    uint32_t size;
+    uint32_t turn;
+};
+
+/**
+ * The footer at the end of a replay archive. It is written last, once every game is in, so the
+ * tables it points to can only be found in a complete archive. Every offset is from the start
+ * of the file, and the tables are aligned to 8 bytes.
+ */
+struct ReplayArchiveFooter {
+    uint64_t gamesOffset;
+    uint64_t numGames;
+    uint64_t keyframesOffset;
+    uint64_t numKeyframes;
+    char magic[8];
+};
+
+/**
+ * Writes game records to a replay archive, each followed by a keyframe every few turns.
+ *
+ * Every game is played back as it is added, to write its keyframes and to check it is in step,
+ * so a broken record never gets into an archive. The archive is written next to its final path
+ * and renamed when it is closed, so a reader never sees a half written archive.
+ */
+class ReplayArchiveWriter {
+    ofstream* out;
+    string* path;
+    uint64_t* offset;
+    int* keyframeInterval;
+    vector<ArchivedGame>* games;
+    vector<ArchivedKeyframe>* keyframes;
+    string* error;
+
+public:
+    ReplayArchiveWriter(int interval = DEFAULT_KEYFRAME_INTERVAL);
+    ReplayArchiveWriter(ReplayArchiveWriter* writer) = delete;
+    ReplayArchiveWriter& operator=(ReplayArchiveWriter& writer) = delete;
+    ~ReplayArchiveWriter();
+
+    bool open(const string& archivePath);
+    bool addGame(const vector<uint8_t>& gameLog, GameMap* map = nullptr);
+    bool close();
+
+    long getNumGames() { return long(games->size()); }
+    const string& getError() { return *error; }
+
+private:
+    void write(const void* bytes, size_t size);
+    void align();
+};
+
+/**
+ * A replay archive mapped into memory. Any turn of any game is reached by loading the nearest
+ * keyframe before it and playing back the turns in between, straight from the mapping. The
+ * archive keeps one replayer, and so one game context, for all the turns it reaches.
+ */
+class ReplayArchive {
+    MappedFile* file;
+    GameReplayer* replayer;
+    string* error;
+
+public:
+    ReplayArchive();
+    ReplayArchive(ReplayArchive* archive) = delete;
+    ReplayArchive& operator=(ReplayArchive& archive) = delete;
+    ~ReplayArchive();
+
+    bool open(const string& path);
+    void close();
+    bool isOpen() { return file->isOpen(); }
+
+    long getNumGames() { return long(getFooter()->numGames); }
+    int getNumTurns(long game) { return int(getGames()[game].numTurns); }
+    int getKeyframeInterval() { return int(getHeader()->keyframeInterval); }
+    GameReplayer* loadTurn(long game, int turn, GameMap* map = nullptr);
+    const string& getError() { return *error; }
+
+private:
+    const char* getData() { return file->getData(); }
+    const ReplayArchiveHeader* getHeader() { return (const ReplayArchiveHeader*) getData(); }
+    const ReplayArchiveFooter* getFooter() { return (const ReplayArchiveFooter*) (getData() + file->getSize() - sizeof(ReplayArchiveFooter)); }
+    const ArchivedGame* getGames() { return (const ArchivedGame*) (getData() + getFooter()->gamesOffset); }
+    const ArchivedKeyframe* getKeyframes() { return (const ArchivedKeyframe*) (getData() + getFooter()->keyframesOffset); }
+    bool isValid();
+};
+
+#endif
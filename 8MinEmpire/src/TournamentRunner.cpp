@@ -0,0 +1,318 @@
+#include "TournamentRunner.h"
+#include "MapLoader.h"
+#include "util/MapUtil.h"
+
+#include <thread>
+
+/**
+ * Default Constructor
+ */
+StrategyStats::StrategyStats(): seats(0), wins(0), draws(0), winsBy(), totalScore(0) {}
+
+/**
+ * Adds how a player of the strategy finished a game.
+ *
+ * @param player The result of the player.
+ * @param isWinner A boolean representing if the player won.
+ * @param isInDraw A boolean representing if the player shares the lead of a draw.
+ * @param decidedBy The tie breaker that decided the game.
+ */
+void StrategyStats::add(const PlayerResult& player, bool isWinner, bool isInDraw, TieBreaker decidedBy) {
+    seats++;
+    totalScore += player.score;
+
+    if (isWinner) {
+        wins++;
+        winsBy[decidedBy]++;
+    }
+
+    if (isInDraw)
+        draws++;
+
+    if (player.score >= int(scores.size()))
+        scores.resize(player.score + 1, 0);
+    scores[player.score]++;
+}
+
+/**
+ * Adds the stats of the same strategy gathered elsewhere.
+ */
+void StrategyStats::merge(const StrategyStats& stats) {
+    seats += stats.seats;
+    wins += stats.wins;
+    draws += stats.draws;
+    totalScore += stats.totalScore;
+
+    for (int i = 0; i < NUM_TIE_BREAKERS; i++)
+        winsBy[i] += stats.winsBy[i];
+
+    if (stats.scores.size() > scores.size())
+        scores.resize(stats.scores.size(), 0);
+    for (size_t score = 0; score < stats.scores.size(); score++)
+        scores[score] += stats.scores[score];
+}
+
+/**
+ * Gets the lowest score that a share of the seats didn't go above.
+ *
+ * @param percentile The share of the seats, from 0 to 1.
+ * @return The score, or 0 if the strategy hasn't played.
+ */
+int StrategyStats::getScorePercentile(double percentile) const {
+    long seatsBelow = 0;
+
+    for (size_t score = 0; score < scores.size(); score++) {
+        seatsBelow += scores[score];
+        if (seatsBelow >= percentile * seats && seatsBelow > 0)
+            return int(score);
+    }
+
+    return 0;
+}
+
+/**
+ * Default Constructor
+ */
+TournamentStats::TournamentStats(): numGames(0), numErrors(0), decidedBy() {}
+
+/**
+ * Adds the result of a game. A game that couldn't be set up only counts as an error.
+ */
+void TournamentStats::add(const GameResult& result) {
+    if (!result.isValid) {
+        if (error.empty())
+            error = result.error;
+        numErrors++;
+        return;
+    }
+
+    numGames++;
+    decidedBy[result.decidedBy]++;
+
+    for (int player = 0; player < int(result.players.size()); player++) {
+        strategies[result.players[player].strategy].add(result.players[player],
+            player == result.winner, result.isInDraw(player), result.decidedBy);
+    }
+}
+
+/**
+ * Adds the stats of games played elsewhere.
+ */
+void TournamentStats::merge(const TournamentStats& stats) {
+    numGames += stats.numGames;
+    numErrors += stats.numErrors;
+
+    if (error.empty())
+        error = stats.error;
+
+    for (int i = 0; i < NUM_TIE_BREAKERS; i++)
+        decidedBy[i] += stats.decidedBy[i];
+
+    for (const pair<const string, StrategyStats>& strategy : stats.strategies)
+        strategies[strategy.first].merge(strategy.second);
+}
+
+/**
+ * Prints how the games were decided, then a table of the wins and the scores of each strategy.
+ */
+void TournamentStats::print() {
+    string divider = "========================================================================";
+
+    cout << endl << divider << endl;
+    cout << "                        T O U R N A M E N T" << endl;
+    cout << divider << endl << endl;
+
+    cout << "[ TOURNAMENT ] " << numGames << " games played";
+    if (numErrors > 0)
+        cout << ", " << numErrors << " couldn't be set up (" << error << ")";
+    cout << "." << endl;
+
+    cout << "[ TOURNAMENT ] Decided by";
+    for (int i = 0; i < NUM_TIE_BREAKERS; i++)
+        cout << "  " << getTieBreakerName(TieBreaker(i)) << ": " << decidedBy[i];
+    cout << endl << endl;
+
+    cout << "  Strategy     Seats    Wins   Win %   Draws   Mean VP   P10  P50  P90  Max" << endl;
+    cout << "  --------------------------------------------------------------------------" << endl;
+
+    for (const pair<const string, StrategyStats>& strategy : strategies) {
+        const StrategyStats& stats = strategy.second;
+        char linebuff[120];
+
+        snprintf(linebuff, sizeof(linebuff), "  %-10s %7ld %7ld  %5.1f %7ld  %8.2f  %4d %4d %4d %4d",
+            strategy.first.c_str(), stats.seats, stats.wins, 100 * stats.getWinRate(), stats.draws,
+            stats.getMeanScore(), stats.getScorePercentile(0.1), stats.getScorePercentile(0.5),
+            stats.getScorePercentile(0.9), int(stats.scores.size()) - 1);
+        cout << linebuff << endl;
+    }
+
+    cout << endl << "  Wins by tie breaker" << endl;
+    cout << "  --------------------------------------------------------------------------" << endl;
+
+    for (const pair<const string, StrategyStats>& strategy : strategies) {
+        char linebuff[120];
+
+        snprintf(linebuff, sizeof(linebuff), "  %-10s score: %-8ld coins: %-8ld armies: %-8ld regions: %ld",
+            strategy.first.c_str(), strategy.second.winsBy[BY_SCORE], strategy.second.winsBy[BY_COINS],
+            strategy.second.winsBy[BY_ARMIES], strategy.second.winsBy[BY_REGIONS]);
+        cout << linebuff << endl;
+    }
+
+    cout << endl << divider << endl << endl;
+}
+
+/**
+ * Initializes a TournamentRunner object.
+ *
+ * @param gameSettings The settings every game is played with. The seed is the seed of the first
+ * game, and game i is played with the seed plus i.
+ * @param games The number of games.
+ * @param threads The number of threads, or 0 for one per core.
+ */
+TournamentRunner::TournamentRunner(const GameSettings& gameSettings, long games, int threads):
+    settings(new GameSettings(gameSettings)),
+    numGames(new long(games)),
+    numThreads(new int(threads > 0 ? threads : max(1, int(thread::hardware_concurrency())))),
+    shares(new vector<GameShare>(*numThreads)),
+    threadStats(new vector<ThreadStats>(*numThreads)) {}
+
+/**
+ * Destructor
+ */
+TournamentRunner::~TournamentRunner() {
+    delete settings;
+    delete numGames;
+    delete numThreads;
+    delete shares;
+    delete threadStats;
+
+    settings = nullptr;
+    numGames = nullptr;
+    numThreads = nullptr;
+    shares = nullptr;
+    threadStats = nullptr;
+}
+
+/**
+ * Plays every game of the tournament, with cout muted, and waits for them to end.
+ *
+ * If the settings have no loaded map, the map file is loaded once and shared by every game.
+ *
+ * @return The stats of all the games.
+ */
+TournamentStats TournamentRunner::run() {
+    MutedConsole mutedConsole;
+    TournamentStats stats;
+    GameMap loadedMap;
+
+    if (!settings->map) {
+        if (!MapLoader(settings->mapFile).generateMap(&loadedMap) || !validateMap(&loadedMap)) {
+            stats.error = "invalid map " + settings->mapFile;
+            stats.numErrors = *numGames;
+            return stats;
+        }
+
+        settings->map = &loadedMap;
+    }
+
+    for (int i = 0; i < *numThreads; i++) {
+        (*shares)[i].next = *numGames * i / *numThreads;
+        (*shares)[i].end = *numGames * (i + 1) / *numThreads;
+        (*threadStats)[i].stats = TournamentStats();
+    }
+
+    vector<thread> threads;
+    for (int i = 1; i < *numThreads; i++)
+        threads.push_back(thread(&TournamentRunner::playShare, this, i));
+
+    playShare(0);
+
+    for (thread& otherThread : threads)
+        otherThread.join();
+
+    for (const ThreadStats& partialStats : *threadStats)
+        stats.merge(partialStats.stats);
+
+    if (settings->map == &loadedMap)
+        settings->map = nullptr;
+
+    return stats;
+}
+
+//PRIVATE
+/**
+ * Plays games until there are none left to take or steal.
+ *
+ * @param worker The index of the thread.
+ */
+void TournamentRunner::playShare(int worker) {
+    GameSettings gameSettings = *settings;
+    TournamentStats& stats = (*threadStats)[worker].stats;
+    long game;
+
+    // A recorder records one game at a time, so the games of a tournament aren't recorded.
+    gameSettings.recorder = nullptr;
+
+    while (takeGame(worker, &game) || (stealGames(worker) && takeGame(worker, &game))) {
+        gameSettings.seed = settings->seed + uint64_t(game);
+
+        HeadlessGameEngine engine(gameSettings);
+        if (engine.setUpGame())
+            engine.runGame();
+
+        stats.add(*engine.getResult());
+    }
+}
+
+//PRIVATE
+/**
+ * Takes the next game from the front of the share of a thread.
+ *
+ * @param worker The index of the thread.
+ * @param game Set to the index of the game.
+ * @return A boolean representing if the share had a game left.
+ */
+bool TournamentRunner::takeGame(int worker, long* game) {
+    GameShare& share = (*shares)[worker];
+    lock_guard<mutex> guard(share.lock);
+
+    if (share.next == share.end)
+        return false;
+
+    *game = share.next++;
+    return true;
+}
+
+//PRIVATE
+/**
+ * Moves the back half of the share of another thread to the empty share of a thread. The other
+ * threads are tried in turn, starting with the next one.
+ *
+ * @param worker The index of the thread.
+ * @return A boolean representing if there were games left to steal.
+ */
+bool TournamentRunner::stealGames(int worker) {
+    for (int i = 1; i < *numThreads; i++) {
+        GameShare& victim = (*shares)[(worker + i) % *numThreads];
+        long first;
+        long end;
+
+        {
+            lock_guard<mutex> guard(victim.lock);
+            if (victim.next == victim.end)
+                continue;
+
+            first = victim.next + (victim.end - victim.next) / 2;
+            end = victim.end;
+            victim.end = first;
+        }
+
+        GameShare& share = (*shares)[worker];
+        lock_guard<mutex> guard(share.lock);
+        share.next = first;
+        share.end = end;
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,96 @@
+#ifndef TOURNAMENT_RUNNER_H
+#define TOURNAMENT_RUNNER_H
+
+#include "HeadlessGame.h"
+
+#include <map>
+#include <mutex>
+
+/**
+ * How the players of one strategy did over a tournament. A strategy that sits at several seats of
+ * a game counts once per seat.
+ */
+struct StrategyStats {
+    long seats;
+    long wins;
+    long draws;
+    long winsBy[NUM_TIE_BREAKERS];
+    long totalScore;
+    vector<long> scores;    // Number of seats that ended with each score.
+
+    StrategyStats();
+
+    void add(const PlayerResult& player, bool isWinner, bool isInDraw, TieBreaker decidedBy);
+    void merge(const StrategyStats& stats);
+
+    double getWinRate() const { return seats ? double(wins) / seats : 0; }
+    double getMeanScore() const { return seats ? double(totalScore) / seats : 0; }
+    int getScorePercentile(double percentile) const;
+};
+
+/**
+ * The results of a tournament, summed up game by game: how the games were decided and how each
+ * strategy did. Stats gathered apart, eg. by separate threads, merge into the same totals in any
+ * order.
+ */
+struct TournamentStats {
+    long numGames;
+    long numErrors;
+    long decidedBy[NUM_TIE_BREAKERS];
+    map<string, StrategyStats> strategies;
+    string error;
+
+    TournamentStats();
+
+    void add(const GameResult& result);
+    void merge(const TournamentStats& stats);
+    void print();
+};
+
+/**
+ * Plays the games of a tournament on a pool of threads.
+ *
+ * Every game has a context of its own and a seed of its own, counted up from the seed of the
+ * settings, so a game turns out the same no matter which thread plays it or when. The games are
+ * handed out with work stealing: each thread starts with an even share of the games and plays
+ * them from the front, and a thread that runs out takes the back half of the share of another.
+ * Threads only meet when one of them steals, and each one keeps its own stats until the end.
+ */
+class TournamentRunner {
+    // The games a thread has left to play, from next to end. Padded so the shares of two threads
+    // are never on the same cache line.
+    struct GameShare {
+        mutex lock;
+        long next;
+        long end;
+        char padding[64];
+    };
+
+    // The stats a thread keeps until the end of the tournament. Padded the same way, as every
+    // game a thread plays writes to its counters.
+    struct ThreadStats {
+        TournamentStats stats;
+        char padding[64];
+    };
+
+    GameSettings* settings;
+    long* numGames;
+    int* numThreads;
+    vector<GameShare>* shares;
+    vector<ThreadStats>* threadStats;
+
+public:
+    TournamentRunner(const GameSettings& gameSettings, long games, int threads);
+    TournamentRunner(TournamentRunner* runner) = delete;
+    TournamentRunner& operator=(TournamentRunner& runner) = delete;
+    ~TournamentRunner();
+
+    TournamentStats run();
+
+private:
+    void playShare(int worker);
+    bool takeGame(int worker, long* game);
+    bool stealGames(int worker);
+};
+
+#endif
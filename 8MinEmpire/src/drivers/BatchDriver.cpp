@@ -0,0 +1,119 @@
+#include "../HeadlessGame.h"
+#include "../MapLoader.h"
+#include "../PlayerStrategies.h"
+#include "../util/MapUtil.h"
+#include <chrono>
+#include <cstdlib>
+
+bool readSetting(const string& arg, GameSettings* settings, int* numPlayers, int* numGames);
+
+/**
+ * Plays tournament games without a console and writes one comma separated record per player
+ * and game (see GameResult::toRecord()). Nothing is read from stdin.
+ *
+ * Arguments are key=value pairs:
+ *     map=FILE         Map file in the maps/ directory (default smallValid.map).
+ *     players=N        Number of players, 2 to 4 (default 2).
+ *     strategies=A,B   Strategies of the players, GREEDY or MODERATE. The list repeats if it is
+ *                      shorter than the players (default GREEDY,MODERATE).
+ *     start=KEY        Key of the start region (default drawn from the seed of each game).
+ *     seed=N           Seed of the first game. The next games count up from it (default 1).
+ *     rounds=N         Rounds per game (default 30).
+ *     games=N          Number of games (default 1).
+ */
+int main(int argc, char* argv[]) {
+    GameSettings settings;
+    settings.mapFile = "smallValid.map";
+    settings.seed = 1;
+    int numPlayers = 2;
+    int numGames = 1;
+
+    settings.strategies.push_back(GREEDY);
+    settings.strategies.push_back(MODERATE);
+
+    for (int i = 1; i < argc; i++) {
+        if (!readSetting(argv[i], &settings, &numPlayers, &numGames))
+            return 1;
+    }
+
+    vector<string> strategies = settings.strategies;
+    settings.strategies.clear();
+    for (int i = 0; i < numPlayers; i++)
+        settings.strategies.push_back(strategies[i % strategies.size()]);
+
+    // Every game shares the map, which is loaded and validated once.
+    GameMap map;
+    bool isMapValid;
+    {
+        MutedConsole mutedConsole;
+        isMapValid = MapLoader(settings.mapFile).generateMap(&map) && validateMap(&map);
+    }
+
+    if (!isMapValid) {
+        cout << "[ ERROR! ] Invalid map < " << settings.mapFile << " >." << endl;
+        return 1;
+    }
+
+    settings.map = &map;
+
+    cout << GameResult::getHeader() << "\n";
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for (int game = 0; game < numGames; game++) {
+        GameResult result = HeadlessGameEngine::play(settings);
+        cout << result.toRecord();
+
+        if (!result.isValid)
+            return 1;
+
+        settings.seed++;
+    }
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cerr << numGames << " games in " << elapsed.count() << " s ("
+         << numGames / elapsed.count() << " games/s)." << endl;
+
+    return 0;
+}
+
+/**
+ * Reads a key=value argument into the settings.
+ *
+ * @return A boolean representing if the argument was understood.
+ */
+bool readSetting(const string& arg, GameSettings* settings, int* numPlayers, int* numGames) {
+    size_t equals = arg.find('=');
+    string key = arg.substr(0, equals);
+    string value = equals == string::npos ? "" : arg.substr(equals + 1);
+
+    if (key == "map" && !value.empty())
+        settings->mapFile = value;
+    else if (key == "players")
+        *numPlayers = atoi(value.c_str());
+    else if (key == "strategies" && !value.empty()) {
+        settings->strategies.clear();
+        transform(value.begin(), value.end(), value.begin(), ::toupper);
+
+        size_t first = 0;
+        while (first <= value.size()) {
+            size_t comma = min(value.find(',', first), value.size());
+            settings->strategies.push_back(value.substr(first, comma - first));
+            first = comma + 1;
+        }
+    }
+    else if (key == "start")
+        settings->startVertex = value;
+    else if (key == "seed")
+        settings->seed = strtoull(value.c_str(), nullptr, 10);
+    else if (key == "rounds")
+        settings->numRounds = atoi(value.c_str());
+    else if (key == "games")
+        *numGames = atoi(value.c_str());
+    else {
+        cout << "[ ERROR! ] Unknown argument < " << arg << " >." << endl;
+        return false;
+    }
+
+    return true;
+}
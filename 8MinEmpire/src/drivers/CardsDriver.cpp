@@ -6,11 +6,19 @@
 #include <cassert>
 
 void test_DeckObject();
+void test_SeededShuffle();
+void test_CompiledActions();
+void test_MarketRing();
+void test_OptimalWilds();
 void test_HandObject();
 void test_FullGame();
 
 int main() {
     test_DeckObject();
+    test_SeededShuffle();
+    test_CompiledActions();
+    test_MarketRing();
+    test_OptimalWilds();
     test_HandObject();
     test_FullGame();
 
@@ -27,22 +35,183 @@ void test_DeckObject() {
     cout << "--------------------------------------------------------------------\n" << endl;
 
     Deck deck;
-    queue<pair<int,Card*>>* cardDeck = deck.getDeck();
 
     int count = 0;
-    Card* card;
-    while(!cardDeck->empty()) {
-        card = cardDeck->front().second;
+    const CardInfo* card;
+    while(!deck.empty()) {
+        card = deck.draw();
         assert(card->getGood() != "" && card->getAction() != "");
         cout << ++count << ": { " << card->getGood() << " : \"" << card->getAction() << "\" }" << endl;
-        cardDeck->pop();
-        delete card;
     }
 
     assert(count == 42);
     cout << "\nDeck contains 42 cards!\n" << endl;
 }
 
+void test_SeededShuffle() {
+    cout << "\n\n========================================================" << endl;
+    cout << "TEST: test_SeededShuffle" << endl;
+    cout << "======================================================================\n" << endl;
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: Decks shuffled from the same seed come out in the same order." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    Random random1(2020);
+    Random random2(2020);
+    Random random3(2021);
+    Deck deck1(&random1);
+    Deck deck2(&random2);
+    Deck deck3(&random3);
+
+    deck1.shuffle();
+    deck2.shuffle();
+    deck3.shuffle();
+
+    bool sameAsOtherSeed = true;
+    set<int> ids;
+    while(!deck1.empty()) {
+        const CardInfo* card1 = deck1.draw();
+        const CardInfo* card2 = deck2.draw();
+        const CardInfo* card3 = deck3.draw();
+
+        assert(card1->getID() == card2->getID());
+        sameAsOtherSeed = sameAsOtherSeed && card1->getID() == card3->getID();
+        ids.insert(card1->getID());
+    }
+
+    assert(ids.size() == 42);
+    assert(!sameAsOtherSeed);
+    cout << "\nBoth decks drew the same 42 cards in the same order, and another seed drew them in another order.\n" << endl;
+}
+
+void test_CompiledActions() {
+    cout << "\n\n========================================================" << endl;
+    cout << "TEST: test_CompiledActions" << endl;
+    cout << "======================================================================\n" << endl;
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: Card actions are compiled to their type, amount and combinator." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    CardAction single = compileAction("Move 4 armies over water");
+    assert(!single.isDouble());
+    assert(single.first.type == MOVE_OVER_WATER && single.first.amount == 4);
+
+    CardAction orAction = compileAction("Add 2 armies OR Build a city");
+    assert(orAction.combinator == OR_ACTION);
+    assert(orAction.first.type == ADD_ARMY && orAction.first.amount == 2);
+    assert(orAction.second.type == BUILD_CITY);
+    assert(orAction.contains(BUILD_CITY) && !orAction.contains(DESTROY_ARMY));
+
+    CardAction andAction = compileAction("Destroy an army AND Add 1 army");
+    assert(andAction.combinator == AND_ACTION);
+    assert(andAction.first.type == DESTROY_ARMY);
+    assert(andAction.second.type == ADD_ARMY && andAction.second.amount == 1);
+
+    assert(compileAction(NONE).first.type == NO_ACTION);
+
+    Deck deck;
+    while(!deck.empty()) {
+        const CardInfo* card = deck.draw();
+        const CardAction& action = card->getCardAction();
+        CardAction compiled = compileAction(card->getAction());
+
+        assert(compiled.combinator == action.combinator);
+        assert(compiled.first.type == action.first.type && compiled.first.amount == action.first.amount);
+        assert(compiled.second.type == action.second.type && compiled.second.amount == action.second.amount);
+    }
+
+    cout << "\nEvery card in the deck reads back as text that compiles to the same action.\n" << endl;
+}
+
+void test_MarketRing() {
+    cout << "\n\n========================================================" << endl;
+    cout << "TEST: test_MarketRing" << endl;
+    cout << "======================================================================\n" << endl;
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: Taking a card from the market slides the cards to its left, and a copy is a few bytes." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    MarketState market = {};
+    for (uint8_t id = 1; id <= MARKET_SIZE; id++)
+        market.push(id);
+
+    for (int round = 0; round < 10; round++) {
+        uint8_t taken = market.take(2);
+        assert(market.count == MARKET_SIZE - 1 && market.lastPosition == 2);
+        market.push(taken);
+    }
+
+    // Each round moves the third card to the right end: 1 2 3 4 5 6 -> 1 2 4 5 6 3 -> ...
+    uint8_t expected[MARKET_SIZE] = {1, 2, 3, 4, 5, 6};
+    for (int round = 0; round < 10; round++) {
+        uint8_t taken = expected[2];
+        for (int i = 2; i < MARKET_SIZE - 1; i++)
+            expected[i] = expected[i + 1];
+        expected[MARKET_SIZE - 1] = taken;
+    }
+
+    for (int i = 0; i < MARKET_SIZE; i++)
+        assert(market.at(i) == expected[i]);
+
+    assert(sizeof(DeckState) + sizeof(MarketState) <= 64);
+    cout << "\nThe market kept its order, and the deck and market fit in " << sizeof(DeckState) + sizeof(MarketState) << " bytes.\n" << endl;
+}
+
+// Tries every good for every wild, one wild at a time.
+int bruteForceBestPoints(GoodsCount goods) {
+    if (goods[GOOD_WILD] == 0)
+        return getGoodsPoints(goods);
+
+    goods[GOOD_WILD]--;
+    int best = getGoodsPoints(goods);
+    for (int good = 0; good < GOOD_WILD; good++) {
+        if (goods[good] == 0)
+            continue;
+
+        goods[good]++;
+        best = max(best, bruteForceBestPoints(goods));
+        goods[good]--;
+    }
+
+    return best;
+}
+
+void test_OptimalWilds() {
+    cout << "\n\n========================================================" << endl;
+    cout << "TEST: test_OptimalWilds" << endl;
+    cout << "======================================================================\n" << endl;
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: Wild goods are added where they score the most." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    // One wild is worth more on 3 GEM (3 -> 5 points) than on anything else here.
+    GoodsCount goods = {};
+    goods[GOOD_WOOD] = 1;
+    goods[GOOD_GEM] = 3;
+    goods[GOOD_WILD] = 1;
+    assert(getBestGoodsPoints(goods) == 5);
+    assert(assignWilds(goods)[GOOD_GEM] == 4);
+
+    Random random(20);
+    for (int i = 0; i < 20000; i++) {
+        for (int good = 0; good < NUM_GOODS; good++)
+            goods[good] = uint8_t(random.nextBelow(good == GOOD_WILD ? 6 : 10));
+
+        int best = bruteForceBestPoints(goods);
+        assert(getBestGoodsPoints(goods) == best);
+
+        GoodsCount assigned = assignWilds(goods);
+        assert(assigned[GOOD_WILD] == 0);
+        assert(getGoodsPoints(assigned) == best);
+    }
+
+    cout << "\nThe table and the assignments matched a brute force search on 20000 hands.\n" << endl;
+}
+
 void test_HandObject() {
     cout << "\n\n========================================================" << endl;
     cout << "TEST: test_HandObject" << endl;
@@ -58,7 +227,8 @@ void test_HandObject() {
     string name = "Player 1";
     Player player(name, 9);
 
-    Card currentCard = gameHand->exchange(&player);
+    const CardInfo* currentCard = gameHand->exchange(&player);
+    assert(currentCard != nullptr);
 
     delete gameHand;
     gameHand = nullptr;
@@ -103,8 +273,8 @@ void test_FullGame() {
 
         cout << "\n\n\n\n[ PLAYER TURN ] " << currentPlayer->getName() << ".\n" << endl;
 
-        Card* currentCard = gameHand->exchange(currentPlayer);
-        performCardAction(currentPlayer, currentCard->getAction(), GameMap::instance(), &players);
+        const CardInfo* currentCard = gameHand->exchange(currentPlayer);
+        performCardAction(currentPlayer, currentCard->getCardAction(), GameMap::instance(), &players);
         gameHand->drawCardFromDeck();
 
         count++;
@@ -117,7 +287,7 @@ void test_FullGame() {
     for (Players::iterator it = players.begin(); it != players.end(); ++it) {
         cout << "[ PLAYER CARDS ] " << it->first << endl;
 
-        for (Card* c : *it->second->getHand()) {
+        for (const CardInfo* c : *it->second->getHand()) {
             cout << "{ CARD: " << c->getGood() << " : " << c->getAction() << endl;
         }
     }
@@ -63,15 +63,12 @@ int main() {
     delete card;
 
     Deck deck;
-    queue<pair<int,Card*>>* cardDeck = deck.getDeck();
 
     int count = 0;
-    while(!cardDeck->empty()) {
-        card = cardDeck->front().second;
-        assert(card->getGood() != "" && card->getAction() != "");
-        cout << ++count << ": Card Type = " << card->getType() << " { " << card->getGood() << " : \"" << card->getAction() << "\" }" << endl;
-        cardDeck->pop();
-        delete card;
+    while(!deck.empty()) {
+        const CardInfo* drawn = deck.draw();
+        assert(drawn->getGood() != "" && drawn->getAction() != "");
+        cout << ++count << ": Card Type = " << drawn->getType() << " { " << drawn->getGood() << " : \"" << drawn->getAction() << "\" }" << endl;
     }
 
     assert(count == 42);
@@ -2,9 +2,10 @@
 #include "../GameObservers.h"
 
 int main() {
-    StartUpGameEngine::instance()->startGame();
+    GameContext context;
+    StartUpGameEngine(&context).startGame();
 
-    GameEngine* engine = GameEngineFactory::create();
+    GameEngine* engine = GameEngineFactory::create(&context);
 
     PhaseObserver phaseObserver(engine);
     StatsObserver statsObserver(engine);
@@ -7,21 +7,23 @@ int main() {
     cout << "TEST: test_GameInitObject" << endl;
     cout << "=====================================================================" << endl;
 
-    InitGameEngine::instance()->initGame();
+    GameContext context;
+    InitGameEngine initEngine(&context);
+    initEngine.initGame();
 
     Hand* hand;
     Players* players;
 
-    hand = InitGameEngine::instance()->getHand();
-    players = InitGameEngine::instance()->getPlayers();
+    hand = initEngine.getHand();
+    players = initEngine.getPlayers();
 
     cout << "\n--------------------------------------------------------------------" << endl;
     cout << "TEST: Verify deck contains 42 cards." << endl;
     cout << "--------------------------------------------------------------------\n" << endl;
 
     Deck* deck = hand->getDeck();
-    int decksize = deck->getDeck()->size();
-    int handsize = hand->getHand()->size();
+    int decksize = deck->size();
+    int handsize = hand->size();
 
     cout << decksize << "+" << handsize << endl;
     assert(decksize + handsize == 42);
@@ -31,16 +33,15 @@ int main() {
     cout << "TEST: Verify game hand contains same cards during initialization." << endl;
     cout << "--------------------------------------------------------------------\n" << endl;
 
-    vector<Card*>::iterator c;
-    for(c = hand->getHand()->begin(); c != hand->getHand()->end(); ++c)
-        cout << (*c)->getGood() << " " << (*c)->getAction() << endl;
+    for(int position = 0; position < hand->size(); position++)
+        cout << hand->getCard(position)->getGood() << " " << hand->getCard(position)->getAction() << endl;
 
     cout << "\n--------------------------------------------------------------------" << endl;
     cout << "TEST: Verify map is same as during initialization." << endl;
     cout << "--------------------------------------------------------------------\n" << endl;
 
-    GameMap::instance()->printMap();
-    GameMap::instance()->printOccupiedRegions();
+    context.getMap()->printMap();
+    context.getMap()->printOccupiedRegions();
 
     cout << "\n--------------------------------------------------------------------" << endl;
     cout << "TEST: Verify players are the same as during initialization." << endl;
@@ -67,8 +68,6 @@ int main() {
         cout << pl->first << " has made bid " << pl->second->getBidder()->getMadeBid() << endl;
     }
 
-    delete InitGameEngine::instance();
-
     return 0;
 
 }
\ No newline at end of file
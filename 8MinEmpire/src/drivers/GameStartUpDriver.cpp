@@ -1,9 +1,8 @@
 #include "../GameStartUp.h"
 
 int main() {
-    StartUpGameEngine::instance()->startGame();
-
-    delete StartUpGameEngine::instance();
+    GameContext context;
+    StartUpGameEngine(&context).startGame();
 
     return 0;
 }
\ No newline at end of file
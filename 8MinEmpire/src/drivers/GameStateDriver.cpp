@@ -0,0 +1,213 @@
+#include "../HeadlessGame.h"
+#include "../MapGenerator.h"
+#include "../MapLoader.h"
+#include "../PlayerStrategies.h"
+#include "../util/MapUtil.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+bool readSetting(const string& arg, GameSettings* settings, int* numPlayers, int* numGames, int* numRegions);
+
+/**
+ * Plays headless games and takes the state of each after every turn, then puts every state back
+ * in a shuffled order and checks the game is the same as when it was taken. From a state in the
+ * middle of each game the rest of the game is played again, and has to turn out the same. Then
+ * times taking and putting back states. Nothing is read from stdin.
+ *
+ * With regions=N the games are played on a map generated for the run instead, eg. one with more
+ * regions than fit in 16 bits.
+ *
+ * Arguments are key=value pairs:
+ *     map=FILE         Map file in the maps/ directory (default smallValid.map).
+ *     players=N        Number of players, 2 to 4 (default 2).
+ *     strategies=A,B   Strategies of the players, GREEDY or MODERATE. The list repeats if it is
+ *                      shorter than the players (default GREEDY,MODERATE).
+ *     start=KEY        Key of the start region (default drawn from the seed of each game).
+ *     seed=N           Seed of the first game. The next games count up from it (default 1).
+ *     rounds=N         Rounds per game (default 30).
+ *     games=N          Number of games (default 200).
+ *     regions=N        Generate a map with N regions and play on it (see MapGenerator).
+ */
+int main(int argc, char* argv[]) {
+    GameSettings settings;
+    settings.mapFile = "smallValid.map";
+    settings.seed = 1;
+    int numPlayers = 2;
+    int numGames = 200;
+    int numRegions = 0;
+
+    settings.strategies.push_back(GREEDY);
+    settings.strategies.push_back(MODERATE);
+
+    for (int i = 1; i < argc; i++) {
+        if (!readSetting(argv[i], &settings, &numPlayers, &numGames, &numRegions))
+            return 1;
+    }
+
+    vector<string> strategies = settings.strategies;
+    settings.strategies.clear();
+    for (int i = 0; i < numPlayers; i++)
+        settings.strategies.push_back(strategies[i % strategies.size()]);
+
+    // A generated map is only kept until it is loaded.
+    if (numRegions > 0) {
+        MapGeneratorSettings generatorSettings;
+        generatorSettings.numRegions = numRegions;
+        generatorSettings.seed = settings.seed;
+        settings.mapFile = "gameState.generated.map";
+
+        if (!MapGenerator(generatorSettings).generate("maps/" + settings.mapFile))
+            return 1;
+    }
+
+    GameMap map;
+    bool isMapValid;
+    {
+        MutedConsole mutedConsole;
+        isMapValid = MapLoader(settings.mapFile).generateMap(&map) && validateMap(&map);
+    }
+
+    if (numRegions > 0)
+        remove(("maps/" + settings.mapFile).c_str());
+
+    if (!isMapValid) {
+        cout << "[ ERROR! ] Invalid map < " << settings.mapFile << " >." << endl;
+        return 1;
+    }
+
+    settings.map = &map;
+
+    const int numTimings = 1000;
+    Random random(settings.seed);
+    size_t stateBytes = 0;
+    long numRestored = 0;
+    chrono::duration<double> snapshotTime(0);
+    chrono::duration<double> nextTurnTime(0);
+    chrono::duration<double> wholeGameTime(0);
+
+    for (int game = 0; game < numGames; game++) {
+        GameSettings gameSettings = settings;
+        gameSettings.seed = settings.seed + uint64_t(game);
+
+        MutedConsole mutedConsole;
+        HeadlessGameEngine engine(gameSettings);
+        bool isSetUp = engine.setUpGame();
+        assert(isSetUp);
+        GameContext* context = engine.getContext();
+
+        vector<GameState> states(settings.numRounds + 1);
+        vector<uint64_t> hashes;
+        context->snapshot(&states[0]);
+        hashes.push_back(context->getStateHash());
+
+        for (int turn = 1; turn <= settings.numRounds; turn++) {
+            engine.playTurn();
+            context->snapshot(&states[turn]);
+            hashes.push_back(context->getStateHash());
+        }
+        stateBytes = states[0].getSize();
+
+        // Every state is put back, in any order, and taken again byte for byte.
+        vector<int> order(states.size());
+        for (size_t i = 0; i < order.size(); i++)
+            order[i] = int(i);
+        for (size_t i = order.size() - 1; i > 0; i--)
+            swap(order[i], order[random.nextBelow(uint32_t(i + 1))]);
+
+        GameState copy;
+        for (int turn : order) {
+            bool isRestored = context->restore(&states[turn]);
+            assert(isRestored);
+            assert(context->getStateHash() == hashes[turn]);
+
+            context->snapshot(&copy);
+            assert(copy.getSize() == states[turn].getSize());
+            assert(memcmp(copy.getHeader(), states[turn].getHeader(), copy.getSize()) == 0);
+            numRestored++;
+        }
+
+        // The rest of the game, played again from the middle, turns out the same.
+        int middle = int(random.nextBelow(uint32_t(settings.numRounds + 1)));
+        context->restore(&states[middle]);
+        for (int turn = middle + 1; turn <= settings.numRounds; turn++) {
+            engine.playTurn();
+            assert(context->getStateHash() == hashes[turn]);
+        }
+
+        if (game > 0 || settings.numRounds == 0)
+            continue;
+
+        // Timed on the first game: taking a state, going back one turn, and going back to the start.
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 0; i < numTimings; i++)
+            context->snapshot(&copy);
+        snapshotTime = chrono::steady_clock::now() - start;
+
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < numTimings; i++)
+            context->restore(&states[settings.numRounds - i % 2]);
+        nextTurnTime = chrono::steady_clock::now() - start;
+
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < numTimings; i++)
+            context->restore(&states[i % 2 ? 0 : settings.numRounds]);
+        wholeGameTime = chrono::steady_clock::now() - start;
+    }
+
+    cout << "[ STATE ] The map has " << map.getNumRegions() << " regions." << endl;
+    cout << "[ STATE ] A state of the game takes " << stateBytes << " bytes." << endl;
+    cout << "[ STATE ] All " << numRestored << " states put back in a shuffled order are the same as when they were taken." << endl;
+    cout << "[ STATE ] Every game played again from the middle turned out the same." << endl;
+    cout << "[ STATE ] Taking a state: " << snapshotTime.count() / numTimings * 1e9 << " ns. Going back one turn: "
+         << nextTurnTime.count() / numTimings * 1e9 << " ns. Going back a whole game: "
+         << wholeGameTime.count() / numTimings * 1e9 << " ns." << endl;
+
+    return 0;
+}
+
+/**
+ * Reads a key=value argument into the settings.
+ *
+ * @return A boolean representing if the argument was understood.
+ */
+bool readSetting(const string& arg, GameSettings* settings, int* numPlayers, int* numGames, int* numRegions) {
+    size_t equals = arg.find('=');
+    string key = arg.substr(0, equals);
+    string value = equals == string::npos ? "" : arg.substr(equals + 1);
+
+    if (key == "map" && !value.empty())
+        settings->mapFile = value;
+    else if (key == "players")
+        *numPlayers = atoi(value.c_str());
+    else if (key == "strategies" && !value.empty()) {
+        settings->strategies.clear();
+        transform(value.begin(), value.end(), value.begin(), ::toupper);
+
+        size_t first = 0;
+        while (first <= value.size()) {
+            size_t comma = min(value.find(',', first), value.size());
+            settings->strategies.push_back(value.substr(first, comma - first));
+            first = comma + 1;
+        }
+    }
+    else if (key == "start")
+        settings->startVertex = value;
+    else if (key == "seed")
+        settings->seed = strtoull(value.c_str(), nullptr, 10);
+    else if (key == "rounds")
+        settings->numRounds = atoi(value.c_str());
+    else if (key == "games" && atoi(value.c_str()) > 0)
+        *numGames = atoi(value.c_str());
+    else if (key == "regions" && atoi(value.c_str()) > 0)
+        *numRegions = atoi(value.c_str());
+    else {
+        cout << "[ ERROR! ] Unknown argument < " << arg << " >." << endl;
+        return false;
+    }
+
+    return true;
+}
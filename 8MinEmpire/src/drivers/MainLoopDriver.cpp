@@ -21,12 +21,12 @@ int main() {
             break;
     }
 
-    Players* players = StartUpGameEngine::instance()->getPlayers();
+    Players* players = gameEngine.getContext()->getPlayers();
 
     for (Players::iterator it = players->begin(); it != players->end(); ++it) {
         cout << "\n[ PLAYER CARDS ] " << it->first << endl;
 
-        for (Card* c : *it->second->getHand()) {
+        for (const CardInfo* c : *it->second->getHand()) {
             cout << "{ CARD: " << c->getGood() << " : " << c->getAction() << " }" << endl;
         }
     }
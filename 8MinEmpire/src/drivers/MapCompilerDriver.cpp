@@ -0,0 +1,90 @@
+#include "../MapLoader.h"
+#include "../util/MapUtil.h"
+#include <cassert>
+#include <algorithm>
+#include <dirent.h>
+
+void compileMapFile(const string& fileName);
+vector<string> getTextMapFiles();
+
+/**
+ * Compiles map files to the binary format MapLoader loads them from.
+ *
+ * With no arguments, every map in the maps/ directory is compiled. Otherwise each argument is
+ * the name of a map file in the maps/ directory. Invalid maps are reported and skipped.
+ */
+int main(int argc, char* argv[]) {
+    vector<string> mapFiles = argc > 1 ? vector<string>(argv + 1, argv + argc) : getTextMapFiles();
+
+    for (const string& fileName : mapFiles)
+        compileMapFile(fileName);
+
+    return 0;
+}
+
+/**
+ * Compiles a map file and checks that loading the compiled map gives back the same map.
+ *
+ * @param fileName The name of the map file in the maps/ directory.
+ */
+void compileMapFile(const string& fileName) {
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "COMPILE: " << fileName << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    MapLoader loader(fileName);
+    bool isCompiled = loader.compileMap();
+
+    if (!isCompiled) {
+        delete GameMap::instance();
+        return;
+    }
+
+    MapTopology textTopology(GameMap::instance()->getTopology());
+    string textImage = GameMap::instance()->getImage();
+    delete GameMap::instance();
+
+    assert(loader.generateMap());
+    GameMap* map = GameMap::instance();
+    MapTopology* graph = map->getTopology();
+
+    assert(graph->getNumRegions() == textTopology.getNumRegions());
+    assert(graph->getNumEdges() == textTopology.getNumEdges());
+    assert(graph->getNumContinents() == textTopology.getNumContinents());
+    assert(map->getImage() == textImage);
+
+    for (RegionId id = 0; id < graph->getNumRegions(); id++) {
+        assert(graph->getKey(id) == textTopology.getKey(id));
+        assert(graph->getName(id) == textTopology.getName(id));
+        assert(graph->getContinentId(id) == textTopology.getContinentId(id));
+
+        RegionRange neighbours = graph->getNeighbours(id);
+        RegionRange textNeighbours = textTopology.getNeighbours(id);
+        assert(equal(neighbours.begin(), neighbours.end(), textNeighbours.begin(), textNeighbours.end()));
+        assert(graph->getLandNeighbours(id).size() == textTopology.getLandNeighbours(id).size());
+    }
+
+    assert(validateMap());
+    cout << "\n" << fileName << " loads back from " << loader.getCompiledMapFilePath() << " unchanged." << endl;
+
+    delete map;
+}
+
+/**
+ * Gets the names of the text map files in the maps/ directory.
+ */
+vector<string> getTextMapFiles() {
+    vector<string> files;
+    DIR* dir = opendir("maps");
+
+    if (dir) {
+        for (struct dirent* ent = readdir(dir); ent != NULL; ent = readdir(dir)) {
+            string file = ent->d_name;
+            if (file.size() > 4 && file.compare(file.size() - 4, 4, ".map") == 0)
+                files.push_back(file);
+        }
+        closedir(dir);
+    }
+
+    return files;
+}
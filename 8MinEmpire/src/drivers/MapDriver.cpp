@@ -5,10 +5,13 @@ void test_ConnectedMap();
 void test_EachRegionBelongsToOneContinent();
 void test_ValidEdges();
 void test_SettingAndGettingStartVertex();
+void test_HopDistances();
+void test_GamesShareTopology();
+void test_FindingRegionsByKey();
+void test_PlayersJoinTheMap();
 
 bool validateEdges();
 bool isConnectedMap();
-vector<set<string>* > getMapContinents();
 bool validateContinents();
 
 int main() {
@@ -16,6 +19,10 @@ int main() {
     test_EachRegionBelongsToOneContinent();
     test_ValidEdges();
     test_SettingAndGettingStartVertex();
+    test_HopDistances();
+    test_GamesShareTopology();
+    test_FindingRegionsByKey();
+    test_PlayersJoinTheMap();
 
     return 0;
 }
@@ -228,4 +235,222 @@ void test_SettingAndGettingStartVertex(){
 
     delete map;
     map = nullptr;
-}
\ No newline at end of file
+}
+void test_HopDistances(){
+    cout << "\n=====================================================================" << endl;
+    cout << "TEST: test_HopDistances" << endl;
+    cout << "=====================================================================" << endl;
+
+    GameMap* map = generateValidMap();
+    Vertices* vertices = map->getVertices();
+    Vertex* a = vertices->find("A")->second;
+    Vertex* q = vertices->find("Q")->second;
+    Vertex* w = vertices->find("W")->second;
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: Distances over land stop at the water edges." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    assert(map->getDistance(a, a, false) == 0);
+    assert(map->getDistance(a, q, false) == FAR_AWAY);
+    assert(map->getDistance(w, q, false) == FAR_AWAY);
+    cout << "Success! Q can't be reached from A or W over land." << endl;
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: Distances over water." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    assert(map->getDistance(a, q, true) == 5);
+    assert(map->getDistance(q, a, true) == 5);
+    assert(map->getDistance(w, q, true) == 8);
+    cout << "Success! A to Q == " << map->getDistance(a, q, true) << " and W to Q == " << map->getDistance(w, q, true) << endl;
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: Regions within two moves of A over land." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    vector<Vertex*> nearby = map->getRegionsWithin(a, 2, false);
+    assert(nearby.size() == 5);
+
+    for (Vertex* region : nearby) {
+        assert(region->getContinent() == "continent1");
+        cout << region->getName() << " ";
+    }
+    cout << endl;
+
+    delete map;
+    map = nullptr;
+}
+
+void test_GamesShareTopology(){
+    cout << "\n=====================================================================" << endl;
+    cout << "TEST: test_GamesShareTopology" << endl;
+    cout << "=====================================================================" << endl;
+
+    GameMap* map = generateValidMap();
+    MapTopology* topology = map->getTopology();
+
+    GameMap* game1 = new GameMap();
+    GameMap* game2 = new GameMap();
+    game1->shareMap(map);
+    game2->shareMap(map);
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: Both games use the topology of the loaded map." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    assert(game1->getTopology() == topology);
+    assert(game2->getTopology() == topology);
+    assert(topology->getReferenceCount() == 3);
+    assert(game1->getVertices()->size() == map->getVertices()->size());
+    cout << "Success! The topology has " << topology->getReferenceCount() << " references." << endl;
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: Pieces placed in one game don't show up in the other." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    PlayerId red = 0;
+    Vertex* a1 = game1->getVertices()->find("A")->second;
+    Vertex* a2 = game2->getVertices()->find("A")->second;
+    string startKey = "A";
+
+    assert(game1->setStartVertex(startKey));
+    a1->setArmies(red, 3);
+    a1->setCities(red, 1);
+
+    assert(a1->getOwner() == red);
+    assert(game1->getNumContinentsOwnedBy(red) == 1);
+    assert(a2->getArmiesOf(red) == 0);
+    assert(game2->getNumContinentsOwnedBy(red) == 0);
+    cout << "Success! Only game 1 has red armies on A." << endl;
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: Resetting a game clears its pieces and start vertex." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    game1->resetPieces();
+
+    assert(a1->getArmiesOf(red) == 0);
+    assert(a1->getCitiesOf(red) == 0);
+    assert(a1->getOwner() == NO_PLAYER);
+    assert(game1->getNumContinentsOwnedBy(red) == 0);
+    assert(game1->getArmyMatrix()->getNumSlots() == 0);
+    assert(game1->getStartVertex() == nullptr);
+    assert(game1->setStartVertex(startKey));
+    cout << "Success! Game 1 is empty again and can pick a new start vertex." << endl;
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: The topology outlives the map it was loaded with." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    delete game1;
+    delete map;
+    assert(topology->getReferenceCount() == 1);
+
+    Vertex* q2 = game2->getVertices()->find("Q")->second;
+    assert(game2->getDistance(a2, q2, true) == 5);
+    cout << "Success! Game 2 still measures A to Q == " << game2->getDistance(a2, q2, true) << endl;
+
+    delete game2;
+    game1 = nullptr;
+    game2 = nullptr;
+    map = nullptr;
+}
+
+void test_FindingRegionsByKey(){
+    cout << "\n=====================================================================" << endl;
+    cout << "TEST: test_FindingRegionsByKey" << endl;
+    cout << "=====================================================================" << endl;
+
+    GameMap* map = generateValidMap();
+    MapTopology* topology = map->getTopology();
+    Vertices* vertices = map->getVertices();
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: Every key hashes to its own region." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    for (Vertices::iterator it = vertices->begin(); it != vertices->end(); ++it) {
+        assert(topology->getId(it->first) == it->second->getId());
+        assert(map->findVertex(it->first) == it->second);
+    }
+    cout << "Success! Found all " << vertices->size() << " regions by key." << endl;
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: Keys that aren't on the map aren't found." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    assert(topology->getId("") == NO_REGION);
+    assert(topology->getId("AA") == NO_REGION);
+    assert(topology->getId("a") == NO_REGION);
+    assert(map->findVertex("NOT A KEY") == nullptr);
+    cout << "Success! Missing keys give NO_REGION." << endl;
+
+    delete map;
+    map = nullptr;
+}
+
+void test_PlayersJoinTheMap(){
+    cout << "\n=====================================================================" << endl;
+    cout << "TEST: test_PlayersJoinTheMap" << endl;
+    cout << "=====================================================================" << endl;
+
+    GameMap* map = generateValidMap();
+    Player alice("Alice", "RED");
+    Player bob("Bob", "BLUE");
+    Vertex* a = map->findVertex("A");
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: Players get their IDs in the order they join the map." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    assert(alice.getId() == 0);
+    assert(bob.getId() == 1);
+    assert(alice.getId() == 0);
+    assert(map->getPlayer(0) == &alice);
+    assert(map->getPlayer(1) == &bob);
+    assert(map->getPlayer(2) == nullptr);
+    assert(map->getPlayer(NO_PLAYER) == nullptr);
+    cout << "Success! Alice is player 0 and Bob is player 1." << endl;
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: Region owners lead back to the player." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    alice.addArmiesToRegion(a, 2);
+    bob.addArmiesToRegion(a, 1);
+
+    assert(a->getArmiesOf(alice.getId()) == 2);
+    assert(a->getArmiesOf(bob.getId()) == 1);
+    assert(map->getPlayer(a->getOwner()) == &alice);
+    cout << "Success! Alice owns A." << endl;
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: Pieces stay on their regions when a region is added to the map." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    map->addVertex("ZZ", "ZZ", "continent1");
+    assert(a->getArmiesOf(alice.getId()) == 2);
+    assert(map->getPlayer(a->getOwner()) == &alice);
+
+    ArmyMatrix* matrix = map->getArmyMatrix();
+    assert(matrix->getArmies(alice.getId(), a->getId()) == 2);
+    assert(matrix->getArmies(bob.getId(), a->getId()) == 1);
+    assert(a->getOwner() == alice.getId() && a->getOwnerMargin() == 1);
+    cout << "Success! The army matrix of the new topology has Alice's 2 armies and Bob's 1 on A." << endl;
+
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: Players join again after the map is reset." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    map->resetPieces();
+
+    assert(map->getNumPlayers() == 0);
+    assert(bob.getId() == 0);
+    assert(alice.getId() == 1);
+    assert(a->getOwner() == NO_PLAYER);
+    cout << "Success! Bob is player 0 and Alice is player 1." << endl;
+
+    delete map;
+    map = nullptr;
+}
@@ -0,0 +1,107 @@
+#include "../MapGenerator.h"
+#include "../MapLoader.h"
+#include "../util/MapUtil.h"
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+
+bool readSetting(const string& arg, MapGeneratorSettings* settings, string* fileName, bool* verify);
+void verifyMapFile(const string& fileName, const MapGeneratorSettings& settings);
+
+/**
+ * Generates a random map file in the maps/ directory, for testing the game on large maps.
+ *
+ * Arguments are key=value pairs:
+ *     regions=N      Number of regions (default 1000, at most 1000000).
+ *     continents=N   Number of continents (default 10).
+ *     skew=X         Zipf exponent of the continent sizes (default 0, equal sizes).
+ *     water=X        Extra water edges per region (default 0.01).
+ *     degree=X       Average number of land edges per region (default 3).
+ *     model=M        Degree distribution, uniform or powerlaw (default uniform).
+ *     seed=N         Random seed (default 1).
+ *     out=FILE       Name of the map file in the maps/ directory (default generated.map).
+ *     verify=1       Load the generated map and check that it is valid.
+ */
+int main(int argc, char* argv[]) {
+    MapGeneratorSettings settings;
+    string fileName = "generated.map";
+    bool verify = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!readSetting(argv[i], &settings, &fileName, &verify))
+            return 1;
+    }
+
+    MapGenerator generator(settings);
+    if (!generator.generate("maps/" + fileName))
+        return 1;
+
+    if (verify)
+        verifyMapFile(fileName, settings);
+
+    return 0;
+}
+
+/**
+ * Reads a key=value argument into the settings.
+ *
+ * @return A boolean representing if the argument was understood.
+ */
+bool readSetting(const string& arg, MapGeneratorSettings* settings, string* fileName, bool* verify) {
+    size_t equals = arg.find('=');
+    string key = arg.substr(0, equals);
+    string value = equals == string::npos ? "" : arg.substr(equals + 1);
+
+    if (key == "regions")
+        settings->numRegions = atoi(value.c_str());
+    else if (key == "continents")
+        settings->numContinents = atoi(value.c_str());
+    else if (key == "skew")
+        settings->sizeSkew = atof(value.c_str());
+    else if (key == "water")
+        settings->waterDensity = atof(value.c_str());
+    else if (key == "degree")
+        settings->averageDegree = atof(value.c_str());
+    else if (key == "model" && (value == "uniform" || value == "powerlaw"))
+        settings->degreeModel = value == "uniform" ? UNIFORM_DEGREE : POWER_LAW_DEGREE;
+    else if (key == "seed")
+        settings->seed = strtoull(value.c_str(), nullptr, 10);
+    else if (key == "out" && !value.empty())
+        *fileName = value;
+    else if (key == "verify")
+        *verify = value != "0";
+    else {
+        cout << "[ ERROR! ] Unknown argument < " << arg << " >." << endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Loads a generated map and checks that it passes the map validators.
+ *
+ * @param fileName The name of the map file in the maps/ directory.
+ * @param settings The settings the map was generated with.
+ */
+void verifyMapFile(const string& fileName, const MapGeneratorSettings& settings) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    MapLoader loader(fileName);
+    assert(loader.generateMap());
+
+    chrono::steady_clock::time_point loaded = chrono::steady_clock::now();
+
+    MapTopology* graph = GameMap::instance()->getTopology();
+    assert(graph->getNumRegions() == size_t(settings.numRegions));
+    assert(graph->getNumContinents() == size_t(settings.numContinents));
+    assert(validateMap());
+
+    chrono::steady_clock::time_point validated = chrono::steady_clock::now();
+
+    cout << "\n" << fileName << " is valid. Loaded in "
+         << chrono::duration_cast<chrono::milliseconds>(loaded - start).count() << " ms, validated in "
+         << chrono::duration_cast<chrono::milliseconds>(validated - loaded).count() << " ms." << endl;
+
+    delete GameMap::instance();
+}
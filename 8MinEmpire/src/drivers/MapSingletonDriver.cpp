@@ -24,6 +24,9 @@ int main() {
 
     mainEngine.startGame();
 
+    // The game plays on the map of its own context. The GameMap instance stays empty.
+    map = mainEngine.getContext()->getMap();
+
     cout << "\nGameMap pointer address: " << map << endl;
     cout << "Map image is ";
     cout << map->getImage() << endl;
@@ -38,7 +41,7 @@ int main() {
 
     mainEngine.getNextPlayer();
 
-    mainEngine.getCurrentPlayer()->PlaceNewArmies(string("Add 2 armies"), StartUpGameEngine::instance()->getPlayers());
+    mainEngine.getCurrentPlayer()->PlaceNewArmies(parseAction("Add 2 armies"), mainEngine.getContext()->getPlayers());
 
     cout << "\nGameMap pointer address: " << map << endl;
     cout << "Map image is " << map->getImage() << endl;
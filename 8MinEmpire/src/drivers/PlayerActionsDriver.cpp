@@ -17,7 +17,7 @@ int main() {
     cout << "--------------------------------------------------------------------\n" << endl;
 
     mainLoop.getNextPlayer();
-    mainLoop.setCurrentCard(&move4Card);
+    mainLoop.setCurrentCard(&move4Card.getInfo());
     mainLoop.performCardAction();
 
     cout << "\n--------------------------------------------------------------------" << endl;
@@ -25,7 +25,7 @@ int main() {
     cout << "--------------------------------------------------------------------\n" << endl;
 
     mainLoop.getNextPlayer();
-    mainLoop.setCurrentCard(&orCard);
+    mainLoop.setCurrentCard(&orCard.getInfo());
     mainLoop.performCardAction();
 
     cout << "\n--------------------------------------------------------------------" << endl;
@@ -33,7 +33,7 @@ int main() {
     cout << "--------------------------------------------------------------------\n" << endl;
 
     mainLoop.getNextPlayer();
-    mainLoop.setCurrentCard(&andCard);
+    mainLoop.setCurrentCard(&andCard.getInfo());
     mainLoop.performCardAction();
 
     cout << "\n--------------------------------------------------------------------" << endl;
@@ -41,7 +41,7 @@ int main() {
     cout << "--------------------------------------------------------------------\n" << endl;
 
     mainLoop.getNextPlayer();
-    mainLoop.setCurrentCard(&buildCard);
+    mainLoop.setCurrentCard(&buildCard.getInfo());
     mainLoop.performCardAction();
 
     cout << "\n--------------------------------------------------------------------" << endl;
@@ -49,7 +49,7 @@ int main() {
     cout << "--------------------------------------------------------------------\n" << endl;
 
     mainLoop.getNextPlayer();
-    mainLoop.setCurrentCard(&move4Card);
+    mainLoop.setCurrentCard(&move4Card.getInfo());
     mainLoop.performCardAction();
 
     return 0;
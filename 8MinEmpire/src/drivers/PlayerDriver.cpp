@@ -48,6 +48,15 @@ void test_PlayerOwnsValidSetOfRegions() {
 
     assert( result == 0 );
 
+    cout << "\n--------------------------------------------------------------------" << endl;
+    cout << "TEST: A region that doesn't exist on the map is set occupied and unoccupied." << endl;
+    cout << "--------------------------------------------------------------------\n" << endl;
+
+    player->setOccupied(england, false);
+    assert( !player->occupiesRegion(england) );
+    player->setOccupied(england, true);
+    assert( player->occupiesRegion(england) );
+
     cout << "\n--------------------------------------------------------------------" << endl;
     cout << "TEST: Player occupies two regions that exist on the map." << endl;
     cout << "--------------------------------------------------------------------\n" << endl;
@@ -80,10 +89,9 @@ void test_PlayerOwnsValidHand(){
     string name = "player 1";
     Player player(name, 9);
 
-    Card* card = new Card(1, "CARROT", "Move 4 armies");
-    player.addCardToHand(card);
+    player.addCardToHand(Deck::getCard(19));
 
-    vector<Card*>* hand = player.getHand();
+    vector<const CardInfo*>* hand = player.getHand();
     cout << "Hand size is " << hand->size() << endl;
 
     assert(hand->size() == size_t(1));
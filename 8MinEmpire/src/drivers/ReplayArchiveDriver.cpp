@@ -0,0 +1,274 @@
+#include "../HeadlessGame.h"
+#include "../MapLoader.h"
+#include "../PlayerStrategies.h"
+#include "../ReplayArchive.h"
+#include "../util/MapUtil.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+
+bool readSetting(const string& arg, GameSettings* settings, int* numPlayers, int* numGames, int* keyframeInterval,
+    string* archiveFile, long* seekGame, int* seekTurn);
+int seekTurn(const string& archiveFile, long game, int turn);
+
+/**
+ * Records headless games into a replay archive with a keyframe every few turns, then reaches
+ * every turn of every game through the archive and checks it is the same state as playing the
+ * record back from its start. Then compares how long random turns take to reach both ways.
+ * Nothing is read from stdin.
+ *
+ * Arguments are key=value pairs:
+ *     archive=FILE     Path of the archive to write, or to read with game=N (required).
+ *     map=FILE         Map file in the maps/ directory (default smallValid.map).
+ *     players=N        Number of players, 2 to 4 (default 2).
+ *     strategies=A,B   Strategies of the players, GREEDY or MODERATE. The list repeats if it is
+ *                      shorter than the players (default GREEDY,MODERATE).
+ *     start=KEY        Key of the start region (default drawn from the seed of each game).
+ *     seed=N           Seed of the first game. The next games count up from it (default 1).
+ *     rounds=N         Rounds per game (default 30).
+ *     games=N          Number of games (default 1000).
+ *     keyframes=N      Turns between two keyframes (default 8).
+ *     game=N           Only print a turn of a game of an existing archive, by its index.
+ *     turn=N           The turn to print with game=N (default 0, the end of the setup).
+ */
+int main(int argc, char* argv[]) {
+    GameSettings settings;
+    settings.mapFile = "smallValid.map";
+    settings.seed = 1;
+    int numPlayers = 2;
+    int numGames = 1000;
+    int keyframeInterval = DEFAULT_KEYFRAME_INTERVAL;
+    string archiveFile;
+    long seekGame = -1;
+    int seekTurnNumber = 0;
+
+    settings.strategies.push_back(GREEDY);
+    settings.strategies.push_back(MODERATE);
+
+    for (int i = 1; i < argc; i++) {
+        if (!readSetting(argv[i], &settings, &numPlayers, &numGames, &keyframeInterval, &archiveFile, &seekGame, &seekTurnNumber))
+            return 1;
+    }
+
+    if (archiveFile.empty()) {
+        cout << "[ ERROR! ] No archive=FILE argument." << endl;
+        return 1;
+    }
+
+    if (seekGame >= 0)
+        return seekTurn(archiveFile, seekGame, seekTurnNumber);
+
+    vector<string> strategies = settings.strategies;
+    settings.strategies.clear();
+    for (int i = 0; i < numPlayers; i++)
+        settings.strategies.push_back(strategies[i % strategies.size()]);
+
+    GameMap map;
+    bool isMapValid;
+    {
+        MutedConsole mutedConsole;
+        isMapValid = MapLoader(settings.mapFile).generateMap(&map) && validateMap(&map);
+    }
+
+    if (!isMapValid) {
+        cout << "[ ERROR! ] Invalid map < " << settings.mapFile << " >." << endl;
+        return 1;
+    }
+
+    settings.map = &map;
+
+    vector<GameRecorder> recorders(numGames);
+    vector<vector<uint64_t>> turnHashes(numGames);
+    size_t recordBytes = 0;
+    ReplayArchiveWriter writer(keyframeInterval);
+    bool isWritten;
+    {
+        MutedConsole mutedConsole;
+
+        for (int game = 0; game < numGames; game++) {
+            GameSettings gameSettings = settings;
+            gameSettings.seed = settings.seed + uint64_t(game);
+            gameSettings.recorder = &recorders[game];
+
+            HeadlessGameEngine engine(gameSettings);
+            bool isSetUp = engine.setUpGame();
+            assert(isSetUp);
+            engine.runGame();
+            recordBytes += recorders[game].getLog().size();
+        }
+
+        // The state after every turn, played back from the start of the record.
+        for (int game = 0; game < numGames; game++) {
+            GameReplayer replayer(recorders[game].getLog(), &map);
+            bool isSetUp = replayer.setUp();
+            assert(isSetUp);
+
+            turnHashes[game].push_back(replayer.getContext()->getStateHash());
+            while (replayer.replayTurn())
+                turnHashes[game].push_back(replayer.getContext()->getStateHash());
+            assert(replayer.getError().empty());
+        }
+
+        isWritten = writer.open(archiveFile);
+        for (int game = 0; isWritten && game < numGames; game++)
+            isWritten = writer.addGame(recorders[game].getLog(), &map);
+        isWritten = isWritten && writer.close();
+    }
+
+    if (!isWritten) {
+        cout << "[ ERROR! ] " << writer.getError() << "." << endl;
+        return 1;
+    }
+
+    ReplayArchive archive;
+    if (!archive.open(archiveFile)) {
+        cout << "[ ERROR! ] " << archive.getError() << "." << endl;
+        return 1;
+    }
+
+    assert(archive.getNumGames() == numGames);
+    long numChecked = 0;
+    {
+        MutedConsole mutedConsole;
+
+        for (int game = 0; game < numGames; game++) {
+            assert(archive.getNumTurns(game) + 1 == int(turnHashes[game].size()));
+
+            for (int turn = 0; turn <= archive.getNumTurns(game); turn++) {
+                GameReplayer* replayer = archive.loadTurn(game, turn, &map);
+                assert(replayer && replayer->getNumTurns() == turn);
+                assert(replayer->getContext()->getStateHash() == turnHashes[game][turn]);
+                numChecked++;
+            }
+        }
+    }
+
+    // The same random turns are reached through the archive, then from the start of the record, both
+    // on one game context.
+    const int numSeeks = 2000;
+    vector<pair<int, int>> seeks;
+    Random random(settings.seed);
+    for (int i = 0; i < numSeeks; i++) {
+        int game = int(random.nextBelow(uint32_t(numGames)));
+        seeks.push_back(make_pair(game, int(random.nextBelow(uint32_t(archive.getNumTurns(game) + 1)))));
+    }
+
+    chrono::duration<double> seekTime(0);
+    chrono::duration<double> replayTime(0);
+    {
+        MutedConsole mutedConsole;
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (const pair<int, int>& seek : seeks)
+            archive.loadTurn(seek.first, seek.second, &map);
+        seekTime = chrono::steady_clock::now() - start;
+
+        GameReplayer replayer(recorders[0].getLog(), &map);
+        start = chrono::steady_clock::now();
+        for (const pair<int, int>& seek : seeks) {
+            replayer.rewind(recorders[seek.first].getLog(), &map);
+            replayer.setUp();
+            while (replayer.getNumTurns() < seek.second && replayer.replayTurn());
+        }
+        replayTime = chrono::steady_clock::now() - start;
+    }
+
+    archive.close();
+
+    ifstream archiveStream(archiveFile, ios::binary | ios::ate);
+    long archiveBytes = long(archiveStream.tellg());
+
+    cout << "[ ARCHIVE ] " << numGames << " games archived in " << archiveBytes << " bytes, " << recordBytes
+         << " of them records (a keyframe every " << keyframeInterval << " turns)." << endl;
+    cout << "[ ARCHIVE ] All " << numChecked << " turns reached through the archive are in step with the records." << endl;
+    cout << "[ ARCHIVE ] " << numSeeks << " random turns reached in " << seekTime.count() << " s, played back from the start in "
+         << replayTime.count() << " s (" << replayTime.count() / seekTime.count() << "x faster)." << endl;
+
+    return 0;
+}
+
+/**
+ * Reaches a turn of a game in an archive and prints the board and the players at that turn.
+ *
+ * @return 0 if the turn was reached in step, else 1.
+ */
+int seekTurn(const string& archiveFile, long game, int turn) {
+    ReplayArchive archive;
+    if (!archive.open(archiveFile)) {
+        cout << "[ ERROR! ] " << archive.getError() << "." << endl;
+        return 1;
+    }
+
+    GameReplayer* replayer;
+    {
+        MutedConsole mutedConsole;
+        replayer = archive.loadTurn(game, turn);
+    }
+
+    if (!replayer) {
+        cout << "[ ERROR! ] " << archive.getError() << "." << endl;
+        return 1;
+    }
+
+    GameContext* context = replayer->getContext();
+    context->getMap()->printOccupiedRegions();
+    for (const string& name : *context->getPlayerOrder()) {
+        Player* player = context->getPlayers()->at(name);
+        cout << "{ " << name << " } " << player->getCoins() << " coins, " << player->getArmies() << " armies and "
+             << player->getCities() << " cities left, " << player->getHand()->size() << " cards." << endl;
+    }
+
+    cout << "[ ARCHIVE ] Reached turn " << turn << " of game " << game << " of < " << archiveFile << " >." << endl;
+    return 0;
+}
+
+/**
+ * Reads a key=value argument into the settings.
+ *
+ * @return A boolean representing if the argument was understood.
+ */
+bool readSetting(const string& arg, GameSettings* settings, int* numPlayers, int* numGames, int* keyframeInterval,
+        string* archiveFile, long* seekGame, int* seekTurn) {
+    size_t equals = arg.find('=');
+    string key = arg.substr(0, equals);
+    string value = equals == string::npos ? "" : arg.substr(equals + 1);
+
+    if (key == "map" && !value.empty())
+        settings->mapFile = value;
+    else if (key == "players")
+        *numPlayers = atoi(value.c_str());
+    else if (key == "strategies" && !value.empty()) {
+        settings->strategies.clear();
+        transform(value.begin(), value.end(), value.begin(), ::toupper);
+
+        size_t first = 0;
+        while (first <= value.size()) {
+            size_t comma = min(value.find(',', first), value.size());
+            settings->strategies.push_back(value.substr(first, comma - first));
+            first = comma + 1;
+        }
+    }
+    else if (key == "start")
+        settings->startVertex = value;
+    else if (key == "seed")
+        settings->seed = strtoull(value.c_str(), nullptr, 10);
+    else if (key == "rounds")
+        settings->numRounds = atoi(value.c_str());
+    else if (key == "games" && atoi(value.c_str()) > 0)
+        *numGames = atoi(value.c_str());
+    else if (key == "keyframes" && atoi(value.c_str()) > 0)
+        *keyframeInterval = atoi(value.c_str());
+    else if (key == "archive" && !value.empty())
+        *archiveFile = value;
+    else if (key == "game" && !value.empty())
+        *seekGame = atol(value.c_str());
+    else if (key == "turn")
+        *seekTurn = atoi(value.c_str());
+    else {
+        cout << "[ ERROR! ] Unknown argument < " << arg << " >." << endl;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,217 @@
+#include "../HeadlessGame.h"
+#include "../MapLoader.h"
+#include "../PlayerStrategies.h"
+#include "../util/MapUtil.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+
+bool readSetting(const string& arg, GameSettings* settings, int* numPlayers, int* numGames, string* saveFile, string* replayFile);
+int replayFile(const string& fileName);
+
+/**
+ * Records headless games, plays every record back and checks it stays in step with the game it
+ * was recorded from, then compares how long the games took to play and to play back. Nothing is
+ * read from stdin.
+ *
+ * Arguments are key=value pairs:
+ *     map=FILE         Map file in the maps/ directory (default smallValid.map).
+ *     players=N        Number of players, 2 to 4 (default 2).
+ *     strategies=A,B   Strategies of the players, GREEDY or MODERATE. The list repeats if it is
+ *                      shorter than the players (default GREEDY,MODERATE).
+ *     start=KEY        Key of the start region (default drawn from the seed of each game).
+ *     seed=N           Seed of the first game. The next games count up from it (default 1).
+ *     rounds=N         Rounds per game (default 30).
+ *     games=N          Number of games (default 1000).
+ *     save=FILE        Write the record of the first game to a file.
+ *     replay=FILE      Only play back the record in a file, eg. one of a reported game.
+ */
+int main(int argc, char* argv[]) {
+    GameSettings settings;
+    settings.mapFile = "smallValid.map";
+    settings.seed = 1;
+    int numPlayers = 2;
+    int numGames = 1000;
+    string saveFile;
+    string replayFileName;
+
+    settings.strategies.push_back(GREEDY);
+    settings.strategies.push_back(MODERATE);
+
+    for (int i = 1; i < argc; i++) {
+        if (!readSetting(argv[i], &settings, &numPlayers, &numGames, &saveFile, &replayFileName))
+            return 1;
+    }
+
+    if (!replayFileName.empty())
+        return replayFile(replayFileName);
+
+    vector<string> strategies = settings.strategies;
+    settings.strategies.clear();
+    for (int i = 0; i < numPlayers; i++)
+        settings.strategies.push_back(strategies[i % strategies.size()]);
+
+    // Every game, played or played back, shares the map, which is loaded and validated once.
+    GameMap map;
+    bool isMapValid;
+    {
+        MutedConsole mutedConsole;
+        isMapValid = MapLoader(settings.mapFile).generateMap(&map) && validateMap(&map);
+    }
+
+    if (!isMapValid) {
+        cout << "[ ERROR! ] Invalid map < " << settings.mapFile << " >." << endl;
+        return 1;
+    }
+
+    settings.map = &map;
+
+    vector<GameRecorder> recorders(numGames);
+    vector<string> errors;
+    size_t recordBytes = 0;
+
+    // The setup and the turns are timed apart: a live game builds a new context for its setup,
+    // while the replayer clears the one of the last game, and the turns are where the
+    // strategies are left out.
+    chrono::duration<double> playSetUpTime(0);
+    chrono::duration<double> playTurnsTime(0);
+    chrono::duration<double> replaySetUpTime(0);
+    chrono::duration<double> replayTurnsTime(0);
+    {
+        MutedConsole mutedConsole;
+
+        for (int game = 0; game < numGames; game++) {
+            GameSettings gameSettings = settings;
+            gameSettings.seed = settings.seed + uint64_t(game);
+            gameSettings.recorder = &recorders[game];
+
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            HeadlessGameEngine engine(gameSettings);
+            bool isSetUp = engine.setUpGame();
+            chrono::steady_clock::time_point setUp = chrono::steady_clock::now();
+            if (isSetUp)
+                engine.runGame();
+            chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+            playSetUpTime += setUp - start;
+            playTurnsTime += end - setUp;
+            recordBytes += recorders[game].getLog().size();
+            assert(isSetUp);
+        }
+
+        // One replayer plays back every record. Its players are only created for the first one,
+        // and cleared for the next ones.
+        GameReplayer replayer(recorders[0].getLog(), &map);
+        for (int game = 0; game < numGames; game++) {
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            replayer.rewind(recorders[game].getLog(), &map);
+            bool isSetUp = replayer.setUp();
+            chrono::steady_clock::time_point setUp = chrono::steady_clock::now();
+            bool isInStep = isSetUp && replayer.replay();
+            chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+            replaySetUpTime += setUp - start;
+            replayTurnsTime += end - setUp;
+
+            if (!isInStep || replayer.getNumTurns() != settings.numRounds)
+                errors.push_back("Game " + to_string(settings.seed + uint64_t(game)) + ": " + replayer.getError());
+        }
+    }
+
+    for (const string& error : errors)
+        cout << "[ ERROR! ] " << error << endl;
+    assert(errors.empty());
+
+    if (!saveFile.empty() && !recorders[0].save(saveFile)) {
+        cout << "[ ERROR! ] Couldn't write < " << saveFile << " >." << endl;
+        return 1;
+    }
+
+    cout << "[ REPLAY ] " << numGames << " games recorded in " << recordBytes << " bytes ("
+         << recordBytes / numGames << " bytes per game)." << endl;
+    cout << "[ REPLAY ] Set up in " << playSetUpTime.count() << " s, set up again in " << replaySetUpTime.count()
+         << " s (" << playSetUpTime.count() / replaySetUpTime.count() << "x faster)." << endl;
+    cout << "[ REPLAY ] Turns played in " << playTurnsTime.count() << " s, played back in " << replayTurnsTime.count()
+         << " s (" << playTurnsTime.count() / replayTurnsTime.count() << "x faster)." << endl;
+    cout << "[ REPLAY ] Games played in " << (playSetUpTime + playTurnsTime).count() << " s, played back in "
+         << (replaySetUpTime + replayTurnsTime).count() << " s ("
+         << (playSetUpTime + playTurnsTime).count() / (replaySetUpTime + replayTurnsTime).count() << "x faster)." << endl;
+    cout << "[ REPLAY ] Every game played back in step with its record." << endl;
+
+    return 0;
+}
+
+/**
+ * Plays back the record in a file and prints the board it ends on.
+ *
+ * @return 0 if the record played back in step, else 1.
+ */
+int replayFile(const string& fileName) {
+    vector<uint8_t> gameLog;
+    if (!GameReplayer::load(fileName, &gameLog)) {
+        cout << "[ ERROR! ] Couldn't read < " << fileName << " >." << endl;
+        return 1;
+    }
+
+    GameReplayer replayer(gameLog);
+    bool isInStep;
+    {
+        MutedConsole mutedConsole;
+        isInStep = replayer.replay();
+    }
+
+    if (!isInStep) {
+        cout << "[ ERROR! ] " << replayer.getError() << "." << endl;
+        return 1;
+    }
+
+    replayer.getContext()->getMap()->printOccupiedRegions();
+    cout << "[ REPLAY ] Played back " << replayer.getNumTurns() << " turns in step with < " << fileName << " >." << endl;
+    return 0;
+}
+
+/**
+ * Reads a key=value argument into the settings.
+ *
+ * @return A boolean representing if the argument was understood.
+ */
+bool readSetting(const string& arg, GameSettings* settings, int* numPlayers, int* numGames, string* saveFile, string* replayFile) {
+    size_t equals = arg.find('=');
+    string key = arg.substr(0, equals);
+    string value = equals == string::npos ? "" : arg.substr(equals + 1);
+
+    if (key == "map" && !value.empty())
+        settings->mapFile = value;
+    else if (key == "players")
+        *numPlayers = atoi(value.c_str());
+    else if (key == "strategies" && !value.empty()) {
+        settings->strategies.clear();
+        transform(value.begin(), value.end(), value.begin(), ::toupper);
+
+        size_t first = 0;
+        while (first <= value.size()) {
+            size_t comma = min(value.find(',', first), value.size());
+            settings->strategies.push_back(value.substr(first, comma - first));
+            first = comma + 1;
+        }
+    }
+    else if (key == "start")
+        settings->startVertex = value;
+    else if (key == "seed")
+        settings->seed = strtoull(value.c_str(), nullptr, 10);
+    else if (key == "rounds")
+        settings->numRounds = atoi(value.c_str());
+    else if (key == "games" && atoi(value.c_str()) > 0)
+        *numGames = atoi(value.c_str());
+    else if (key == "save" && !value.empty())
+        *saveFile = value;
+    else if (key == "replay" && !value.empty())
+        *replayFile = value;
+    else {
+        cout << "[ ERROR! ] Unknown argument < " << arg << " >." << endl;
+        return false;
+    }
+
+    return true;
+}
@@ -24,9 +24,10 @@ int main() {
         getline(cin, cont);
         if(cont != "y" && cont != "Y") {
             //Add cards to each player until they reach their max card capacity to end the game.
+            Card stoneCard(1, STONE, "");
             while(true) {
                 gameEngine.getNextPlayer();
-                gameEngine.getCurrentPlayer()->addCardToHand(new Card(1, STONE, ""));
+                gameEngine.getCurrentPlayer()->addCardToHand(&stoneCard.getInfo());
 
                 if (!gameEngine.continueGame()) {
                     gameEngine.Notify();
@@ -0,0 +1,133 @@
+#include "../TournamentRunner.h"
+#include "../PlayerStrategies.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+
+bool readSetting(const string& arg, GameSettings* settings, int* numPlayers, long* numGames, int* numThreads, bool* verify);
+void verifyStats(const TournamentStats& stats, const TournamentStats& singleThreadStats);
+
+/**
+ * Plays a tournament of headless games on every core and prints the win rates, the scores and
+ * the tie breakers of each strategy. Nothing is read from stdin.
+ *
+ * Arguments are key=value pairs:
+ *     map=FILE         Map file in the maps/ directory (default smallValid.map).
+ *     players=N        Number of players, 2 to 4 (default 2).
+ *     strategies=A,B   Strategies of the players, GREEDY or MODERATE. The list repeats if it is
+ *                      shorter than the players (default GREEDY,MODERATE).
+ *     start=KEY        Key of the start region (default drawn from the seed of each game).
+ *     seed=N           Seed of the first game. The next games count up from it (default 1).
+ *     rounds=N         Rounds per game (default 30).
+ *     games=N          Number of games (default 10000).
+ *     threads=N        Number of threads (default one per core).
+ *     verify=1         Play the games again on a single thread and check the stats are the same.
+ */
+int main(int argc, char* argv[]) {
+    GameSettings settings;
+    settings.mapFile = "smallValid.map";
+    settings.seed = 1;
+    int numPlayers = 2;
+    long numGames = 10000;
+    int numThreads = 0;
+    bool verify = false;
+
+    settings.strategies.push_back(GREEDY);
+    settings.strategies.push_back(MODERATE);
+
+    for (int i = 1; i < argc; i++) {
+        if (!readSetting(argv[i], &settings, &numPlayers, &numGames, &numThreads, &verify))
+            return 1;
+    }
+
+    vector<string> strategies = settings.strategies;
+    settings.strategies.clear();
+    for (int i = 0; i < numPlayers; i++)
+        settings.strategies.push_back(strategies[i % strategies.size()]);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    TournamentRunner runner(settings, numGames, numThreads);
+    TournamentStats stats = runner.run();
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    stats.print();
+    cout << numGames << " games in " << elapsed.count() << " s ("
+         << numGames / elapsed.count() << " games/s)." << endl;
+
+    if (verify) {
+        TournamentRunner singleThreadRunner(settings, numGames, 1);
+        verifyStats(stats, singleThreadRunner.run());
+        cout << "The stats are the same on a single thread." << endl;
+    }
+
+    return stats.numErrors > 0 ? 1 : 0;
+}
+
+/**
+ * Reads a key=value argument into the settings.
+ *
+ * @return A boolean representing if the argument was understood.
+ */
+bool readSetting(const string& arg, GameSettings* settings, int* numPlayers, long* numGames, int* numThreads, bool* verify) {
+    size_t equals = arg.find('=');
+    string key = arg.substr(0, equals);
+    string value = equals == string::npos ? "" : arg.substr(equals + 1);
+
+    if (key == "map" && !value.empty())
+        settings->mapFile = value;
+    else if (key == "players")
+        *numPlayers = atoi(value.c_str());
+    else if (key == "strategies" && !value.empty()) {
+        settings->strategies.clear();
+        transform(value.begin(), value.end(), value.begin(), ::toupper);
+
+        size_t first = 0;
+        while (first <= value.size()) {
+            size_t comma = min(value.find(',', first), value.size());
+            settings->strategies.push_back(value.substr(first, comma - first));
+            first = comma + 1;
+        }
+    }
+    else if (key == "start")
+        settings->startVertex = value;
+    else if (key == "seed")
+        settings->seed = strtoull(value.c_str(), nullptr, 10);
+    else if (key == "rounds")
+        settings->numRounds = atoi(value.c_str());
+    else if (key == "games")
+        *numGames = atol(value.c_str());
+    else if (key == "threads")
+        *numThreads = atoi(value.c_str());
+    else if (key == "verify")
+        *verify = value != "0";
+    else {
+        cout << "[ ERROR! ] Unknown argument < " << arg << " >." << endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Checks that the stats of a tournament don't depend on how many threads played it.
+ */
+void verifyStats(const TournamentStats& stats, const TournamentStats& singleThreadStats) {
+    assert(stats.numGames == singleThreadStats.numGames);
+    assert(stats.numErrors == singleThreadStats.numErrors);
+    assert(equal(stats.decidedBy, stats.decidedBy + NUM_TIE_BREAKERS, singleThreadStats.decidedBy));
+    assert(stats.strategies.size() == singleThreadStats.strategies.size());
+
+    for (const pair<const string, StrategyStats>& strategy : stats.strategies) {
+        const StrategyStats& other = singleThreadStats.strategies.at(strategy.first);
+
+        assert(strategy.second.seats == other.seats);
+        assert(strategy.second.wins == other.wins);
+        assert(strategy.second.draws == other.draws);
+        assert(strategy.second.totalScore == other.totalScore);
+        assert(strategy.second.scores == other.scores);
+        assert(equal(strategy.second.winsBy, strategy.second.winsBy + NUM_TIE_BREAKERS, other.winsBy));
+    }
+}
@@ -5,251 +5,52 @@
 #include "MapUtil.h"
 
 /**
- * Conducts a Breadth-First-Search through the GameMap object to detect if
- * it is a fully connected map.
+ * Checks the whole GameMap instance in one pass and prints every problem found.
  *
- * @return A boolean representing if the map is connnected.
+ * @return A boolean representing if the map is valid.
  */
-bool isConnectedMap(){
-    typedef pair<Vertex*, bool> Edge;
-
-    set<string> visited;
-    queue<string> nextToVisit;
-
-    Vertices* vertices = GameMap::instance()->getVertices();
-
-    //Add first vertex to visited.
-    visited.insert(vertices->begin()->second->getKey());
-
-    //Add all edges from first node to queue
-    vector<Edge>* edges = vertices->begin()->second->getEdges();
-    for(Edge& edge: *edges)
-        nextToVisit.push(edge.first->getKey());
-
-    //Breadth-First-Search
-    while(!nextToVisit.empty()) {
-        string currentKey = nextToVisit.front();
-        nextToVisit.pop();
-
-        // If current node has not been visited yet
-        if (visited.find(currentKey) == visited.end()) {
-            visited.insert(currentKey);
-
-            //Add all of current node's endpoint vertices to nextToVist
-            vector<Edge>* edges = vertices->find(currentKey)->second->getEdges();
-            for(Edge& edge: *edges)
-                nextToVisit.push(edge.first->getKey());
-        }
-    }
-
-    // Check if all nodes of graph have been added to visited set
-    Vertices::iterator it;
-    for (it = vertices->begin(); it != vertices->end(); ++it)
-        if (visited.find(it->first) == visited.end()) {
-            cout << "[ERROR!] Map is not connected.\n" << endl;
-            return false;
-        }
-
-    return true;
+bool validateMap() {
+    return validateMap(GameMap::instance());
 }
 
 /**
- * Analyzes each continent in the map to determine whether it is a valid continent.
+ * Checks a given map the same way as validateMap() and prints the issues found.
  *
- * A valid continents means that each continent contains more than one region and
- * contains no internal water edges.
- *
- * @return A boolean representing if the map contains valid continents.
+ * @param map A pointer to the map to check.
+ * @return A boolean representing if the map is valid.
  */
-bool validateContinents() {
-    vector<set<string>* > continents = getMapContinents();
-    Vertices* vertices = GameMap::instance()->getVertices();
-
-    unordered_set<string> verticesList;
-    for(Vertices::iterator it = vertices->begin(); it != vertices->end(); ++it)
-        verticesList.insert(it->first);
+bool validateMap(GameMap* map) {
+    MapValidator validator(map->getTopology());
+    bool isValid = validator.validate();
+    validator.printIssues();
 
-    //Iterate through each continent and verify that each vertex belongs to only one continent
-    vector<set<string>* >::iterator it;
-    for (it = continents.begin(); it != continents.end(); ++it) {
-
-        //Verify each continent is a connected subgraph
-        if (!isContinentConnected(*it))
-            return false;
-
-        if((*it)->size() > 1) {
-            for (const string& vertex : *(*it)) {
-                if (verticesList.find(vertex) != verticesList.end()) {
-                    Vertex* currentNode = vertices->find(vertex)->second;
-
-                    //for each edge, if water edge and endpoint vertex are found in same continent, return false
-                    vector<Edge> *edges = currentNode->getEdges();
-                    for(Edge& edge: *edges) {
-                        if (edge.second && ((*it)->find(edge.first->getKey()) != (*it)->end())) {
-                            cout << "[ ERROR! ] " << currentNode->getContinent()
-                                << " contains an internal water edge between "
-                                << currentNode->getName() << " and " << edge.first->getName() << endl;
-                            return false;
-                        }
-                    }
-
-                    verticesList.erase(vertex);
-
-                } else {
-                    cout << "[ ERROR! ] " << vertices->find(vertex)->second->getName() << " was found on TWO continents!\n" << endl;
-                    return false;
-                }
-            }
-        } else {
-            cout << "[ ERROR! ] A continent can't have less than two regions!\n" << endl;
-            return false;
-        }
-    }
-
-    for ( set<string>* c : continents) {
-        delete c;
-    }
-
-    return true;
+    return isValid;
 }
 
 /**
- * Conducts a Breadth-First-Search on a continent in a map to determine whether it is a
- * connected subgraph.
+ * Detects if the GameMap object is a fully connected map, over both land and water edges.
  *
- * @param continent A pointer to a set of strings of vertex keys belonging to a continent.
- * @return A boolean that respresents if the continent is a connected subgraph.
+ * @return A boolean representing if the map is connnected.
  */
-bool isContinentConnected(set<string>* continent){
-    //Iterate through set of strings and do a BFS
-    typedef pair<Vertex*, bool> Edge;
-
-    set<string> visited;
-    queue<string> nextToVisit;
-
-    Vertices* vertices = GameMap::instance()->getVertices();
-
-    //Add first vertex to visited.
-    visited.insert(*continent->begin());
-
-    //Add all non-water edges from first node to queue
-    vector<Edge>* edges = vertices->find(*continent->begin())->second->getEdges();
-    for(Edge& edge: *edges)
-        if (!edge.second)
-            nextToVisit.push(edge.first->getKey());
-
-    //Breadth-First-Search
-    while(!nextToVisit.empty()) {
-        string currentKey = nextToVisit.front();
-        nextToVisit.pop();
-
-        if (continent->find(currentKey) == continent->end()) {
-            cout << "[ ERROR! ] " << currentKey << " doesn't belong to " << vertices->find(*continent->begin())->second->getContinent() << "." << endl;
-            return false;
-        }
-
-        // If current node has not been visited yet
-        if (visited.find(currentKey) == visited.end()) {
-            visited.insert(currentKey);
-
-            //Add all of current node's non-water endpoint vertices to nextToVist
-            vector<Edge>* edges = vertices->find(currentKey)->second->getEdges();
-            for(Edge& edge: *edges)
-                if (!edge.second)
-                    nextToVisit.push(edge.first->getKey());
-        }
-    }
-
-    // Check if all nodes of continent have been added to visited set
-    set<string>::iterator it;
-    for (it = continent->begin(); it != continent->end(); ++it)
-        if (visited.find(*it) == visited.end()) {
-            cout << "[ERROR!] Continent is not connected.\n" << endl;
-            return false;
-        }
-    return true;
+bool isConnectedMap(){
+    return reportMapIssues({ EMPTY_MAP, DISCONNECTED_MAP });
 }
 
 /**
- * Conducts a Breadth-First-Search through the GameMap object to find all the continents
- * in the map.
+ * Analyzes each continent in the map to determine whether it is a valid continent.
+ *
+ * A valid continents means that each continent contains more than one region, is connected
+ * over land, is only joined to other continents by water edges and contains no internal water
+ * edges.
  *
- * @param map A GameMap pointer to the map.
- * @return a list of region names grouped in sets representing the different continents on the map.
+ * @return A boolean representing if the map contains valid continents.
  */
-vector<set<string>* > getMapContinents(){
-    vector<set<string>* > continents;
-    Vertices* vertices = GameMap::instance()->getVertices();
-    unordered_set<string> notVisited;
-    queue<string> nextToVisit;
-
-    //Create copy of all vertices in set
-    Vertices::iterator it;
-    for(it = vertices->begin(); it != vertices->end(); ++it)
-        notVisited.insert(it->first);
-
-    int continentIndex = -1;
-    string continentName;
-
-    while(true) {
-        if(notVisited.empty())
-            break;
-
-        //nextToVisit will be empty when a new continent starts
-        if (nextToVisit.empty()) {
-            set<string>* newContinent = new set<string>;
-
-            //Get front node from notVisited and remove it.
-            string key = *notVisited.begin();
-            Vertex* firstNode = vertices->find(key)->second;
-            notVisited.erase(key);
-
-            //Create New continent and add first node.
-            continentName = firstNode->getContinent();
-            newContinent->insert(key);
-            continents.push_back(newContinent);
-            continentIndex++;
-
-            //add edgevertices to nextToVist
-            vector<Edge>* edges = firstNode->getEdges();
-            for(Edge& edge: *edges)
-                //Only add edge vertex if not a water edge and currently in notVisited
-                if (!edge.second && (notVisited.find(edge.first->getKey())!=notVisited.end()))
-                    nextToVisit.push(edge.first->getKey());
-        } else { //Still in a continent
-            string currentNodeKey = nextToVisit.front();
-            nextToVisit.pop();
-            Vertex* currentNode = vertices->find(currentNodeKey)->second;
-
-            //If exist in notVisited, remove it from notVisited, add it to continent, add non-water edges to nextToVisit
-            if(notVisited.find(currentNodeKey) != notVisited.end()) {
-
-                // allows for nodes to be put in multiple continents
-                if (currentNode->getContinent() == continentName) {
-                    notVisited.erase(currentNodeKey);
-                    continents.at(continentIndex)->insert(currentNodeKey);
-
-                    //add edgevertices to nextToVist
-                    vector<Edge> *edges = currentNode->getEdges();
-
-                    for(Edge& edge: *edges)
-                        //Only add edge vertex if not a water edge and currently in notVisited
-                        if (!edge.second && (notVisited.find(edge.first->getKey())!=notVisited.end()))
-                            nextToVisit.push(edge.first->getKey());
-                } else {
-                    continents.at(continentIndex)->insert(currentNodeKey);
-                    cout << "\n[WARNING] " << currentNodeKey << " had a different continent name: " << currentNode->getContinent();
-                }
-            }
-        }
-    }
-
-    return continents;
+bool validateContinents() {
+    return reportMapIssues({ SMALL_CONTINENT, DISCONNECTED_CONTINENT, LAND_EDGE_BETWEEN_CONTINENTS, INTERNAL_WATER_EDGE });
 }
 
 /**
- * Iterates through all the vertices in a GameMap object to determine if the edges of
- * the map are valid.
+ * Determines if the edges of the GameMap object are valid.
  *
  * An invalid edge is when the start vertex points to itself or contains two edges that
  * point to the same vertex.
@@ -257,33 +58,28 @@ vector<set<string>* > getMapContinents(){
  * @return A boolean representing if the map contains valid edges.
  */
 bool validateEdges(){
-    Vertices* vertices = GameMap::instance()->getVertices();
-
-    //for each vertex, create new set, add edgevertex names
-    Vertices::iterator it;
-    for(it = vertices->begin(); it != vertices->end(); ++it) {
-
-        set<string> edgeVertices;
-        vector<Edge>* edges = it->second->getEdges();
-        for (Edge& edge: *edges) {
-
-            // If one of the end vertices has been added to the list already, there exists more than one edge to the same vertex
-            if (edgeVertices.find(edge.first->getName()) != edgeVertices.end()) {
-                cout << "[ ERROR! ] " << it->second->getName() << " points twice to " << edge.first->getName() << endl;
-                return false;
-            }
-
-            // If the end vertex is the same as the current vertex, the edge is a self loop.
-            if (edge.first == it->second) {
-                cout << "[ ERROR! ] " << it->second->getName() << " points to itself. \n" << endl;
-                return false;
-            }
+    return reportMapIssues({ SELF_LOOP, DUPLICATE_EDGE });
+}
 
-            edgeVertices.insert(edge.first->getName());
+/**
+ * Checks the GameMap object and prints the problems of the given types.
+ *
+ * @param types The types of problems to look for.
+ * @return A boolean representing if none of those problems were found.
+ */
+bool reportMapIssues(initializer_list<MapIssueType> types) {
+    MapValidator validator(GameMap::instance()->getTopology());
+    validator.validate();
+
+    bool isValid = true;
+    for (const MapIssue& issue : validator.getIssues()) {
+        if (find(types.begin(), types.end(), issue.type) != types.end()) {
+            cout << "[ ERROR! ] " << validator.describe(issue) << endl;
+            isValid = false;
         }
     }
 
-    return true;
+    return isValid;
 }
 
 /**
@@ -318,25 +114,10 @@ vector<string> split(string& str, char delimiter) {
  * Executes the action of a card.
  *
  * @param player A pointer to the Player object who is using the card.
- * @param action The action to be performed.
+ * @param action The compiled action of the card.
  * @param map A pointer to the GameMap object of the game.
  * @param players A pointer to the list of all players in the game.
  */
-void performCardAction(Player* player, const string action, GameMap* map, Players* players) {
-    if(action.find("OR") != size_t(-1) || action.find("AND") != size_t(-1))
-        player->AndOrAction(action, players);
-    else if (action.find("Move") != size_t(-1)) {
-        if (action.find("water") != size_t(-1))
-            player->MoveOverLand(action, players);
-        else
-            player->MoveOverWater(action, players);
-    }
-    else if (action.find("Add") != size_t(-1))
-        player->PlaceNewArmies(action, players);
-    else if (action.find("Destroy") != size_t(-1))
-        player->DestroyArmy(players);
-    else if (action.find("Build") != size_t(-1))
-        player->BuildCity();
-    else
-        cout << "[ ERROR! ] Invalid action." << endl;
+void performCardAction(Player* player, const CardAction& action, GameMap* map, Players* players) {
+    player->performCardAction(action, players);
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "../Map.h"
 #include "../Player.h"
 #include "../Cards.h"
+#include "../MapValidator.h"
 
 #include <sstream>
 #include <algorithm>
@@ -13,11 +14,12 @@ using namespace std;
 typedef unordered_map<string, Player*> Players;
 typedef pair<Vertex*, bool> Edge;
 
+bool validateMap();
+bool validateMap(GameMap* map);
 bool isConnectedMap();
 bool validateContinents();
-vector<set<string>* > getMapContinents();
 bool validateEdges();
-bool isContinentConnected(set<string>* continent);
-void performCardAction(Player* player, const string action, GameMap* map, Players* players);
+bool reportMapIssues(initializer_list<MapIssueType> types);
+void performCardAction(Player* player, const CardAction& action, GameMap* map, Players* players);
 
 #endif
\ No newline at end of file
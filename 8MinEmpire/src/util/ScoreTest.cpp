@@ -10,7 +10,7 @@ void ScoreTest::test_onePlayerWinsGame() {
 
     mainEngine.startGame();
 
-    Players* players = StartUpGameEngine::instance()->getPlayers();
+    Players* players = mainEngine.getContext()->getPlayers();
 
     //Create cards
     Card* cardArr[] = {
@@ -35,14 +35,17 @@ void ScoreTest::test_onePlayerWinsGame() {
 
     // Add cards to player hand
     for(Players::iterator it = players->begin(); it != players->end(); ++it) {
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
     }
 
     mainEngine.declareWinner();
+
+    for (Card* card : cardArr)
+        delete card;
 }
 
 void ScoreTest::test_twoPlayersTieButHaveDifferentNumCoins() {
@@ -54,7 +57,7 @@ void ScoreTest::test_twoPlayersTieButHaveDifferentNumCoins() {
 
     mainEngine.startGame();
 
-    Players* players = StartUpGameEngine::instance()->getPlayers();
+    Players* players = mainEngine.getContext()->getPlayers();
 
     //Create cards
     Card* cardArr[] = {
@@ -79,14 +82,17 @@ void ScoreTest::test_twoPlayersTieButHaveDifferentNumCoins() {
 
     // Add cards to player hand
     for(Players::iterator it = players->begin(); it != players->end(); ++it) {
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
     }
 
     mainEngine.declareWinner();
+
+    for (Card* card : cardArr)
+        delete card;
 }
 
 void ScoreTest::test_twoPlayersTieAndHaveSameNumCoins() {
@@ -98,7 +104,7 @@ void ScoreTest::test_twoPlayersTieAndHaveSameNumCoins() {
 
     mainEngine.startGame();
 
-    Players* players = StartUpGameEngine::instance()->getPlayers();
+    Players* players = mainEngine.getContext()->getPlayers();
 
     //Create cards
     Card* cardArr[] = {
@@ -123,14 +129,14 @@ void ScoreTest::test_twoPlayersTieAndHaveSameNumCoins() {
 
     // Add cards to player hand
     for(Players::iterator it = players->begin(); it != players->end(); ++it) {
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
     }
 
-    Vertices* vertices = GameMap::instance()->getVertices();
+    Vertices* vertices = mainEngine.getContext()->getMap()->getVertices();
 
     Vertex* PEVertex = vertices->find("PE")->second;
 
@@ -138,6 +144,9 @@ void ScoreTest::test_twoPlayersTieAndHaveSameNumCoins() {
     *players->begin()->second->armies -= 2;
 
     mainEngine.declareWinner();
+
+    for (Card* card : cardArr)
+        delete card;
 }
 
 void ScoreTest::test_twoPlayersTieAndHaveSameNumCoinsAndSameNumArmies() {
@@ -149,7 +158,7 @@ void ScoreTest::test_twoPlayersTieAndHaveSameNumCoinsAndSameNumArmies() {
 
     mainEngine.startGame();
 
-    Players* players = StartUpGameEngine::instance()->getPlayers();
+    Players* players = mainEngine.getContext()->getPlayers();
 
     //Create cards
     Card* cardArr[] = {
@@ -174,20 +183,23 @@ void ScoreTest::test_twoPlayersTieAndHaveSameNumCoinsAndSameNumArmies() {
 
     // Add cards to player hand
     for(Players::iterator it = players->begin(); it != players->end(); ++it) {
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
     }
 
-    Vertices* vertices = GameMap::instance()->getVertices();
+    Vertices* vertices = mainEngine.getContext()->getMap()->getVertices();
 
     Vertex* BAVertex = vertices->find("BA")->second;
 
     players->begin()->second->addArmiesToRegion(BAVertex, 1);
 
     mainEngine.declareWinner();
+
+    for (Card* card : cardArr)
+        delete card;
 }
 
 void ScoreTest::test_playerHasWildCard() {
@@ -199,7 +211,7 @@ void ScoreTest::test_playerHasWildCard() {
 
     mainEngine.startGame();
 
-    Players* players = StartUpGameEngine::instance()->getPlayers();
+    Players* players = mainEngine.getContext()->getPlayers();
 
     //Create cards
     Card* cardArr[] = {
@@ -224,14 +236,17 @@ void ScoreTest::test_playerHasWildCard() {
 
     // Add cards to player hand
     for(Players::iterator it = players->begin(); it != players->end(); ++it) {
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
-        it->second->addCardToHand(cardArr[i++]);
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
+        it->second->addCardToHand(&cardArr[i++]->getInfo());
     }
 
     mainEngine.declareWinner();
+
+    for (Card* card : cardArr)
+        delete card;
 }
 
 
@@ -241,6 +256,7 @@ void ScoreTest::test_gameEndsWhenPlayersHaveMaxNumCards() {
     cout << "=====================================================================" << endl;
 
     MainGameEngine mainEngine;
+    Card stoneCard(1, STONE, "");
 
     mainEngine.startGame();
 
@@ -248,7 +264,7 @@ void ScoreTest::test_gameEndsWhenPlayersHaveMaxNumCards() {
 
         mainEngine.getNextPlayer();
 
-        mainEngine.getCurrentPlayer()->addCardToHand(new Card(1, STONE, ""));
+        mainEngine.getCurrentPlayer()->addCardToHand(&stoneCard.getInfo());
 
         if (!mainEngine.continueGame())
             break;
@@ -17,7 +17,7 @@
  * @return A boolean representing that the Player's regions exist on the map.
  */
 bool playerOccupiedRegionsAreFoundOnMap(Player* player, GameMap* map) {
-    Vertices::iterator it;
+    OccupiedRegions::iterator it;
 
     for(it = player->getOccupiedRegions()->begin(); it != player->getOccupiedRegions()->end(); ++it) {
         if (map->getVertices()->find(it->second->getKey()) == map->getVertices()->end()) {
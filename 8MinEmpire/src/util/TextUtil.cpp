@@ -0,0 +1,165 @@
+/**
+ * TextUtil contains helpers for reading text files without copying them.
+ */
+
+#include "TextUtil.h"
+
+#include <cctype>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * Default Constructor
+ */
+MappedFile::MappedFile():
+    data(nullptr),
+    size(new size_t(0)) {}
+
+/**
+ * Destructor
+ */
+MappedFile::~MappedFile() {
+    close();
+
+    delete size;
+    size = nullptr;
+}
+
+/**
+ * Maps a file into memory, read only.
+ *
+ * @param path The path of the file.
+ * @return A boolean representing if the file was opened.
+ */
+bool MappedFile::open(const string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // mmap refuses empty mappings, and an empty file doesn't need one.
+    if (info.st_size == 0) {
+        ::close(fd);
+        data = "";
+        return true;
+    }
+
+    void* mapping = mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (mapping == MAP_FAILED)
+        return false;
+
+    data = (const char*) mapping;
+    *size = size_t(info.st_size);
+    return true;
+}
+
+/**
+ * Unmaps the file, if one is open.
+ */
+void MappedFile::close() {
+    if (data && *size > 0)
+        munmap((void*) data, *size);
+
+    data = nullptr;
+    *size = 0;
+}
+
+/**
+ * 64 bit FNV-1a hash of the characters in the span.
+ */
+size_t TextSpanHash::operator()(const TextSpan& span) const {
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (size_t i = 0; i < span.size; i++) {
+        hash ^= uint8_t(span.data[i]);
+        hash *= 1099511628211ULL;
+    }
+
+    return size_t(hash);
+}
+
+/**
+ * Initializes a cursor at the start of a buffer.
+ *
+ * @param data The start of the buffer.
+ * @param size The size of the buffer.
+ */
+TextCursor::TextCursor(const char* data, size_t size):
+    position(data),
+    end(data + size),
+    lineNumber(0),
+    reachedEnd(false) {}
+
+/**
+ * Reads the next line. The line doesn't include its newline character.
+ *
+ * Works like getline() on a stream: isAtEnd() becomes true once a line runs into the end of the
+ * buffer without a newline, or when there is no line left to read.
+ *
+ * @param line A pointer to the span to fill with the line.
+ * @return A boolean representing if a line was read.
+ */
+bool TextCursor::nextLine(TextSpan* line) {
+    if (position >= end) {
+        reachedEnd = true;
+        line->data = end;
+        line->size = 0;
+        return false;
+    }
+
+    const char* newline = (const char*) memchr(position, '\n', end - position);
+    const char* lineEnd = newline ? newline : end;
+
+    line->data = position;
+    line->size = lineEnd - position;
+    lineNumber++;
+
+    position = newline ? newline + 1 : end;
+    reachedEnd = newline == nullptr;
+    return true;
+}
+
+/**
+ * Gets everything after the last line read.
+ */
+TextSpan TextCursor::getRest() {
+    TextSpan rest = { position, size_t(end - position) };
+    return rest;
+}
+
+/**
+ * Splits the next whitespace separated token off the front of a span.
+ *
+ * @param text A pointer to the span to read from. The token and the whitespace before it are removed from it.
+ * @param token A pointer to the span to fill with the token.
+ * @return A boolean representing if a token was found.
+ */
+bool TextCursor::nextToken(TextSpan* text, TextSpan* token) {
+    const char* first = text->data;
+    const char* last = text->data + text->size;
+
+    while (first < last && isspace((unsigned char) *first))
+        first++;
+
+    const char* tokenEnd = first;
+    while (tokenEnd < last && !isspace((unsigned char) *tokenEnd))
+        tokenEnd++;
+
+    token->data = first;
+    token->size = tokenEnd - first;
+    text->data = tokenEnd;
+    text->size = last - tokenEnd;
+
+    return token->size > 0;
+}
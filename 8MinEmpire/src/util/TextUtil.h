@@ -0,0 +1,72 @@
+#ifndef TEXTUTIL_H
+#define TEXTUTIL_H
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+
+using namespace std;
+
+/**
+ * A read-only file mapped into memory. Empty files open as an empty buffer.
+ */
+class MappedFile {
+    const char* data;
+    size_t* size;
+
+public:
+    MappedFile();
+    MappedFile(MappedFile* file) = delete;
+    MappedFile& operator=(MappedFile& file) = delete;
+    ~MappedFile();
+
+    bool open(const string& path);
+    void close();
+
+    bool isOpen() { return data != nullptr; }
+    const char* getData() { return data; }
+    size_t getSize() { return *size; }
+};
+
+/**
+ * A run of characters inside a larger buffer. Nothing is copied until str() is called.
+ */
+struct TextSpan {
+    const char* data;
+    size_t size;
+
+    bool empty() const { return size == 0; }
+    char front() const { return data[0]; }
+    string str() const { return string(data, size); }
+    bool equals(const char* text) const { return strlen(text) == size && memcmp(data, text, size) == 0; }
+    bool operator==(const TextSpan& other) const { return size == other.size && memcmp(data, other.data, size) == 0; }
+};
+
+/**
+ * Hashes a TextSpan so it can be used as an unordered_map key.
+ */
+struct TextSpanHash {
+    size_t operator()(const TextSpan& span) const;
+};
+
+/**
+ * Walks a text buffer one line at a time, keeping track of the line number.
+ */
+class TextCursor {
+    const char* position;
+    const char* end;
+    int lineNumber;
+    bool reachedEnd;
+
+public:
+    TextCursor(const char* data, size_t size);
+
+    bool nextLine(TextSpan* line);
+    TextSpan getRest();
+    int getLineNumber() { return lineNumber; }
+    bool isAtEnd() { return reachedEnd; }
+
+    static bool nextToken(TextSpan* text, TextSpan* token);
+};
+
+#endif